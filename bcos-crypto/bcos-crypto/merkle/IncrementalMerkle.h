@@ -0,0 +1,293 @@
+#pragma once
+
+#include "Merkle.h"
+#include <bcos-concepts/Basic.h>
+#include <bcos-concepts/ByteBuffer.h>
+#include <bcos-crypto/hasher/Hasher.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <boost/endian.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace bcos::crypto::merkle
+{
+
+// Merkle tree keeping all its levels, same root and proof format as Merkle<HasherType, width>.
+// append() and update() only rehash the paths from the changed leaves to the root, O(log n) hashes
+// for a single leaf, and a proof is read from the stored levels without recomputing the tree
+template <bcos::crypto::hasher::Hasher HasherType, size_t width = 2, class HashType = bcos::bytes>
+class IncrementalMerkle
+{
+    static_assert(width >= 2, "Width too short, at least 2");
+    constexpr static size_t PARALLEL_THRESHOLD = 64;
+
+public:
+    IncrementalMerkle(HasherType hasher) : m_hasher(std::move(hasher)) {}
+
+    size_t size() const { return m_levels.empty() ? 0 : m_levels.front().size(); }
+    bool empty() const { return size() == 0; }
+    void clear() { m_levels.clear(); }
+
+    HashType const& root() const
+    {
+        if (empty()) [[unlikely]]
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument{"Empty merkle!"});
+        }
+        return m_levels.back().front();
+    }
+
+    HashType const& leaf(std::integral auto index) const
+    {
+        if ((size_t)index >= size()) [[unlikely]]
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument{"Out of range!"});
+        }
+        return m_levels.front()[index];
+    }
+
+    void append(bcos::concepts::bytebuffer::Hash auto const& hash)
+    {
+        append(std::span<std::remove_cvref_t<decltype(hash)> const>(std::addressof(hash), 1));
+    }
+
+    void append(HashRange auto const& hashes)
+    {
+        if (RANGES::empty(hashes))
+        {
+            return;
+        }
+        if (m_levels.empty())
+        {
+            m_levels.emplace_back();
+        }
+
+        auto& leaves = m_levels.front();
+        auto begin = leaves.size();
+        leaves.reserve(begin + RANGES::size(hashes));
+        for (auto const& hash : hashes)
+        {
+            bcos::concepts::bytebuffer::assignTo(hash, leaves.emplace_back());
+        }
+        rehash(begin, leaves.size());
+    }
+
+    void update(std::integral auto index, bcos::concepts::bytebuffer::Hash auto const& hash)
+    {
+        if ((size_t)index >= size()) [[unlikely]]
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument{"Out of range!"});
+        }
+        bcos::concepts::bytebuffer::assignTo(hash, m_levels.front()[index]);
+        rehash(index, index + 1);
+    }
+
+    // Same output as Merkle::generateMerkleProof(originHashes, merkle, index, out)
+    void generateMerkleProof(std::integral auto index, ProofRange auto& out) const
+    {
+        if ((size_t)index >= size()) [[unlikely]]
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument{"Out of range!"});
+        }
+
+        if (size() == 1)
+        {
+            bcos::concepts::resizeTo(out, 1);
+            bcos::concepts::bytebuffer::assignTo(root(), *RANGES::begin(out));
+            return;
+        }
+
+        auto position = (size_t)index;
+        for (auto level = 0LU; level + 1 < m_levels.size(); ++level)
+        {
+            auto const& hashes = m_levels[level];
+            auto aligned = position - (position % width);
+            auto count = std::min(hashes.size() - aligned, width);
+
+            setNumberToHash(count, out.emplace_back());
+            for (auto i = aligned; i < aligned + count; ++i)
+            {
+                bcos::concepts::bytebuffer::assignTo(hashes[i], out.emplace_back());
+            }
+            position /= width;
+        }
+    }
+
+    // Same output as Merkle::generateMerkle(leaves, out)
+    void exportMerkle(MerkleRange auto& out) const
+    {
+        if (empty()) [[unlikely]]
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument{"Empty merkle!"});
+        }
+
+        if (size() == 1)
+        {
+            bcos::concepts::resizeTo(out, 1);
+            bcos::concepts::bytebuffer::assignTo(root(), *RANGES::begin(out));
+            return;
+        }
+
+        for (auto level = 1LU; level < m_levels.size(); ++level)
+        {
+            setNumberToHash(m_levels[level].size(), out.emplace_back());
+            for (auto const& hash : m_levels[level])
+            {
+                bcos::concepts::bytebuffer::assignTo(hash, out.emplace_back());
+            }
+        }
+    }
+
+    // Compact form: big endian leaf count and hash size, then the hashes of every level from the
+    // leaves to the root, without any per hash header
+    void encode(bcos::concepts::bytebuffer::ByteBuffer auto& out) const
+    {
+        auto hashSize = empty() ? 0LU : (size_t)RANGES::size(root());
+        auto nodes = 0LU;
+        for (auto const& hashes : m_levels)
+        {
+            nodes += hashes.size();
+        }
+
+        bcos::concepts::resizeTo(out, HEADER_SIZE + nodes * hashSize);
+        auto* it = reinterpret_cast<std::byte*>(RANGES::data(out));
+        it = writeNumber(size(), it);
+        it = writeNumber(hashSize, it);
+        for (auto const& hashes : m_levels)
+        {
+            for (auto const& hash : hashes)
+            {
+                it = std::copy_n(
+                    reinterpret_cast<std::byte const*>(RANGES::data(hash)), hashSize, it);
+            }
+        }
+    }
+
+    void decode(bcos::concepts::bytebuffer::ByteBuffer auto const& in)
+    {
+        auto inputSize = (size_t)RANGES::size(in);
+        if (inputSize < HEADER_SIZE) [[unlikely]]
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument{"Merkle data too short!"});
+        }
+        auto const* it = reinterpret_cast<std::byte const*>(RANGES::data(in));
+        auto leaves = readNumber(it);
+        auto hashSize = readNumber(it + sizeof(uint32_t));
+        it += HEADER_SIZE;
+
+        std::vector<size_t> levelSizes;
+        if (leaves > 0)
+        {
+            levelSizes.emplace_back(leaves);
+            while (levelSizes.back() > 1)
+            {
+                levelSizes.emplace_back(getNextLevelSize(levelSizes.back()));
+            }
+        }
+        auto nodes = std::accumulate(levelSizes.begin(), levelSizes.end(), 0LU);
+        if ((leaves > 0 && hashSize == 0) || inputSize != HEADER_SIZE + nodes * hashSize)
+            [[unlikely]]
+        {
+            BOOST_THROW_EXCEPTION(std::invalid_argument{"Merkle data size mismatch!"});
+        }
+
+        std::vector<std::vector<HashType>> levels(levelSizes.size());
+        for (auto level = 0LU; level < levelSizes.size(); ++level)
+        {
+            levels[level].resize(levelSizes[level]);
+            for (auto& hash : levels[level])
+            {
+                bcos::concepts::bytebuffer::assignTo(
+                    std::span<std::byte const>(it, hashSize), hash);
+                it += hashSize;
+            }
+        }
+        m_levels.swap(levels);
+    }
+
+private:
+    constexpr static size_t HEADER_SIZE = sizeof(uint32_t) * 2;
+
+    HasherType m_hasher;
+    // m_levels[0] holds the leaves, every level above holds the hashes of width nodes below it,
+    // and the last level holds only the root
+    std::vector<std::vector<HashType>> m_levels;
+
+    static size_t getNextLevelSize(size_t inputSize) { return (inputSize + (width - 1)) / width; }
+
+    static void setNumberToHash(uint32_t number, bcos::concepts::bytebuffer::Hash auto& output)
+    {
+        bcos::concepts::resizeTo(output, sizeof(uint32_t));
+        *((uint32_t*)RANGES::data(output)) = boost::endian::native_to_big(number);
+    }
+
+    static std::byte* writeNumber(uint32_t number, std::byte* output)
+    {
+        boost::endian::store_big_u32(reinterpret_cast<unsigned char*>(output), number);
+        return output + sizeof(uint32_t);
+    }
+
+    static uint32_t readNumber(std::byte const* input)
+    {
+        return boost::endian::load_big_u32(reinterpret_cast<unsigned char const*>(input));
+    }
+
+    // Leaves [begin, end) changed, recalculate their parents level by level up to the root
+    void rehash(size_t begin, size_t end)
+    {
+        auto hasher = m_hasher.clone();
+        for (auto level = 0LU; m_levels[level].size() > 1; ++level)
+        {
+            if (level + 1 == m_levels.size())
+            {
+                m_levels.emplace_back();
+            }
+            auto const& input = m_levels[level];
+            auto& output = m_levels[level + 1];
+            output.resize(getNextLevelSize(input.size()));
+
+            begin /= width;
+            end = (end + width - 1) / width;
+            calculateLevelHashes(input, output, begin, end, hasher);
+        }
+    }
+
+    void calculateHash(std::vector<HashType> const& input, HashType& output, size_t index,
+        HasherType& hasher) const
+    {
+        for (auto i = index * width; i < (index + 1) * width && i < input.size(); ++i)
+        {
+            hasher.update(input[i]);
+        }
+        hasher.final(output);
+    }
+
+    void calculateLevelHashes(std::vector<HashType> const& input, std::vector<HashType>& output,
+        size_t begin, size_t end, HasherType& hasher) const
+    {
+        if (end - begin < PARALLEL_THRESHOLD)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                calculateHash(input, output[i], i, hasher);
+            }
+            return;
+        }
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
+            [this, &input, &output](const tbb::blocked_range<size_t>& range) {
+                auto hasher = m_hasher.clone();
+                for (auto i = range.begin(); i < range.end(); ++i)
+                {
+                    calculateHash(input, output[i], i, hasher);
+                }
+            });
+    }
+};
+
+}  // namespace bcos::crypto::merkle
@@ -1,4 +1,5 @@
 #include <bcos-crypto/hasher/OpenSSLHasher.h>
+#include <bcos-crypto/merkle/IncrementalMerkle.h>
 #include <bcos-crypto/merkle/Merkle.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/FixedBytes.h>
@@ -141,6 +142,80 @@ BOOST_AUTO_TEST_CASE(merkle)
     loopWidthTest<testCount>(hashes);
 }
 
+template <size_t width>
+void testIncrementalMerkle(bcos::crypto::merkle::HashRange auto const& inputHashes)
+{
+    using Hasher = bcos::crypto::hasher::openssl::OpenSSL_SHA3_256_Hasher;
+    Merkle<Hasher, width> trie(Hasher{});
+    IncrementalMerkle<Hasher, width, HashType> incremental(Hasher{});
+    BOOST_CHECK_THROW(incremental.root(), boost::wrapexcept<std::invalid_argument>);
+
+    for (auto count = 1lu; count <= RANGES::size(inputHashes); ++count)
+    {
+        std::span<HashType const> hashes(inputHashes.data(), count);
+        incremental.append(hashes.back());
+        BOOST_CHECK_EQUAL(incremental.size(), count);
+
+        std::vector<HashType> outMerkle;
+        trie.generateMerkle(hashes, outMerkle);
+        std::vector<HashType> exportMerkle;
+        incremental.exportMerkle(exportMerkle);
+        BOOST_CHECK(exportMerkle == outMerkle);
+        BOOST_CHECK_EQUAL(incremental.root(), *outMerkle.rbegin());
+
+        for (auto index = 0lu; index < count; ++index)
+        {
+            std::vector<HashType> outProof;
+            trie.generateMerkleProof(hashes, outMerkle, index, outProof);
+            std::vector<HashType> incrementalProof;
+            incremental.generateMerkleProof(index, incrementalProof);
+            BOOST_CHECK(incrementalProof == outProof);
+            BOOST_CHECK(
+                trie.verifyMerkleProof(incrementalProof, hashes[index], incremental.root()));
+        }
+    }
+
+    // Batch append builds the same tree
+    IncrementalMerkle<Hasher, width, HashType> batch(Hasher{});
+    batch.append(std::span<HashType const>(inputHashes.data(), 10));
+    batch.append(
+        std::span<HashType const>(inputHashes.data() + 10, RANGES::size(inputHashes) - 10));
+    BOOST_CHECK_EQUAL(batch.root(), incremental.root());
+
+    // Update a leaf, same root as rebuilding from the changed leaves
+    std::vector<HashType> changed(RANGES::begin(inputHashes), RANGES::end(inputHashes));
+    std::swap(changed[3], changed[changed.size() - 1]);
+    incremental.update(3, changed[3]);
+    incremental.update(changed.size() - 1, changed[changed.size() - 1]);
+    std::vector<HashType> outMerkle;
+    trie.generateMerkle(changed, outMerkle);
+    BOOST_CHECK_EQUAL(incremental.root(), *outMerkle.rbegin());
+    BOOST_CHECK_EQUAL(incremental.leaf(3), changed[3]);
+    BOOST_CHECK_THROW(
+        incremental.update(changed.size(), changed[0]), boost::wrapexcept<std::invalid_argument>);
+
+    // Encode and decode
+    bcos::bytes buffer;
+    incremental.encode(buffer);
+    IncrementalMerkle<Hasher, width, HashType> decoded(Hasher{});
+    decoded.decode(buffer);
+    BOOST_CHECK_EQUAL(decoded.size(), incremental.size());
+    BOOST_CHECK_EQUAL(decoded.root(), incremental.root());
+    decoded.append(inputHashes[0]);
+    incremental.append(inputHashes[0]);
+    BOOST_CHECK_EQUAL(decoded.root(), incremental.root());
+
+    buffer.pop_back();
+    BOOST_CHECK_THROW(decoded.decode(buffer), boost::wrapexcept<std::invalid_argument>);
+}
+
+BOOST_AUTO_TEST_CASE(incrementalMerkle)
+{
+    testIncrementalMerkle<2>(hashes);
+    testIncrementalMerkle<3>(hashes);
+    testIncrementalMerkle<16>(hashes);
+}
+
 template <typename Hasher>
 std::shared_ptr<std::string> calculateRootByMerkleProof(
     const bcos::bytes& _txHash, MerkleProofPtr merkleProof, Hasher& hasher)
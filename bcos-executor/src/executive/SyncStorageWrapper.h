@@ -55,6 +55,28 @@ public:
         return StorageWrapper::getRows(table, keys);
     }
 
+    void scanRows(const std::string_view& table, const storage::Condition& condition,
+        std::function<bool(std::string_view key, const storage::Entry& entry)> visitor) override
+    {
+        if (m_existsKeyLocks.empty())
+        {  // acquireKeyLock never waits, the rows scanned are still valid
+            StorageWrapper::scanRows(table, condition, [&](std::string_view key, auto&& entry) {
+                acquireKeyLock(key);
+                return visitor(key, entry);
+            });
+            return;
+        }
+        // The rows locked by others are read after their locks acquired
+        for (const auto& key : getPrimaryKeys(table, condition))
+        {
+            auto entry = getRow(table, key);
+            if (entry && !visitor(key, *entry))
+            {
+                break;
+            }
+        }
+    }
+
     void setRow(
         const std::string_view& table, const std::string_view& key, storage::Entry entry) override
     {
@@ -493,16 +493,16 @@ void TablePrecompiled::selectByCondition(const std::string& tableName,
     buildKeyCondition(keyCondition, conditions, limit);
 
     std::vector<EntryTuple> entries({});
-
-    // merge keys from storage and eqKeys
-    auto tableKeyList = _executive->storage().getPrimaryKeys(tableName, *keyCondition);
-    entries.reserve(tableKeyList.size());
-    for (auto& key : tableKeyList)
-    {
-        auto tableEntry = _executive->storage().getRow(tableName, key);
-        EntryTuple entryTuple = {key, tableEntry->getObject<std::vector<std::string>>()};
-        entries.emplace_back(std::move(entryTuple));
-    }
+    entries.reserve(std::get<1>(limit));
+
+    // scan the rows in the pages directly
+    _executive->storage().scanRows(
+        tableName, *keyCondition, [&entries](std::string_view key, const Entry& tableEntry) {
+            EntryTuple entryTuple = {
+                std::string(key), tableEntry.getObject<std::vector<std::string>>()};
+            entries.emplace_back(std::move(entryTuple));
+            return true;
+        });
 
     PRECOMPILED_LOG(TRACE) << LOG_BADGE("TablePrecompiled") << LOG_BADGE("SELECT")
                            << LOG_KV("entries.size", entries.size());
@@ -558,26 +558,24 @@ void TablePrecompiled::selectByConditionV32(const std::string& tableName,
         }
         else
         {
-            // merge keys from storage and eqKeys
-            // keyCondition must exist
-            auto tableKeyList =
-                _executive->storage().getPrimaryKeys(tableName, *valueCondition->at(0));
-            entries.reserve(tableKeyList.size());
-            for (auto& key : tableKeyList)
-            {
-                auto tableEntry = _executive->storage().getRow(tableName, key);
-                EntryTuple entryTuple;
-                if (_isNumericalOrder)
-                {
-                    entryTuple = {toLexicographicOrder(key),
-                        tableEntry->getObject<std::vector<std::string>>()};
-                }
-                else
-                {
-                    entryTuple = {key, tableEntry->getObject<std::vector<std::string>>()};
-                }
-                entries.emplace_back(std::move(entryTuple));
-            }
+            // keyCondition must exist, scan the rows in the pages directly
+            entries.reserve(std::get<1>(limit));
+            _executive->storage().scanRows(tableName, *valueCondition->at(0),
+                [&entries, _isNumericalOrder](std::string_view key, const Entry& tableEntry) {
+                    EntryTuple entryTuple;
+                    if (_isNumericalOrder)
+                    {
+                        entryTuple = {toLexicographicOrder(key),
+                            tableEntry.getObject<std::vector<std::string>>()};
+                    }
+                    else
+                    {
+                        entryTuple = {
+                            std::string(key), tableEntry.getObject<std::vector<std::string>>()};
+                    }
+                    entries.emplace_back(std::move(entryTuple));
+                    return true;
+                });
         }
     }
     PRECOMPILED_LOG(TRACE) << LOG_BADGE("TablePrecompiled") << LOG_BADGE("SELECT")
@@ -57,49 +57,35 @@ VMInstance VMFactory::create(VMKind kind, evmc_revision revision, const crypto::
         {
             return VMInstance{evmc_create_evmone(), revision, code};
         }
-        std::shared_ptr<evmoneCodeAnalysis> analysis{get(codeHash, revision)};
+        auto analysis = get(codeHash, revision);
         if (!analysis)
         {
-            analysis =
-                std::make_shared<evmoneCodeAnalysis>(evmone::advanced::analyze(revision, code));
+            auto startT = utcTime();
+            analysis = std::make_shared<evmoneCodeAnalysis const>(
+                evmone::advanced::analyze(revision, code));
             // analysis = std::make_shared<evmoneCodeAnalysis>(
             //     evmone::baseline::analyze(revision, code));
             put(codeHash, analysis, revision);
+
+            EXECUTOR_LOG(DEBUG) << METRIC << LOG_DESC("evmone analysis cache miss")
+                                << LOG_KV("codeHash", codeHash) << LOG_KV("codeSize", code.size())
+                                << LOG_KV("timecost", utcTime() - startT);
         }
-        return VMInstance{analysis, revision, code};
+        return VMInstance{std::move(analysis), revision, code};
     }
     }
 }
 
-std::shared_ptr<evmoneCodeAnalysis> VMFactory::get(
+std::shared_ptr<evmoneCodeAnalysis const> VMFactory::get(
     const crypto::HashType& key, evmc_revision revision) noexcept
 {
-    if (revision == m_revision)
-    {
-        m_cacheMutex.lock();
-        auto analysis = m_cache.get(key);
-        m_cacheMutex.unlock();
-        if (analysis)
-        {
-            return analysis.value();
-        }
-    }
-    return nullptr;
+    return m_cache.get({.codeHash = key, .revision = revision});
 }
 
-void VMFactory::put(const crypto::HashType& key,
-    const std::shared_ptr<evmoneCodeAnalysis>& analysis, evmc_revision revision) noexcept
+void VMFactory::put(const crypto::HashType& key, std::shared_ptr<evmoneCodeAnalysis const> analysis,
+    evmc_revision revision) noexcept
 {
-    if (revision != m_revision)
-    {
-        std::unique_lock lock(m_cacheMutex);
-        m_cache.clear();
-    }
-    m_revision = revision;
-    {
-        std::unique_lock lock(m_cacheMutex);
-        m_cache.insert(key, analysis);
-    }
+    m_cache.put({.codeHash = key, .revision = revision}, std::move(analysis));
 }
 
 }  // namespace bcos::executor
@@ -23,11 +23,10 @@
 #include "../Common.h"
 #include "VMInstance.h"
 #include "bcos-crypto/interfaces/crypto/CommonType.h"
+#include <bcos-framework/executor/CodeAnalysisCache.h>
 #include <evmc/loader.h>
 #include <evmone/evmone.h>
-#include <boost/compute/detail/lru_cache.hpp>
 #include <memory>
-#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -46,23 +45,28 @@ enum class VMKind
 class VMFactory
 {
 public:
-    VMFactory(size_t cache_size = c_EVMONE_CACHE_SIZE) : m_cache(cache_size) {}
+    using AnalysisCache = CodeAnalysisCache<evmoneCodeAnalysis>;
+
+    // The analysis are kept in the process wide AnalysisCache, cache_size only grows its capacity
+    VMFactory(size_t cache_size = c_EVMONE_CACHE_SIZE) : m_cache(AnalysisCache::instance())
+    {
+        m_cache.reserve(cache_size);
+    }
 
     /// Creates a VM instance of the kind provided.
     VMInstance create(VMKind _kind, evmc_revision revision, const crypto::HashType& codeHash,
         bytes_view code, bool isCreate = false);
 
     /// @brief Gets an anvanced EVM analysis from the cache. if not found return nullptr
-    std::shared_ptr<evmoneCodeAnalysis> get(
+    std::shared_ptr<evmoneCodeAnalysis const> get(
         const crypto::HashType& key, evmc_revision revision) noexcept;
 
-    void put(const crypto::HashType& key, const std::shared_ptr<evmoneCodeAnalysis>& analysis,
+    void put(const crypto::HashType& key, std::shared_ptr<evmoneCodeAnalysis const> analysis,
         evmc_revision revision) noexcept;
 
+    AnalysisCache::Stats stats() const { return m_cache.stats(); }
+
 private:
-    boost::compute::detail::lru_cache<crypto::HashType, std::shared_ptr<evmoneCodeAnalysis>>
-        m_cache;
-    evmc_revision m_revision = EVMC_PARIS;
-    std::mutex m_cacheMutex;
+    AnalysisCache& m_cache;
 };
 }  // namespace bcos::executor
@@ -66,7 +66,7 @@ class VMInstance
 {
 public:
     explicit VMInstance(evmc_vm* instance, evmc_revision revision, bytes_view code) noexcept;
-    explicit VMInstance(std::shared_ptr<evmoneCodeAnalysis> analysis, evmc_revision revision,
+    explicit VMInstance(std::shared_ptr<evmoneCodeAnalysis const> analysis, evmc_revision revision,
         bytes_view code) noexcept;
     ~VMInstance()
     {
@@ -85,7 +85,7 @@ public:
 private:
     /// The VM instance created with VMInstance-C <prefix>_create() function.
     evmc_vm* m_instance = nullptr;
-    std::shared_ptr<evmoneCodeAnalysis> m_analysis = nullptr;
+    std::shared_ptr<evmoneCodeAnalysis const> m_analysis = nullptr;
     evmc_revision m_revision;
     bytes_view m_code;
 };
@@ -0,0 +1,300 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief process wide cache of the vm code analysis
+ * @file CodeAnalysisCache.h
+ */
+
+#pragma once
+#include <bcos-crypto/interfaces/crypto/CommonType.h>
+#include <oneapi/tbb/parallel_for_each.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::executor
+{
+
+struct CodeAnalysisKey
+{
+    crypto::HashType codeHash;
+    int revision = 0;
+
+    bool operator==(CodeAnalysisKey const& rhs) const = default;
+};
+
+// Size bounded LRU of code analysis keyed by (codeHash, revision), split into shards with their
+// own lock. instance() is shared by all the executors and vm factories of the process
+template <class Analysis>
+class CodeAnalysisCache
+{
+public:
+    using AnalysisPtr = std::shared_ptr<Analysis const>;
+    constexpr static size_t SHARDS_COUNT = 16;
+    constexpr static size_t DEFAULT_CAPACITY = 4096;
+
+    using Key = CodeAnalysisKey;
+    struct Stats
+    {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t size = 0;
+    };
+
+    explicit CodeAnalysisCache(size_t capacity = DEFAULT_CAPACITY)
+      : m_shardCapacity(getShardCapacity(capacity))
+    {}
+    CodeAnalysisCache(const CodeAnalysisCache&) = delete;
+    CodeAnalysisCache(CodeAnalysisCache&&) = delete;
+    CodeAnalysisCache& operator=(const CodeAnalysisCache&) = delete;
+    CodeAnalysisCache& operator=(CodeAnalysisCache&&) = delete;
+    ~CodeAnalysisCache() noexcept = default;
+
+    static CodeAnalysisCache& instance()
+    {
+        static CodeAnalysisCache cache;
+        return cache;
+    }
+
+    // Only grows, the cache is shared by factories configured with different sizes
+    void reserve(size_t capacity)
+    {
+        auto shardCapacity = getShardCapacity(capacity);
+        auto current = m_shardCapacity.load();
+        while (current < shardCapacity &&
+               !m_shardCapacity.compare_exchange_weak(current, shardCapacity))
+        {
+        }
+    }
+    size_t capacity() const { return m_shardCapacity * SHARDS_COUNT; }
+
+    AnalysisPtr get(Key const& key)
+    {
+        auto& shard = getShard(key);
+        std::unique_lock lock(shard.m_mutex);
+        auto it = shard.m_index.find(key);
+        if (it == shard.m_index.end())
+        {
+            ++shard.m_misses;
+            return nullptr;
+        }
+        ++shard.m_hits;
+        shard.m_entries.splice(shard.m_entries.begin(), shard.m_entries, it->second);
+        return it->second->m_analysis;
+    }
+
+    void put(Key const& key, AnalysisPtr analysis)
+    {
+        auto& shard = getShard(key);
+        std::unique_lock lock(shard.m_mutex);
+        if (auto it = shard.m_index.find(key); it != shard.m_index.end())
+        {
+            it->second->m_analysis = std::move(analysis);
+            shard.m_entries.splice(shard.m_entries.begin(), shard.m_entries, it->second);
+            return;
+        }
+
+        shard.m_entries.push_front({.m_key = key, .m_analysis = std::move(analysis)});
+        shard.m_index.emplace(key, shard.m_entries.begin());
+        auto shardCapacity = m_shardCapacity.load();
+        while (shard.m_entries.size() > shardCapacity)
+        {
+            shard.m_index.erase(shard.m_entries.back().m_key);
+            shard.m_entries.pop_back();
+            ++shard.m_evictions;
+        }
+    }
+
+    // The analyze runs outside the lock, two threads missing the same key may both analyze it
+    AnalysisPtr getOrAnalyze(Key const& key, auto&& analyze)
+    {
+        if (auto analysis = get(key))
+        {
+            return analysis;
+        }
+        AnalysisPtr analysis = analyze();
+        put(key, analysis);
+        return analysis;
+    }
+
+    void remove(Key const& key)
+    {
+        auto& shard = getShard(key);
+        std::unique_lock lock(shard.m_mutex);
+        if (auto it = shard.m_index.find(key); it != shard.m_index.end())
+        {
+            shard.m_entries.erase(it->second);
+            shard.m_index.erase(it);
+        }
+    }
+
+    void clear()
+    {
+        for (auto& shard : m_shards)
+        {
+            std::unique_lock lock(shard.m_mutex);
+            shard.m_entries.clear();
+            shard.m_index.clear();
+        }
+    }
+
+    // The most recently used keys of each shard in turn, persist them to warm up the cache after
+    // restart
+    std::vector<Key> recentKeys(size_t count) const
+    {
+        std::array<std::vector<Key>, SHARDS_COUNT> shardKeys;
+        size_t total = 0;
+        for (size_t i = 0; i < SHARDS_COUNT; ++i)
+        {
+            std::unique_lock lock(m_shards[i].m_mutex);
+            for (auto const& entry : m_shards[i].m_entries)
+            {
+                if (shardKeys[i].size() == count)
+                {
+                    break;
+                }
+                shardKeys[i].emplace_back(entry.m_key);
+            }
+            total += shardKeys[i].size();
+        }
+
+        std::vector<Key> keys;
+        keys.reserve(std::min(count, total));
+        for (size_t index = 0; keys.size() < std::min(count, total); ++index)
+        {
+            for (auto const& oneShardKeys : shardKeys)
+            {
+                if (index < oneShardKeys.size() && keys.size() < count)
+                {
+                    keys.emplace_back(oneShardKeys[index]);
+                }
+            }
+        }
+        return keys;
+    }
+
+    // analyze(key) returns the analysis or nullptr if the code is gone, the keys not in the cache
+    // are analyzed in parallel and not counted as misses
+    void warmup(std::vector<Key> const& keys, auto&& analyze)
+    {
+        tbb::parallel_for_each(keys.begin(), keys.end(), [&](Key const& key) {
+            {
+                auto& shard = getShard(key);
+                std::unique_lock lock(shard.m_mutex);
+                if (shard.m_index.contains(key))
+                {
+                    return;
+                }
+            }
+            if (auto analysis = analyze(key))
+            {
+                put(key, std::move(analysis));
+            }
+        });
+    }
+
+    // Raw codeHash and revision of each key, an unreadable or truncated file loads no keys
+    static bool saveKeys(std::string const& path, std::vector<Key> const& keys)
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        for (auto const& key : keys)
+        {
+            auto revision = (int32_t)key.revision;
+            output.write((char const*)key.codeHash.data(), crypto::HashType::SIZE);
+            output.write((char const*)&revision, sizeof(revision));
+        }
+        return output.good();
+    }
+    static std::vector<Key> loadKeys(std::string const& path)
+    {
+        std::vector<Key> keys;
+        std::ifstream input(path, std::ios::binary);
+        Key key;
+        int32_t revision = 0;
+        while (input.read((char*)key.codeHash.data(), crypto::HashType::SIZE) &&
+               input.read((char*)&revision, sizeof(revision)))
+        {
+            key.revision = revision;
+            keys.emplace_back(key);
+        }
+        if (input.gcount() != 0)
+        {  // truncated
+            return {};
+        }
+        return keys;
+    }
+
+    Stats stats() const
+    {
+        Stats stats;
+        for (auto const& shard : m_shards)
+        {
+            std::unique_lock lock(shard.m_mutex);
+            stats.hits += shard.m_hits;
+            stats.misses += shard.m_misses;
+            stats.evictions += shard.m_evictions;
+            stats.size += shard.m_entries.size();
+        }
+        return stats;
+    }
+
+private:
+    struct Entry
+    {
+        Key m_key;
+        AnalysisPtr m_analysis;
+    };
+    struct KeyHash
+    {
+        size_t operator()(Key const& key) const
+        {
+            return std::hash<crypto::HashType>{}(key.codeHash) ^ (size_t)key.revision;
+        }
+    };
+    // The counters are updated under the lock of the shard, not shared by all the threads
+    struct Shard
+    {
+        mutable std::mutex m_mutex;
+        std::list<Entry> m_entries;  // Most recently used first
+        std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHash> m_index;
+        size_t m_hits = 0;
+        size_t m_misses = 0;
+        size_t m_evictions = 0;
+    };
+
+    std::array<Shard, SHARDS_COUNT> m_shards;
+    std::atomic_size_t m_shardCapacity;
+
+    static size_t getShardCapacity(size_t capacity)
+    {
+        return std::max((capacity + SHARDS_COUNT - 1) / SHARDS_COUNT, (size_t)1);
+    }
+    Shard& getShard(Key const& key)
+    {
+        // The codeHash is a hash already, take bytes not used by the std::hash of the map
+        return m_shards[key.codeHash[crypto::HashType::SIZE - 1] % SHARDS_COUNT];
+    }
+};
+
+}  // namespace bcos::executor
@@ -21,6 +21,7 @@
 #pragma once
 #include "Protocol.h"
 #include <memory>
+#include <vector>
 namespace bcos
 {
 namespace protocol
@@ -43,6 +44,10 @@ public:
     virtual void setMaxVersion(uint32_t _maxVersion) { m_maxVersion = _maxVersion; }
     // set the negotiated version
     virtual void setVersion(uint32_t _version) { m_version = _version; }
+    virtual void setCompressDictionaryIDs(std::vector<uint32_t> _compressDictionaryIDs)
+    {
+        m_compressDictionaryIDs = std::move(_compressDictionaryIDs);
+    }
 
     // the moduleID
     virtual ProtocolModuleID protocolModuleID() const { return m_protocolModuleID; }
@@ -54,12 +59,20 @@ public:
     // the negotiated version
     virtual uint32_t version() const { return m_version; }
 
+    // the ids of the supported message compress dictionaries, only the negotiated one is kept
+    // after the handshake
+    virtual std::vector<uint32_t> const& compressDictionaryIDs() const
+    {
+        return m_compressDictionaryIDs;
+    }
+
 protected:
     ProtocolModuleID m_protocolModuleID;
     // Note: here can't use enum Version type in case of setVersion failed for no-defined Version
     uint32_t m_minVersion;
     uint32_t m_maxVersion;
     uint32_t m_version;
+    std::vector<uint32_t> m_compressDictionaryIDs;
 };
 }  // namespace protocol
 }  // namespace bcos
@@ -153,6 +153,55 @@ struct Condition
         return true;
     }
 
+    // The smallest key may be valid, the keys before it can be skipped in an ordered scan
+    std::string_view lowerBound() const
+    {
+        std::string_view lower;
+        for (const auto& cond : m_conditions)
+        {
+            if ((cond.cmp == Comparator::GT || cond.cmp == Comparator::GE ||
+                    cond.cmp == Comparator::EQ || cond.cmp == Comparator::STARTS_WITH) &&
+                cond.value > lower)
+            {
+                lower = cond.value;
+            }
+        }
+        return lower;
+    }
+
+    // Whether the key and all the keys after it are not valid, an ordered scan stops at it
+    bool isBeyond(const std::string_view& key) const
+    {
+        for (const auto& cond : m_conditions)
+        {
+            switch (cond.cmp)
+            {
+            case Comparator::EQ:
+            case Comparator::LE:
+                if (key > cond.value)
+                {
+                    return true;
+                }
+                break;
+            case Comparator::LT:
+                if (key >= cond.value)
+                {
+                    return true;
+                }
+                break;
+            case Comparator::STARTS_WITH:
+                if (key > cond.value && !key.starts_with(cond.value))
+                {
+                    return true;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        return false;
+    }
+
     enum class Comparator : uint8_t
     {
         GT = 0,
@@ -64,6 +64,12 @@ public:
     virtual void asyncSetRow(std::string_view table, std::string_view key, Entry entry,
         std::function<void(Error::UniquePtr)> callback) = 0;
 
+    // Visits the rows matched the condition in the order of the keys, from the offset of the
+    // condition limit until the limit count or the visitor returns false. The default reads the
+    // primary keys first then the rows one by one
+    virtual Error::UniquePtr scanRows(std::string_view table, const Condition& condition,
+        std::function<bool(std::string_view key, const Entry& entry)> visitor);
+
     virtual void asyncCreateTable(std::string _tableName, std::string _valueFields,
         std::function<void(Error::UniquePtr, std::optional<Table>)> callback);
 
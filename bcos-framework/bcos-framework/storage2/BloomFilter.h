@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+
+namespace bcos::storage2
+{
+
+// Fixed size bloom filter over 64 bits key hashes, add() and mayContain() can run concurrently
+class BloomFilter
+{
+private:
+    constexpr static unsigned DEFAULT_BITS_PER_KEY = 10;
+    constexpr static unsigned PROBES = 4;
+    constexpr static unsigned WORD_BITS = 64;
+    constexpr static size_t MIN_BITS = 512;
+
+    std::unique_ptr<std::atomic_uint64_t[]> m_words;
+    uint64_t m_bitMask = 0;
+
+    template <class Func>
+    static void probe(uint64_t hash, Func&& func)
+    {
+        auto h1 = mix(hash);
+        auto h2 = (h1 >> (WORD_BITS / 2)) | 1;
+        for (unsigned i = 0; i < PROBES; ++i)
+        {
+            func(h1 + i * h2);
+        }
+    }
+
+public:
+    BloomFilter() = default;
+    explicit BloomFilter(size_t expectedCount, unsigned bitsPerKey = DEFAULT_BITS_PER_KEY)
+    {
+        auto bits = std::bit_ceil(std::max(expectedCount * bitsPerKey, MIN_BITS));
+        m_words = std::make_unique<std::atomic_uint64_t[]>(bits / WORD_BITS);
+        m_bitMask = bits - 1;
+    }
+    BloomFilter(const BloomFilter&) = delete;
+    BloomFilter(BloomFilter&&) noexcept = default;
+    BloomFilter& operator=(const BloomFilter&) = delete;
+    BloomFilter& operator=(BloomFilter&&) noexcept = default;
+    ~BloomFilter() noexcept = default;
+
+    // splitmix64 finalizer, std::hash of integers is identity in libstdc++
+    static uint64_t mix(uint64_t hash)
+    {
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+        return hash;
+    }
+
+    bool empty() const { return !m_words; }
+    size_t bits() const { return m_words ? m_bitMask + 1 : 0; }
+
+    void add(uint64_t hash)
+    {
+        probe(hash, [this](uint64_t bit) {
+            bit &= m_bitMask;
+            m_words[bit / WORD_BITS].fetch_or(
+                uint64_t(1) << (bit % WORD_BITS), std::memory_order_relaxed);
+        });
+    }
+
+    // An empty filter contains everything
+    bool mayContain(uint64_t hash) const
+    {
+        if (!m_words)
+        {
+            return true;
+        }
+
+        bool contains = true;
+        probe(hash, [this, &contains](uint64_t bit) {
+            bit &= m_bitMask;
+            if ((m_words[bit / WORD_BITS].load(std::memory_order_relaxed) &
+                    (uint64_t(1) << (bit % WORD_BITS))) == 0)
+            {
+                contains = false;
+            }
+        });
+        return contains;
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < bits() / WORD_BITS; ++i)
+        {
+            m_words[i].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+}  // namespace bcos::storage2
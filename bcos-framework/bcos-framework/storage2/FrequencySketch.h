@@ -0,0 +1,120 @@
+#pragma once
+
+#include "BloomFilter.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+
+namespace bcos::storage2
+{
+
+// Count-min sketch of 4 bits counters over 64 bits key hashes, the TinyLFU frequency estimator.
+// All counters are halved after every sampleSize increments, so old popularity fades out.
+// increment() and frequency() can run concurrently, a lost increment only lowers the estimate
+class FrequencySketch
+{
+private:
+    constexpr static unsigned DEPTH = 4;
+    constexpr static unsigned COUNTER_BITS = 4;
+    constexpr static unsigned COUNTERS_PER_WORD = 64 / COUNTER_BITS;
+    constexpr static uint64_t MAX_COUNT = 15;
+    constexpr static size_t MIN_COUNTERS = 1024;
+    constexpr static uint64_t RESET_MASK = 0x7777777777777777ULL;  // Drop the lowest bit of each
+
+    std::unique_ptr<std::atomic_uint64_t[]> m_words;
+    size_t m_counterMask = 0;
+    size_t m_sampleSize = 0;
+    std::atomic_size_t m_additions = 0;
+
+    template <class Func>
+    void probe(uint64_t hash, Func&& func) const
+    {
+        auto h1 = BloomFilter::mix(hash);
+        auto h2 = (h1 >> 32) | 1;
+        for (unsigned i = 0; i < DEPTH; ++i)
+        {
+            auto counter = (h1 + i * h2) & m_counterMask;
+            func(m_words[counter / COUNTERS_PER_WORD], (counter % COUNTERS_PER_WORD) * COUNTER_BITS);
+        }
+    }
+
+    void reset()
+    {
+        for (size_t i = 0; i < (m_counterMask + 1) / COUNTERS_PER_WORD; ++i)
+        {
+            auto word = m_words[i].load(std::memory_order_relaxed);
+            m_words[i].store((word >> 1) & RESET_MASK, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    FrequencySketch() = default;
+    // expectedCount: how many distinct keys the cache holds, sampled over ten times of them
+    explicit FrequencySketch(size_t expectedCount)
+    {
+        auto counters = std::bit_ceil(std::max(expectedCount, MIN_COUNTERS));
+        m_words = std::make_unique<std::atomic_uint64_t[]>(counters / COUNTERS_PER_WORD);
+        m_counterMask = counters - 1;
+        m_sampleSize = counters * 10;
+    }
+    FrequencySketch(const FrequencySketch&) = delete;
+    FrequencySketch(FrequencySketch&& from) noexcept
+      : m_words(std::move(from.m_words)),
+        m_counterMask(from.m_counterMask),
+        m_sampleSize(from.m_sampleSize),
+        m_additions(from.m_additions.load())
+    {}
+    FrequencySketch& operator=(const FrequencySketch&) = delete;
+    FrequencySketch& operator=(FrequencySketch&& from) noexcept
+    {
+        m_words = std::move(from.m_words);
+        m_counterMask = from.m_counterMask;
+        m_sampleSize = from.m_sampleSize;
+        m_additions = from.m_additions.load();
+        return *this;
+    }
+    ~FrequencySketch() noexcept = default;
+
+    bool empty() const { return !m_words; }
+
+    void increment(uint64_t hash)
+    {
+        if (!m_words)
+        {
+            return;
+        }
+
+        probe(hash, [](std::atomic_uint64_t& word, unsigned shift) {
+            auto value = word.load(std::memory_order_relaxed);
+            while (((value >> shift) & MAX_COUNT) < MAX_COUNT &&
+                   !word.compare_exchange_weak(value, value + (uint64_t(1) << shift),
+                       std::memory_order_relaxed))
+            {
+            }
+        });
+
+        if (m_additions.fetch_add(1, std::memory_order_relaxed) + 1 == m_sampleSize)
+        {
+            m_additions.store(0, std::memory_order_relaxed);
+            reset();
+        }
+    }
+
+    unsigned frequency(uint64_t hash) const
+    {
+        if (!m_words)
+        {
+            return 0;
+        }
+
+        auto count = MAX_COUNT;
+        probe(hash, [&count](std::atomic_uint64_t const& word, unsigned shift) {
+            count = std::min(count, (word.load(std::memory_order_relaxed) >> shift) & MAX_COUNT);
+        });
+        return count;
+    }
+};
+
+}  // namespace bcos::storage2
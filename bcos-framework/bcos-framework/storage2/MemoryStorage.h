@@ -1,5 +1,7 @@
 #pragma once
 
+#include "BloomFilter.h"
+#include "FrequencySketch.h"
 #include "Storage.h"
 #include "bcos-task/AwaitableValue.h"
 #include <bcos-utilities/NullLock.h>
@@ -13,9 +15,13 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/throw_exception.hpp>
+#include <atomic>
+#include <bit>
+#include <cassert>
 #include <functional>
 #include <mutex>
 #include <range/v3/view/transform.hpp>
+#include <shared_mutex>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -30,6 +36,18 @@ concept HasMemberSize = requires(Object object) {
                             // clang-format on
                         };
 
+template <class Object>
+concept HasOwnedBuffer = requires(Object object) {
+                             typename Object::value_type;
+                             object.data();
+                             // clang-format off
+    { object.capacity() } -> std::integral;
+                             // clang-format on
+                         };
+
+template <class Object>
+concept IsTupleLike = requires() { std::tuple_size<Object>::value; };
+
 struct Empty
 {
 };
@@ -44,6 +62,8 @@ enum Attribute : int
     CONCURRENT = 2,
     MRU = 4,
     LOGICAL_DELETION = 8,
+    BLOOM = 16,
+    TINYLFU = 32,
 };
 
 template <class KeyType, class ValueType = Empty, Attribute attribute = Attribute::NONE,
@@ -55,23 +75,47 @@ private:
     constexpr static bool withConcurrent = (attribute & Attribute::CONCURRENT) != 0;
     constexpr static bool withMRU = (attribute & Attribute::MRU) != 0;
     constexpr static bool withLogicalDeletion = (attribute & Attribute::LOGICAL_DELETION) != 0;
+    constexpr static bool withBloom = (attribute & Attribute::BLOOM) != 0;
+    constexpr static bool withTinyLFU = (attribute & Attribute::TINYLFU) != 0;
 
     constexpr static unsigned BUCKETS_COUNT = 64;  // Magic number 64
-    constexpr unsigned getBucketSize() { return withConcurrent ? BUCKETS_COUNT : 1; }
+    constexpr static unsigned MAX_BUCKETS_COUNT = 1024;
     constexpr static int MOSTLY_CACHELINE_SIZE = 64;
 
     static_assert(!withConcurrent || !std::is_void_v<BucketHasher>);
+    static_assert(!withBloom || withConcurrent, "BLOOM only skips the lock of concurrent buckets");
+
+    static_assert(!withTinyLFU || (withMRU && !std::is_void_v<BucketHasher>),
+        "TINYLFU is the admission policy of the hashed mru");
+
+    constexpr static size_t BLOOM_INITIAL_KEYS = 1024;  // Per bucket
+    constexpr static int64_t ESTIMATED_ENTRY_SIZE = 128;  // For the sketch width of TINYLFU
 
     constexpr static unsigned DEFAULT_CAPACITY = 4 * 1024 * 1024;  // For mru
-    using Mutex = std::mutex;
+    // Readers share the bucket, include mru readers, which only mark the entry as accessed
+    using Mutex = std::shared_mutex;
     using Lock = std::conditional_t<withConcurrent, std::unique_lock<Mutex>, utilities::NullLock>;
+    using ReadLock =
+        std::conditional_t<withConcurrent, std::shared_lock<Mutex>, utilities::NullLock>;
     using BucketMutex = std::conditional_t<withConcurrent, Mutex, Empty>;
     using DataValueType =
         std::conditional_t<withLogicalDeletion, std::variant<Deleted, ValueType>, ValueType>;
+
+    // Second chance bit of mru, set by the readers under the shared lock
+    struct AccessedFlag
+    {
+        mutable std::atomic_bool accessed = false;
+
+        AccessedFlag() = default;
+        AccessedFlag(const AccessedFlag& /*unused*/) noexcept {}
+        AccessedFlag& operator=(const AccessedFlag& /*unused*/) noexcept { return *this; }
+        ~AccessedFlag() noexcept = default;
+    };
     struct Data
     {
         KeyType key;
         [[no_unique_address]] DataValueType value;
+        [[no_unique_address]] std::conditional_t<withMRU, AccessedFlag, Empty> flag = {};
     };
 
     using IndexType = std::conditional_t<withOrdered,
@@ -81,31 +125,135 @@ private:
         boost::multi_index_container<Data,
             boost::multi_index::indexed_by<IndexType, boost::multi_index::sequenced<>>>,
         boost::multi_index_container<Data, boost::multi_index::indexed_by<IndexType>>>;
+
+    // Keys of the bucket, read without the bucket lock and guarded by a sequence number, which is
+    // odd while the filter is rebuilding. Replaced filters are kept until the storage destroyed, so
+    // a reader never touches freed memory, they grow by doubling so the retired ones cost at most
+    // as much as the current one
+    struct BucketBloom
+    {
+        std::atomic<BloomFilter*> filter = nullptr;
+        std::atomic_uint64_t sequence = 0;
+        std::vector<std::unique_ptr<BloomFilter>> filters;
+        size_t expectedCount = 0;
+        size_t staleCount = 0;  // Keys erased since the last rebuild
+    };
+
+    struct MRUCounters
+    {
+        std::atomic_int64_t hits = 0;
+        std::atomic_int64_t misses = 0;
+        std::atomic_int64_t evictions = 0;
+        std::atomic_int64_t rejections = 0;  // New keys refused by TINYLFU
+    };
+
     struct alignas(MOSTLY_CACHELINE_SIZE) Bucket
     {
         Container container;
-        [[no_unique_address]] BucketMutex mutex;  // For concurrent
+        [[no_unique_address]] mutable BucketMutex mutex;  // For concurrent
         [[no_unique_address]] std::conditional_t<withMRU, int64_t, Empty> capacity = {};  // For mru
+        [[no_unique_address]] std::conditional_t<withMRU, MRUCounters, Empty> counters;  // For mru
+        [[no_unique_address]] std::conditional_t<withBloom, BucketBloom, Empty> bloom;  // For bloom
+        [[no_unique_address]] std::conditional_t<withTinyLFU, FrequencySketch, Empty>
+            sketch;  // For tinylfu
     };
     using Buckets = std::conditional_t<withConcurrent, std::vector<Bucket>, std::array<Bucket, 1>>;
 
     Buckets m_buckets;
+    [[no_unique_address]] std::conditional_t<withConcurrent, size_t, Empty> m_bucketMask;
     [[no_unique_address]] std::conditional_t<withMRU, int64_t, Empty> m_maxCapacity;
 
-    std::tuple<std::reference_wrapper<Bucket>, Lock> getBucket(auto const& key)
+    template <class BucketLock = Lock>
+    std::tuple<std::reference_wrapper<Bucket>, BucketLock> getBucket(auto const& key)
     {
         if constexpr (!withConcurrent)
         {
-            return std::make_tuple(std::ref(m_buckets[0]), Lock(Empty{}));
+            return std::make_tuple(std::ref(m_buckets[0]), BucketLock(Empty{}));
         }
         auto index = getBucketIndex(key);
 
         auto& bucket = m_buckets[index];
-        return std::make_tuple(std::ref(bucket), Lock(bucket.mutex));
+        return std::make_tuple(std::ref(bucket), BucketLock(bucket.mutex));
     }
 
     Bucket& getBucketByIndex(size_t index) { return m_buckets[index]; }
 
+    static uint64_t getHash(auto const& key)
+        requires withBloom
+    {
+        return BucketHasher{}(key);
+    }
+
+    // Lock free, false means the key is absent from the bucket
+    static bool bloomMayContain(Bucket const& bucket, uint64_t hash)
+        requires withBloom
+    {
+        auto sequence = bucket.bloom.sequence.load(std::memory_order_acquire);
+        if ((sequence & 1) != 0)
+        {
+            return true;
+        }
+        auto* filter = bucket.bloom.filter.load(std::memory_order_acquire);
+        if (filter == nullptr || filter->mayContain(hash))
+        {
+            return true;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return bucket.bloom.sequence.load(std::memory_order_relaxed) != sequence;
+    }
+
+    // Must hold the bucket lock
+    static void bloomAdd(Bucket& bucket, uint64_t hash)
+        requires withBloom
+    {
+        auto* filter = bucket.bloom.filter.load(std::memory_order_relaxed);
+        if (filter == nullptr || bucket.container.size() >= bucket.bloom.expectedCount)
+        {
+            rebuildBloom(bucket, std::max(BLOOM_INITIAL_KEYS, bucket.container.size() * 2));
+            filter = bucket.bloom.filter.load(std::memory_order_relaxed);
+        }
+        filter->add(hash);
+    }
+
+    // Must hold the bucket lock, erased keys leave stale bits behind, rebuild once they outnumber
+    // the live keys
+    static void bloomErased(Bucket& bucket)
+        requires withBloom
+    {
+        if (++bucket.bloom.staleCount > std::max(BLOOM_INITIAL_KEYS, bucket.container.size()))
+        {
+            rebuildBloom(bucket, bucket.bloom.expectedCount);
+        }
+    }
+
+    static void rebuildBloom(Bucket& bucket, size_t expectedCount)
+        requires withBloom
+    {
+        auto& bloom = bucket.bloom;
+        auto sequence = bloom.sequence.load(std::memory_order_relaxed);
+        bloom.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto* filter = bloom.filter.load(std::memory_order_relaxed);
+        if (filter != nullptr && expectedCount <= bloom.expectedCount)
+        {
+            filter->clear();
+        }
+        else
+        {
+            filter = bloom.filters.emplace_back(std::make_unique<BloomFilter>(expectedCount)).get();
+            bloom.expectedCount = expectedCount;
+        }
+        for (auto const& data : bucket.container)
+        {
+            filter->add(getHash(data.key));
+        }
+        bloom.staleCount = 0;
+
+        bloom.filter.store(filter, std::memory_order_release);
+        bloom.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
     size_t getBucketIndex(auto const& key) const
     {
         if constexpr (!withConcurrent)
@@ -115,43 +263,202 @@ private:
         else
         {
             auto hash = BucketHasher{}(key);
-            return hash % m_buckets.size();
+            return hash & m_bucketMask;
         }
     }
 
-    void updateMRUAndCheck(
-        Bucket& bucket, typename Container::template nth_index<0>::type::iterator entryIt)
+    // inserted: entryIt is a new key, TINYLFU admits it only if it is not rarer than the victim
+    void updateMRUAndCheck(Bucket& bucket,
+        typename Container::template nth_index<0>::type::iterator entryIt, bool inserted)
         requires withMRU
     {
         auto& index = bucket.container.template get<1>();
         auto seqIt = index.iterator_to(*entryIt);
         index.relocate(index.end(), seqIt);
+        entryIt->flag.accessed.store(false, std::memory_order_relaxed);
 
+        auto const* candidate = inserted ? std::addressof(*entryIt) : nullptr;
+        [[maybe_unused]] bool admissionChecked = !withTinyLFU || !inserted;
+        bool candidateSkipped = false;
         while (bucket.capacity > m_maxCapacity && !bucket.container.empty())
         {
             auto const& item = index.front();
-            bucket.capacity -= getSize(item.value);
+            if (item.flag.accessed.exchange(false, std::memory_order_relaxed) ||
+                (std::addressof(item) == candidate && !std::exchange(candidateSkipped, true)))
+            {
+                index.relocate(index.end(), index.begin());
+                continue;
+            }
+            if constexpr (withTinyLFU)
+            {
+                if (!admissionChecked)
+                {
+                    admissionChecked = true;
+                    if (std::addressof(item) != candidate &&
+                        bucket.sketch.frequency(BucketHasher{}(candidate->key)) <
+                            bucket.sketch.frequency(BucketHasher{}(item.key)))
+                    {
+                        bucket.capacity -= getSize(*candidate);
+                        bucket.counters.rejections.fetch_add(1, std::memory_order_relaxed);
+                        bucket.container.erase(entryIt);
+                        candidate = nullptr;
+                        if constexpr (withBloom)
+                        {
+                            bloomErased(bucket);
+                        }
+                        continue;
+                    }
+                }
+            }
+            bucket.capacity -= getSize(item);
+            if (std::addressof(item) == candidate)
+            {
+                // The new key is the least recently used one, never admitted
+                bucket.counters.rejections.fetch_add(1, std::memory_order_relaxed);
+                candidate = nullptr;
+            }
+            else
+            {
+                bucket.counters.evictions.fetch_add(1, std::memory_order_relaxed);
+            }
 
             index.pop_front();
+            if constexpr (withBloom)
+            {
+                bloomErased(bucket);
+            }
+        }
+    }
+
+    void resetSketches()
+        requires withTinyLFU
+    {
+        for (auto& bucket : m_buckets)
+        {
+            bucket.sketch = FrequencySketch(m_maxCapacity / ESTIMATED_ENTRY_SIZE);
         }
     }
 
-    static int64_t getSize(auto const& object)
+    // The storages must be quiescent, a blocking lock of every bucket would deadlock with the
+    // readers holding several bucket locks, so the buckets are only tried and asserted free. The
+    // locks keep the other threads out until the buckets are rehashed or swapped, the accessors
+    // started before route by the old bucket mask
+    std::vector<Lock> lockQuiescent(MemoryStorage& from)
+        requires withConcurrent
+    {
+        std::vector<Lock> locks;
+        locks.reserve(m_buckets.size() + from.m_buckets.size());
+        for (auto* storage : {this, std::addressof(from)})
+        {
+            for (auto& bucket : storage->m_buckets)
+            {
+                [[maybe_unused]] auto& lock = locks.emplace_back(bucket.mutex, std::try_to_lock);
+                assert(lock.owns_lock());
+            }
+        }
+        return locks;
+    }
+
+    // Move every entry of from to its bucket of this storage
+    void mergeRehash(MemoryStorage& from)
+        requires withConcurrent
+    {
+        auto locks = lockQuiescent(from);
+        for (auto& fromBucket : from.m_buckets)
+        {
+            auto& fromIndex = fromBucket.container.template get<0>();
+            while (!fromIndex.empty())
+            {
+                auto node = fromIndex.extract(fromIndex.begin());
+                auto& bucket = getBucketByIndex(getBucketIndex(node.value().key));
+                if constexpr (withBloom)
+                {
+                    bloomAdd(bucket, getHash(node.value().key));
+                }
+
+                if constexpr (withMRU)
+                {
+                    bucket.capacity += getSize(node.value());
+                }
+                auto& index = bucket.container.template get<0>();
+                auto result = index.insert(std::move(node));
+                if (!result.inserted)
+                {
+                    if constexpr (withMRU)
+                    {
+                        bucket.capacity -= getSize(*result.position);
+                    }
+                    result.position =
+                        index.insert(index.erase(result.position), std::move(result.node));
+                }
+                if constexpr (withMRU)
+                {
+                    updateMRUAndCheck(bucket, result.position, false);
+                }
+            }
+            if constexpr (withMRU)
+            {
+                fromBucket.capacity = 0;
+            }
+        }
+    }
+
+    // Heap bytes owned by the object, exact for strings, vectors and their small buffer variants,
+    // size() for the other sized objects, 0 for the unknown ones
+    static int64_t getHeapSize(auto const& object)
     {
         using ObjectType = std::remove_cvref_t<decltype(object)>;
-        if constexpr (HasMemberSize<ObjectType>)
+        if constexpr (HasOwnedBuffer<ObjectType>)
+        {
+            auto const* data = reinterpret_cast<const char*>(object.data());
+            auto const* self = reinterpret_cast<const char*>(std::addressof(object));
+            if (data >= self && data < self + sizeof(ObjectType))
+            {
+                return 0;
+            }
+            return static_cast<int64_t>(
+                object.capacity() * sizeof(typename ObjectType::value_type));
+        }
+        else if constexpr (IsTupleLike<ObjectType>)
+        {
+            return std::apply(
+                [](auto const&... elements) { return (int64_t(0) + ... + getHeapSize(elements)); },
+                object);
+        }
+        else if constexpr (requires { object.use_count(); })
+        {
+            // Shared pointers, counted by every holder
+            return object ? sizeof(*object) + getHeapSize(*object) : 0;
+        }
+        else if constexpr (requires { std::variant_size<ObjectType>::value; })
+        {
+            return std::visit([](auto const& alternative) { return getHeapSize(alternative); },
+                object);
+        }
+        else if constexpr (HasMemberSize<ObjectType>)
         {
             return object.size();
         }
+        else
+        {
+            return 0;
+        }
+    }
 
-        // Treat any no-size() object as trivial, TODO: fix it
-        return sizeof(ObjectType);
+    // The node of every index holds two or three pointers besides the data
+    constexpr static int64_t ENTRY_OVERHEAD =
+        sizeof(Data) + sizeof(void*) * ((withOrdered ? 3 : 2) + (withMRU ? 2 : 0));
+    static int64_t getSize(Data const& data)
+    {
+        return ENTRY_OVERHEAD + getHeapSize(data.key) + getHeapSize(data.value);
     }
 
 public:
     using Key = KeyType;
     using Value = ValueType;
 
+    constexpr static bool hasLogicalDeletion() { return withLogicalDeletion; }
+
     MemoryStorage()
         requires(!withConcurrent)
     {
@@ -159,16 +466,26 @@ public:
         {
             m_maxCapacity = DEFAULT_CAPACITY;
         }
+        if constexpr (withTinyLFU)
+        {
+            resetSketches();
+        }
     }
 
+    // Rounded up to a power of two, no more than MAX_BUCKETS_COUNT
     explicit MemoryStorage(unsigned buckets = BUCKETS_COUNT)
         requires(withConcurrent)
-      : m_buckets(std::min(buckets, getBucketSize()))
+      : m_buckets(std::bit_ceil(std::clamp(buckets, 1U, MAX_BUCKETS_COUNT))),
+        m_bucketMask(m_buckets.size() - 1)
     {
         if constexpr (withMRU)
         {
             m_maxCapacity = DEFAULT_CAPACITY;
         }
+        if constexpr (withTinyLFU)
+        {
+            resetSketches();
+        }
     }
     MemoryStorage(const MemoryStorage&) = delete;
     MemoryStorage(MemoryStorage&&) noexcept = default;
@@ -176,19 +493,56 @@ public:
     MemoryStorage& operator=(MemoryStorage&&) noexcept = default;
     ~MemoryStorage() noexcept = default;
 
+    // Bytes of the keys, the values and the container nodes of each bucket, not thread safe
     void setMaxCapacity(int64_t capacity)
         requires withMRU
     {
         m_maxCapacity = capacity;
+        if constexpr (withTinyLFU)
+        {
+            resetSketches();
+        }
     }
 
+    struct MRUMetrics
+    {
+        int64_t hits = 0;
+        int64_t misses = 0;
+        int64_t evictions = 0;
+        int64_t rejections = 0;
+        int64_t memoryUsage = 0;
+
+        double hitRate() const
+        {
+            return hits + misses == 0 ? 0 : static_cast<double>(hits) / (hits + misses);
+        }
+    };
+    MRUMetrics mruMetrics() const
+        requires withMRU
+    {
+        MRUMetrics metrics;
+        for (auto const& bucket : m_buckets)
+        {
+            metrics.hits += bucket.counters.hits.load(std::memory_order_relaxed);
+            metrics.misses += bucket.counters.misses.load(std::memory_order_relaxed);
+            metrics.evictions += bucket.counters.evictions.load(std::memory_order_relaxed);
+            metrics.rejections += bucket.counters.rejections.load(std::memory_order_relaxed);
+
+            ReadLock lock(bucket.mutex);
+            metrics.memoryUsage += bucket.capacity;
+        }
+        return metrics;
+    }
+
+    size_t bucketsCount() const { return m_buckets.size(); }
+
     class ReadIterator
     {
     private:
         int64_t m_index = -1;
         boost::container::small_vector<const Data*, 1> m_iterators;
         [[no_unique_address]] std::conditional_t<withConcurrent,
-            boost::container::small_vector<Lock, 1>, Empty>
+            boost::container::small_vector<ReadLock, 1>, Empty>
             m_bucketLocks;
 
     public:
@@ -259,7 +613,7 @@ public:
     private:
         typename Container::iterator m_it;
         typename Container::iterator m_end;
-        [[no_unique_address]] Lock m_bucketLock;
+        [[no_unique_address]] ReadLock m_bucketLock;
         bool m_started = false;
 
     public:
@@ -333,12 +687,29 @@ public:
             output.m_iterators.reserve(RANGES::size(keys));
         }
 
-        std::conditional_t<withConcurrent, std::bitset<BUCKETS_COUNT>, Empty> locks;
+        std::conditional_t<withConcurrent, std::bitset<MAX_BUCKETS_COUNT>, Empty> locks;
         for (auto&& key : keys)
         {
             auto bucketIndex = getBucketIndex(key);
             auto& bucket = getBucketByIndex(bucketIndex);
 
+            if constexpr (withTinyLFU)
+            {
+                bucket.sketch.increment(BucketHasher{}(key));
+            }
+            if constexpr (withBloom)
+            {
+                if (!locks[bucketIndex] && !bloomMayContain(bucket, getHash(key)))
+                {
+                    if constexpr (withMRU)
+                    {
+                        bucket.counters.misses.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    output.m_iterators.emplace_back(nullptr);
+                    continue;
+                }
+            }
+
             if constexpr (withConcurrent)
             {
                 if (!locks[bucketIndex])
@@ -354,12 +725,17 @@ public:
             {
                 if constexpr (withMRU)
                 {
-                    updateMRUAndCheck(bucket, it);
+                    it->flag.accessed.store(true, std::memory_order_relaxed);
+                    bucket.counters.hits.fetch_add(1, std::memory_order_relaxed);
                 }
                 output.m_iterators.emplace_back(std::addressof(*it));
             }
             else
             {
+                if constexpr (withMRU)
+                {
+                    bucket.counters.misses.fetch_add(1, std::memory_order_relaxed);
+                }
                 output.m_iterators.emplace_back(nullptr);
             }
         }
@@ -370,7 +746,7 @@ public:
     task::AwaitableValue<SeekIterator> seek(auto const& key)
         requires(withOrdered)
     {
-        auto [bucket, lock] = getBucket(key);
+        auto [bucket, lock] = getBucket<ReadLock>(key);
         auto const& index = bucket.get().container.template get<0>();
 
         decltype(index.begin()) it;
@@ -404,11 +780,9 @@ public:
         {
             auto [bucket, lock] = getBucket(key);
             auto const& index = bucket.get().container.template get<0>();
-
-            std::conditional_t<withMRU, int64_t, Empty> updatedCapacity;
-            if constexpr (withMRU)
+            if constexpr (withTinyLFU)
             {
-                updatedCapacity = getSize(value);
+                bucket.get().sketch.increment(BucketHasher{}(key));
             }
 
             typename Container::iterator it;
@@ -420,29 +794,43 @@ public:
             {
                 it = index.find(key);
             }
+            bool inserted = false;
             if (it != index.end() && it->key == key)
             {
                 if constexpr (withMRU)
                 {
-                    auto& existsValue = it->value;
-                    updatedCapacity -= getSize(existsValue);
+                    bucket.get().capacity -= getHeapSize(it->value);
                 }
 
                 bucket.get().container.modify(
                     it, [newValue = std::forward<decltype(value)>(value)](Data& data) mutable {
                         data.value = std::forward<decltype(newValue)>(newValue);
                     });
+
+                if constexpr (withMRU)
+                {
+                    bucket.get().capacity += getHeapSize(it->value);
+                }
             }
             else
             {
+                if constexpr (withBloom)
+                {
+                    bloomAdd(bucket.get(), getHash(key));
+                }
                 it = bucket.get().container.emplace_hint(
                     it, Data{.key = key, .value = std::forward<decltype(value)>(value)});
+                inserted = true;
+
+                if constexpr (withMRU)
+                {
+                    bucket.get().capacity += getSize(*it);
+                }
             }
 
             if constexpr (withMRU)
             {
-                bucket.get().capacity += updatedCapacity;
-                updateMRUAndCheck(bucket.get(), it);
+                updateMRUAndCheck(bucket.get(), it, inserted);
             }
         }
 
@@ -471,7 +859,8 @@ public:
 
                 if constexpr (withMRU)
                 {
-                    bucket.get().capacity -= getSize(existsValue);
+                    bucket.get().capacity -= withLogicalDeletion ? getHeapSize(existsValue) :
+                                                                   getSize(*it);
                 }
 
                 if constexpr (withLogicalDeletion)
@@ -483,14 +872,26 @@ public:
                 else
                 {
                     bucket.get().container.erase(it);
+                    if constexpr (withBloom)
+                    {
+                        bloomErased(bucket.get());
+                    }
                 }
             }
             else
             {
                 if constexpr (withLogicalDeletion)
                 {
+                    if constexpr (withBloom)
+                    {
+                        bloomAdd(bucket.get(), getHash(key));
+                    }
                     it = bucket.get().container.emplace_hint(
                         it, Data{.key = key, .value = Deleted{}});
+                    if constexpr (withMRU)
+                    {
+                        bucket.get().capacity += getSize(*it);
+                    }
                 }
             }
         }
@@ -498,8 +899,18 @@ public:
         return {};
     }
 
+    // The storages must be quiescent if the bucket counts differ, the entries are rehashed
     task::Task<void> merge(MemoryStorage& from)
     {
+        if constexpr (withConcurrent)
+        {
+            if (m_buckets.size() != from.m_buckets.size())
+            {
+                mergeRehash(from);
+                co_return;
+            }
+        }
+
         for (auto bucketPair : RANGES::views::zip(m_buckets, from.m_buckets))
         {
             auto& [bucket, fromBucket] = bucketPair;
@@ -509,26 +920,79 @@ public:
             auto& index = bucket.container.template get<0>();
             auto& fromIndex = fromBucket.container.template get<0>();
 
+            if constexpr (withBloom)
+            {
+                auto mergedCount = bucket.container.size() + fromBucket.container.size();
+                if (mergedCount >= bucket.bloom.expectedCount)
+                {
+                    rebuildBloom(bucket, std::max(BLOOM_INITIAL_KEYS, mergedCount * 2));
+                }
+                auto* filter = bucket.bloom.filter.load(std::memory_order_relaxed);
+                for (auto const& data : fromBucket.container)
+                {
+                    filter->add(getHash(data.key));
+                }
+            }
+
             while (!fromIndex.empty())
             {
+                if constexpr (withMRU)
+                {
+                    bucket.capacity += getSize(*fromIndex.begin());
+                }
                 auto [it, merged] = index.merge(fromIndex, fromIndex.begin());
                 if (!merged)
                 {
-                    index.insert(index.erase(it), fromIndex.extract(fromIndex.begin()));
+                    if constexpr (withMRU)
+                    {
+                        bucket.capacity -= getSize(*it);
+                    }
+                    it = index.insert(index.erase(it), fromIndex.extract(fromIndex.begin()));
+                }
+                if constexpr (withMRU)
+                {
+                    updateMRUAndCheck(bucket, it, false);
                 }
             }
+            if constexpr (withMRU)
+            {
+                fromBucket.capacity = 0;
+            }
         }
         co_return;
     }
 
+    // The storages must be quiescent if the bucket counts differ, the buckets are swapped as a
+    // whole
     void swap(MemoryStorage& from)
     {
+        if constexpr (withConcurrent)
+        {
+            if (m_buckets.size() != from.m_buckets.size())
+            {
+                auto locks = lockQuiescent(from);
+                std::swap(m_buckets, from.m_buckets);
+                std::swap(m_bucketMask, from.m_bucketMask);
+                return;
+            }
+        }
+
         for (auto bucketPair : RANGES::views::zip(m_buckets, from.m_buckets))
         {
             auto& [bucket, fromBucket] = bucketPair;
             Lock toLock(bucket.mutex);
             Lock fromLock(fromBucket.mutex);
             bucket.container.swap(fromBucket.container);
+            if constexpr (withMRU)
+            {
+                std::swap(bucket.capacity, fromBucket.capacity);
+            }
+            if constexpr (withBloom)
+            {
+                rebuildBloom(bucket, std::max(BLOOM_INITIAL_KEYS, bucket.container.size() * 2));
+                rebuildBloom(
+                    fromBucket, std::max(BLOOM_INITIAL_KEYS, fromBucket.container.size() * 2));
+            }
         }
     }
 
@@ -537,7 +1001,7 @@ public:
         bool allEmpty = true;
         for (auto& bucket : m_buckets)
         {
-            Lock lock(bucket.mutex);
+            ReadLock lock(bucket.mutex);
             if (!bucket.container.empty())
             {
                 allEmpty = false;
@@ -11,6 +11,8 @@
 #include <transaction-executor/TransactionExecutor.h>
 #include <boost/container_hash/hash_fwd.hpp>
 #include <any>
+#include <cmath>
+#include <random>
 #include <variant>
 
 using namespace bcos;
@@ -49,12 +51,7 @@ struct Fixture
 
 void setCapacityForMRU(auto& storage)
 {
-    if constexpr (std::is_same_v<std::remove_cvref_t<decltype(storage)>,
-                      MemoryStorage<Key, storage::Entry,
-                          memory_storage::Attribute(ORDERED | CONCURRENT | MRU), std::hash<Key>>> ||
-                  std::is_same_v<std::remove_cvref_t<decltype(storage)>,
-                      MemoryStorage<Key, storage::Entry,
-                          memory_storage::Attribute(CONCURRENT | MRU), std::hash<Key>>>)
+    if constexpr (requires { storage.setMaxCapacity(0); })
     {
         storage.setMaxCapacity(1000 * 1000 * 1000);
     }
@@ -68,7 +65,13 @@ std::variant<MemoryStorage<Key, storage::Entry, memory_storage::Attribute(ORDERE
         std::hash<Key>>,
     MemoryStorage<Key, storage::Entry>,
     MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT), std::hash<Key>>,
-    MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT | MRU), std::hash<Key>>>
+    MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT | MRU), std::hash<Key>>,
+    MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT | BLOOM),
+        std::hash<Key>>,
+    MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT | MRU | BLOOM),
+        std::hash<Key>>,
+    MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT | MRU | TINYLFU),
+        std::hash<Key>>>
     allStorage;
 std::optional<AnyStorage<Key, storage::Entry,
     any_storage::Attribute(any_storage::READABLE | any_storage::WRITEABLE)>>
@@ -115,6 +118,126 @@ static void read(benchmark::State& state)
     }(state));
 }
 
+// Read with range(1) buckets
+template <class Storage>
+static void readBuckets(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        fixture.prepareData(state.range(0));
+        allStorage.emplace<Storage>(state.range(1));
+
+        task::syncWait([&]() -> task::Task<void> {
+            co_await std::visit(
+                [&](auto& storage) -> task::Task<void> {
+                    setCapacityForMRU(storage);
+                    co_await storage.write(fixture.allKeys, fixture.allValues);
+                },
+                allStorage);
+        }());
+    }
+
+    task::syncWait([&](benchmark::State& state) -> task::Task<void> {
+        co_await std::visit(
+            [&](auto& storage) -> task::Task<void> {
+                int i = (state.range(0) / state.threads()) * state.thread_index();
+                for (auto const& it : state)
+                {
+                    [[maybe_unused]] auto value = co_await storage2::readOne(storage,
+                        fixture.allKeys[(i + fixture.allKeys.size()) % fixture.allKeys.size()]);
+                    ++i;
+                }
+                co_return;
+            },
+            allStorage);
+
+        co_return;
+    }(state));
+}
+
+// Read through cache of range(1) bytes per bucket over a skewed key distribution, fill the cache
+// on miss, the hit rate is reported
+template <class Storage>
+static void readThroughMRU(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        fixture.prepareData(state.range(0));
+        allStorage.emplace<Storage>();
+        std::get<Storage>(allStorage).setMaxCapacity(state.range(1));
+    }
+
+    auto& storage = std::get<Storage>(allStorage);
+    std::mt19937_64 random(state.thread_index());
+    std::uniform_real_distribution<double> distribution;
+    task::syncWait([&]() -> task::Task<void> {
+        for (auto const& it : state)
+        {
+            // Skewed to the front keys, mixed with the scans of the tail
+            auto index =
+                static_cast<size_t>(std::pow(distribution(random), 4) * fixture.allKeys.size());
+            if (!co_await storage2::existsOne(storage, fixture.allKeys[index]))
+            {
+                co_await storage2::writeOne(
+                    storage, fixture.allKeys[index], fixture.allValues[index]);
+            }
+        }
+    }());
+
+    if (state.thread_index() == 0)
+    {
+        auto metrics = storage.mruMetrics();
+        state.counters["hitRate"] = metrics.hitRate();
+        state.counters["rejections"] = static_cast<double>(metrics.rejections);
+        state.counters["memoryUsage"] = static_cast<double>(metrics.memoryUsage);
+    }
+}
+
+// Read keys which are not in the storage
+template <class Storage>
+static void readMissing(benchmark::State& state)
+{
+    static std::vector<Key> missingKeys;
+    if (state.thread_index() == 0)
+    {
+        fixture.prepareData(state.range(0));
+        missingKeys.clear();
+        for (auto i : RANGES::views::iota(0, state.range(0)))
+        {
+            missingKeys.emplace_back(
+                makeStringID(fixture.stringPool, fmt::format("Table-{}", i % 1000)),
+                fmt::format("Missing-{}", i));
+        }
+        allStorage.emplace<Storage>();
+
+        task::syncWait([&]() -> task::Task<void> {
+            co_await std::visit(
+                [&](auto& storage) -> task::Task<void> {
+                    setCapacityForMRU(storage);
+                    co_await storage.write(fixture.allKeys, fixture.allValues);
+                },
+                allStorage);
+        }());
+    }
+
+    task::syncWait([&](benchmark::State& state) -> task::Task<void> {
+        co_await std::visit(
+            [&](auto& storage) -> task::Task<void> {
+                int i = (state.range(0) / state.threads()) * state.thread_index();
+                for (auto const& it : state)
+                {
+                    [[maybe_unused]] auto exists = co_await storage2::existsOne(
+                        storage, missingKeys[(i + missingKeys.size()) % missingKeys.size()]);
+                    ++i;
+                }
+                co_return;
+            },
+            allStorage);
+
+        co_return;
+    }(state));
+}
+
 template <class Storage>
 static void readAny(benchmark::State& state)
 {
@@ -280,6 +403,63 @@ BENCHMARK(
     ->Threads(1)
     ->Threads(8);
 
+BENCHMARK(read<MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT | BLOOM),
+              std::hash<Key>>>)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Threads(1)
+    ->Threads(8);
+
+// Readers share the bucket lock, mru readers included
+BENCHMARK(readBuckets<MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT),
+              std::hash<Key>>>)
+    ->ArgsProduct({{1000000}, {64, 256, 1024}})
+    ->ThreadRange(1, 96)
+    ->UseRealTime();
+BENCHMARK(readBuckets<MemoryStorage<Key, storage::Entry,
+              memory_storage::Attribute(CONCURRENT | MRU), std::hash<Key>>>)
+    ->ArgsProduct({{1000000}, {64, 256, 1024}})
+    ->ThreadRange(1, 96)
+    ->UseRealTime();
+
+// Hit rate of the plain mru against the TINYLFU admission
+BENCHMARK(readThroughMRU<MemoryStorage<Key, storage::Entry,
+              memory_storage::Attribute(CONCURRENT | MRU), std::hash<Key>>>)
+    ->Args({1000000, 256 * 1024})
+    ->Threads(1)
+    ->Threads(8);
+BENCHMARK(readThroughMRU<MemoryStorage<Key, storage::Entry,
+              memory_storage::Attribute(CONCURRENT | MRU | TINYLFU), std::hash<Key>>>)
+    ->Args({1000000, 256 * 1024})
+    ->Threads(1)
+    ->Threads(8);
+
+// Absent keys, BLOOM returns without the bucket lock
+BENCHMARK(readMissing<MemoryStorage<Key, storage::Entry, memory_storage::Attribute(CONCURRENT),
+              std::hash<Key>>>)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Threads(1)
+    ->Threads(8);
+BENCHMARK(readMissing<MemoryStorage<Key, storage::Entry,
+              memory_storage::Attribute(CONCURRENT | BLOOM), std::hash<Key>>>)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Threads(1)
+    ->Threads(8);
+BENCHMARK(readMissing<MemoryStorage<Key, storage::Entry,
+              memory_storage::Attribute(CONCURRENT | MRU), std::hash<Key>>>)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Threads(1)
+    ->Threads(8);
+BENCHMARK(readMissing<MemoryStorage<Key, storage::Entry,
+              memory_storage::Attribute(CONCURRENT | MRU | BLOOM), std::hash<Key>>>)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Threads(1)
+    ->Threads(8);
+
 BENCHMARK(readAny<MemoryStorage<Key, storage::Entry, memory_storage::Attribute(ORDERED)>>)
     ->Arg(100000)
     ->Arg(1000000);
@@ -0,0 +1,129 @@
+/**
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief Unit tests for the CodeAnalysisCache
+ * @file CodeAnalysisCacheTest.cpp
+ */
+#include "bcos-framework/executor/CodeAnalysisCache.h"
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos::test
+{
+using Cache = CodeAnalysisCache<std::string>;
+
+static crypto::HashType codeHash(int index)
+{
+    crypto::HashType hash;
+    hash[0] = (uint8_t)index;
+    hash[crypto::HashType::SIZE - 1] = (uint8_t)index;
+    return hash;
+}
+
+BOOST_FIXTURE_TEST_SUITE(CodeAnalysisCacheTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(getAndPut)
+{
+    Cache cache;
+    BOOST_CHECK(!cache.get({.codeHash = codeHash(1), .revision = 1}));
+
+    cache.put({.codeHash = codeHash(1), .revision = 1}, std::make_shared<std::string>("r1"));
+    BOOST_CHECK_EQUAL(*cache.get({.codeHash = codeHash(1), .revision = 1}), "r1");
+    // Different revisions keep their own analysis
+    BOOST_CHECK(!cache.get({.codeHash = codeHash(1), .revision = 2}));
+    auto analysis = cache.getOrAnalyze({.codeHash = codeHash(1), .revision = 2},
+        []() { return std::make_shared<std::string>("r2"); });
+    BOOST_CHECK_EQUAL(*analysis, "r2");
+    BOOST_CHECK_EQUAL(*cache.get({.codeHash = codeHash(1), .revision = 1}), "r1");
+
+    auto stats = cache.stats();
+    BOOST_CHECK_EQUAL(stats.hits, 2);
+    BOOST_CHECK_EQUAL(stats.misses, 3);
+    BOOST_CHECK_EQUAL(stats.size, 2);
+}
+
+BOOST_AUTO_TEST_CASE(evictAndReserve)
+{
+    // One entry per shard, codeHash(i) and codeHash(i + SHARDS_COUNT) share a shard
+    Cache cache(Cache::SHARDS_COUNT);
+    for (auto i = 0; i < (int)Cache::SHARDS_COUNT * 2; ++i)
+    {
+        cache.put({.codeHash = codeHash(i)}, std::make_shared<std::string>(std::to_string(i)));
+    }
+    BOOST_CHECK_EQUAL(cache.stats().size, Cache::SHARDS_COUNT);
+    BOOST_CHECK_EQUAL(cache.stats().evictions, Cache::SHARDS_COUNT);
+    BOOST_CHECK(!cache.get({.codeHash = codeHash(0)}));
+    BOOST_CHECK(cache.get({.codeHash = codeHash(Cache::SHARDS_COUNT)}));
+    cache.remove({.codeHash = codeHash(Cache::SHARDS_COUNT)});
+    BOOST_CHECK(!cache.get({.codeHash = codeHash(Cache::SHARDS_COUNT)}));
+    BOOST_CHECK_EQUAL(cache.stats().size, Cache::SHARDS_COUNT - 1);
+
+    cache.reserve(Cache::SHARDS_COUNT * 4);
+    BOOST_CHECK_EQUAL(cache.capacity(), Cache::SHARDS_COUNT * 4);
+    cache.reserve(1);
+    BOOST_CHECK_EQUAL(cache.capacity(), Cache::SHARDS_COUNT * 4);
+}
+
+BOOST_AUTO_TEST_CASE(warmup)
+{
+    Cache cache;
+    // codeHash(1), codeHash(17) and codeHash(33) share a shard
+    for (auto i : {1, 17, 33, 2})
+    {
+        cache.put({.codeHash = codeHash(i)}, std::make_shared<std::string>(std::to_string(i)));
+    }
+    BOOST_CHECK(cache.get({.codeHash = codeHash(1)}));
+    auto keys = cache.recentKeys(3);
+    BOOST_REQUIRE_EQUAL(keys.size(), 3);
+    BOOST_CHECK(keys[0].codeHash == codeHash(1));
+    BOOST_CHECK(keys[1].codeHash == codeHash(2));
+    BOOST_CHECK(keys[2].codeHash == codeHash(33));
+    BOOST_CHECK_EQUAL(cache.recentKeys(100).size(), 4);
+
+    auto path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+                    .string();
+    BOOST_CHECK(Cache::saveKeys(path, keys));
+    auto loadedKeys = Cache::loadKeys(path);
+    BOOST_CHECK(loadedKeys == keys);
+
+    Cache restarted;
+    restarted.put({.codeHash = codeHash(1)}, std::make_shared<std::string>("kept"));
+    // The code of codeHash(2) is gone
+    restarted.warmup(loadedKeys, [](Cache::Key const& key) -> Cache::AnalysisPtr {
+        if (key.codeHash == codeHash(2))
+        {
+            return nullptr;
+        }
+        return std::make_shared<std::string>("analyzed");
+    });
+    BOOST_CHECK_EQUAL(*restarted.get({.codeHash = codeHash(1)}), "kept");
+    BOOST_CHECK_EQUAL(*restarted.get({.codeHash = codeHash(33)}), "analyzed");
+    BOOST_CHECK(!restarted.get({.codeHash = codeHash(2)}));
+    BOOST_CHECK_EQUAL(restarted.stats().size, 2);
+    BOOST_CHECK_EQUAL(restarted.stats().misses, 1);
+
+    // Truncated file
+    boost::filesystem::resize_file(path, crypto::HashType::SIZE + 1);
+    BOOST_CHECK(Cache::loadKeys(path).empty());
+    boost::filesystem::remove(path);
+    BOOST_CHECK(Cache::loadKeys(path).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -131,12 +131,12 @@ BOOST_AUTO_TEST_CASE(mru)
     task::syncWait([]() -> task::Task<void> {
         MemoryStorage<int, storage::Entry, Attribute(ORDERED | CONCURRENT | MRU), std::hash<int>>
             storage(1);
-        storage.setMaxCapacity(1000);
 
-        // write 10 100byte value
+        // write 10 100byte value, and make them the capacity
         storage::Entry entry;
         entry.set(std::string(100, 'a'));
         co_await storage.write(RANGES::iota_view<int, int>(0, 10), RANGES::repeat_view(entry));
+        storage.setMaxCapacity(storage.mruMetrics().memoryUsage);
 
         // ensure 10 are useable
         auto it = co_await storage.read(RANGES::iota_view<int, int>(0, 10));
@@ -309,4 +309,216 @@ BOOST_AUTO_TEST_CASE(merge)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(bloom)
+{
+    task::syncWait([]() -> task::Task<void> {
+        using Storage = MemoryStorage<int, int, Attribute(CONCURRENT | BLOOM), std::hash<int>>;
+        Storage storage(4);
+
+        // Enough keys to grow the filters
+        constexpr static int count = 10000;
+        co_await storage.write(
+            RANGES::iota_view<int, int>(0, count), RANGES::iota_view<int, int>(0, count));
+
+        auto it = co_await storage.read(RANGES::iota_view<int, int>(0, count * 2));
+        int i = 0;
+        while (co_await it.next())
+        {
+            if (i < count)
+            {
+                BOOST_REQUIRE(co_await it.hasValue());
+                BOOST_CHECK_EQUAL(co_await it.value(), i);
+            }
+            else
+            {
+                BOOST_REQUIRE(!co_await it.hasValue());
+            }
+            ++i;
+        }
+        it.release();
+
+        // Remove enough keys to rebuild the filters
+        co_await storage.remove(RANGES::iota_view<int, int>(0, count - 10));
+        auto removedIt = co_await storage.read(RANGES::iota_view<int, int>(0, count));
+        i = 0;
+        while (co_await removedIt.next())
+        {
+            BOOST_CHECK_EQUAL(co_await removedIt.hasValue(), i >= count - 10);
+            ++i;
+        }
+        removedIt.release();
+
+        Storage other(4);
+        co_await other.write(RANGES::iota_view<int, int>(count, count * 2),
+            RANGES::iota_view<int, int>(count, count * 2));
+        co_await storage.merge(other);
+        for (auto key : {count - 1, count, count * 2 - 1})
+        {
+            BOOST_CHECK(co_await storage2::existsOne(storage, key));
+            BOOST_CHECK(!co_await storage2::existsOne(other, key));
+        }
+
+        storage.swap(other);
+        BOOST_CHECK(co_await storage2::existsOne(other, count));
+        BOOST_CHECK(!co_await storage2::existsOne(storage, count));
+        co_await storage2::writeOne(storage, count, 1);
+        BOOST_CHECK(co_await storage2::existsOne(storage, count));
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(buckets)
+{
+    task::syncWait([]() -> task::Task<void> {
+        using Storage = MemoryStorage<int, int, Attribute(CONCURRENT | MRU), std::hash<int>>;
+        Storage storage(100);
+        BOOST_CHECK_EQUAL(storage.bucketsCount(), 128);
+        BOOST_CHECK_EQUAL(Storage(5000).bucketsCount(), 1024);
+
+        constexpr static int count = 1000;
+        co_await storage.write(
+            RANGES::iota_view<int, int>(0, count), RANGES::iota_view<int, int>(0, count));
+
+        // Merge from a storage with another bucket count
+        Storage other(4);
+        co_await other.write(RANGES::iota_view<int, int>(count / 2, count * 2),
+            RANGES::repeat_view<int>(-1));
+        co_await storage.merge(other);
+        BOOST_CHECK(other.empty());
+
+        auto it = co_await storage.read(RANGES::iota_view<int, int>(0, count * 2));
+        int i = 0;
+        while (co_await it.next())
+        {
+            BOOST_REQUIRE(co_await it.hasValue());
+            BOOST_CHECK_EQUAL(co_await it.value(), i < count / 2 ? i : -1);
+            ++i;
+        }
+        BOOST_CHECK_EQUAL(i, count * 2);
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(mruSecondChance)
+{
+    task::syncWait([]() -> task::Task<void> {
+        MemoryStorage<int, int, Attribute(CONCURRENT | MRU), std::hash<int>> storage(1);
+        co_await storage.write(RANGES::iota_view<int, int>(0, 10), RANGES::repeat_view<int>(0));
+        storage.setMaxCapacity(storage.mruMetrics().memoryUsage);
+
+        // Accessed 0 survives, 1 is evicted instead
+        BOOST_CHECK(co_await storage2::existsOne(storage, 0));
+        co_await storage2::writeOne(storage, 10, 0);
+        BOOST_CHECK(co_await storage2::existsOne(storage, 0));
+        BOOST_CHECK(!co_await storage2::existsOne(storage, 1));
+        BOOST_CHECK(co_await storage2::existsOne(storage, 10));
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(mruAccounting)
+{
+    task::syncWait([]() -> task::Task<void> {
+        MemoryStorage<int, std::string, Attribute(CONCURRENT | MRU), std::hash<int>> storage(1);
+        co_await storage2::writeOne(storage, 0, std::string(1000, 'a'));
+        auto usage = storage.mruMetrics().memoryUsage;
+        BOOST_CHECK_GT(usage, 1000);
+
+        // Heap of the value only
+        co_await storage2::writeOne(storage, 0, std::string(2000, 'a'));
+        BOOST_CHECK_GE(storage.mruMetrics().memoryUsage - usage, 1000);
+
+        co_await storage2::removeOne(storage, 0);
+        BOOST_CHECK_EQUAL(storage.mruMetrics().memoryUsage, 0);
+
+        BOOST_CHECK(!co_await storage2::existsOne(storage, 0));
+        auto metrics = storage.mruMetrics();
+        BOOST_CHECK_EQUAL(metrics.hits, 0);
+        BOOST_CHECK_EQUAL(metrics.misses, 1);
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(mruMerge)
+{
+    task::syncWait([]() -> task::Task<void> {
+        using Storage =
+            MemoryStorage<int, std::string, Attribute(CONCURRENT | MRU), std::hash<int>>;
+        Storage expected(1);
+        co_await expected.write(
+            RANGES::iota_view<int, int>(0, 8), RANGES::repeat_view(std::string(100, 'b')));
+        co_await expected.write(
+            RANGES::iota_view<int, int>(0, 5), RANGES::repeat_view(std::string(1000, 'a')));
+        co_await expected.write(
+            RANGES::iota_view<int, int>(3, 8), RANGES::repeat_view(std::string(100, 'b')));
+
+        // The same and the different bucket counts
+        for (auto buckets : {1U, 4U})
+        {
+            Storage storage(1);
+            co_await storage.write(
+                RANGES::iota_view<int, int>(0, 5), RANGES::repeat_view(std::string(1000, 'a')));
+            Storage other(buckets);
+            co_await other.write(
+                RANGES::iota_view<int, int>(3, 8), RANGES::repeat_view(std::string(100, 'b')));
+            co_await storage.merge(other);
+            BOOST_CHECK_EQUAL(
+                storage.mruMetrics().memoryUsage, expected.mruMetrics().memoryUsage);
+            BOOST_CHECK_EQUAL(other.mruMetrics().memoryUsage, 0);
+
+            // The capacity is kept after the merge
+            auto merged = storage.mruMetrics().memoryUsage;
+            Storage small(1);
+            small.setMaxCapacity(merged / 2);
+            co_await small.merge(storage);
+            BOOST_CHECK_LE(small.mruMetrics().memoryUsage, merged / 2);
+            BOOST_CHECK_GT(small.mruMetrics().evictions, 0);
+        }
+
+        Storage storage(1);
+        co_await storage2::writeOne(storage, 0, std::string(1000, 'a'));
+        auto usage = storage.mruMetrics().memoryUsage;
+        Storage other(1);
+        storage.swap(other);
+        BOOST_CHECK_EQUAL(storage.mruMetrics().memoryUsage, 0);
+        BOOST_CHECK_EQUAL(other.mruMetrics().memoryUsage, usage);
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(tinyLFU)
+{
+    task::syncWait([]() -> task::Task<void> {
+        MemoryStorage<int, int, Attribute(CONCURRENT | MRU | TINYLFU), std::hash<int>> storage(1);
+        co_await storage.write(RANGES::iota_view<int, int>(0, 10), RANGES::repeat_view<int>(0));
+        storage.setMaxCapacity(storage.mruMetrics().memoryUsage);
+
+        // Make 0-9 popular
+        for (auto i = 0; i < 5; ++i)
+        {
+            for (auto key = 0; key < 10; ++key)
+            {
+                co_await storage2::readOne(storage, key);
+            }
+        }
+
+        // A scan of one-hit keys never evicts the popular ones
+        for (auto key = 100; key < 200; ++key)
+        {
+            co_await storage2::writeOne(storage, key, 0);
+        }
+        for (auto key = 0; key < 10; ++key)
+        {
+            BOOST_CHECK(co_await storage2::existsOne(storage, key));
+        }
+        auto metrics = storage.mruMetrics();
+        BOOST_CHECK_EQUAL(metrics.rejections, 100);
+        BOOST_CHECK_EQUAL(metrics.evictions, 0);
+        BOOST_CHECK_GT(metrics.hitRate(), 0.9);
+
+        // A key read often enough is admitted
+        for (auto i = 0; i < 10; ++i)
+        {
+            co_await storage2::readOne(storage, 1000);
+        }
+        co_await storage2::writeOne(storage, 1000, 0);
+        BOOST_CHECK(co_await storage2::existsOne(storage, 1000));
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
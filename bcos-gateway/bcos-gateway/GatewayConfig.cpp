@@ -204,6 +204,8 @@ void GatewayConfig::initP2PConfig(const boost::property_tree::ptree& _pt, bool _
       nodes_file=nodes.json
 
       enable_rip_protocol=true
+      enable_compression=true
+      compress_dictionary_path=
       allow_max_msg_size=
       session_recv_buffer_size=
       session_max_read_data_size=
@@ -238,6 +240,11 @@ void GatewayConfig::initP2PConfig(const boost::property_tree::ptree& _pt, bool _
     m_enableRIPProtocol = _pt.get<bool>("p2p.enable_rip_protocol", true);
 
     m_enableCompress = _pt.get<bool>("p2p.enable_compression", true);
+    m_compressDictionaryPath = _pt.get<std::string>("p2p.compress_dictionary_path", "");
+    if (!m_compressDictionaryPath.empty())
+    {
+        checkFileExist(m_compressDictionaryPath);
+    }
 
     constexpr static uint32_t defaultAllowMaxMsgSize = 32 * 1024 * 1024;
     m_allowMaxMsgSize = _pt.get<uint32_t>("p2p.allow_max_msg_size", defaultAllowMaxMsgSize);
@@ -275,6 +282,7 @@ void GatewayConfig::initP2PConfig(const boost::property_tree::ptree& _pt, bool _
                              << LOG_KV("p2p.listen_port", listenPort) << LOG_KV("p2p.sm_ssl", smSSL)
                              << LOG_KV("p2p.enable_rip_protocol", m_enableRIPProtocol)
                              << LOG_KV("p2p.enable_compression", m_enableCompress)
+                             << LOG_KV("p2p.compress_dictionary_path", m_compressDictionaryPath)
                              << LOG_KV("p2p.allow_max_msg_size", m_allowMaxMsgSize)
                              << LOG_KV("p2p.session_recv_buffer_size", m_sessionRecvBufferSize)
                              << LOG_KV("p2p.session_max_read_data_size", m_maxReadDataSize)
@@ -429,6 +437,9 @@ void GatewayConfig::initFlowControlConfig(const boost::property_tree::ptree& _pt
     enable_distributed_ratelimit_cache=true
     distributed_ratelimit_cache_percent=15
     ;
+    ; lock free sharded token bucket for the local rate limiters
+    enable_sharded_ratelimit=true
+    ;
     ; rate limiter stat reporter interval, unit: ms
     stat_reporter_interval=60000
      */
@@ -444,6 +455,8 @@ void GatewayConfig::initFlowControlConfig(const boost::property_tree::ptree& _pt
     // enable_distributed_ratelimit=false
     int32_t distributedRateLimitCachePercent =
         _pt.get<int32_t>("flow_control.distributed_ratelimit_cache_percent", 20);
+    // enable_sharded_ratelimit=false
+    bool enableShardedRatelimit = _pt.get<bool>("flow_control.enable_sharded_ratelimit", false);
     // stat_reporter_interval=60000
     int32_t statInterval = _pt.get<int32_t>("flow_control.stat_reporter_interval", 60000);
     // stat_reporter_interval=60000
@@ -452,6 +465,7 @@ void GatewayConfig::initFlowControlConfig(const boost::property_tree::ptree& _pt
     m_rateLimiterConfig.enableDistributedRatelimit = enableDistributedRatelimit;
     m_rateLimiterConfig.enableDistributedRateLimitCache = enableDistributedRateLimitCache;
     m_rateLimiterConfig.distributedRateLimitCachePercent = distributedRateLimitCachePercent;
+    m_rateLimiterConfig.enableShardedRatelimit = enableShardedRatelimit;
 
     m_rateLimiterConfig.timeWindowSec = timeWindowSec;
     m_rateLimiterConfig.statInterval = statInterval;
@@ -470,7 +484,9 @@ void GatewayConfig::initFlowControlConfig(const boost::property_tree::ptree& _pt
                              << LOG_KV("flow_control.enable_distributed_ratelimit_cache",
                                     m_rateLimiterConfig.enableDistributedRateLimitCache)
                              << LOG_KV("flow_control.distributed_ratelimit_cache_percent",
-                                    m_rateLimiterConfig.distributedRateLimitCachePercent);
+                                    m_rateLimiterConfig.distributedRateLimitCachePercent)
+                             << LOG_KV("flow_control.enable_sharded_ratelimit",
+                                    m_rateLimiterConfig.enableShardedRatelimit);
 
     // --------------------------------- outgoing begin -------------------------------------------
 
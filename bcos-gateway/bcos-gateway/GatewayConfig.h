@@ -81,6 +81,8 @@ public:
         bool enableDistributedRateLimitCache = true;
         // distributed ratelimit local cache percent
         int32_t distributedRateLimitCachePercent = 20;
+        // lock free sharded token bucket for the local rate limiters
+        bool enableShardedRatelimit = false;
 
         //-------------- output bandwidth ratelimit begin------------------
         // total outgoing bandwidth limit
@@ -254,6 +256,12 @@ public:
     void setEnableCompress(bool _enableCompress) { m_enableCompress = _enableCompress; }
     bool enableCompress() const { return m_enableCompress; }
 
+    std::string const& compressDictionaryPath() const { return m_compressDictionaryPath; }
+    void setCompressDictionaryPath(std::string _path)
+    {
+        m_compressDictionaryPath = std::move(_path);
+    }
+
     uint32_t allowMaxMsgSize() const { return m_allowMaxMsgSize; }
     void setAllowMaxMsgSize(uint32_t _allowMaxMsgSize) { m_allowMaxMsgSize = _allowMaxMsgSize; }
 
@@ -332,6 +340,8 @@ private:
     bool m_enableRIPProtocol{true};
     // enable compress
     bool m_enableCompress{true};
+    // the zstd dictionary of the p2p messages, not used if empty
+    std::string m_compressDictionaryPath;
     std::set<std::string> m_certWhitelist;
     // cert config for ssl connection
     CertConfig m_certConfig;
@@ -22,6 +22,7 @@
 #include <bcos-gateway/libnetwork/Host.h>
 #include <bcos-gateway/libnetwork/PeerBlackWhitelistInterface.h>
 #include <bcos-gateway/libnetwork/Session.h>
+#include <bcos-gateway/libp2p/CompressPolicy.h>
 #include <bcos-gateway/libp2p/P2PMessageV2.h>
 #include <bcos-gateway/libp2p/Service.h>
 #include <bcos-gateway/libp2p/ServiceV2.h>
@@ -515,9 +516,9 @@ std::shared_ptr<ratelimiter::RateLimiterManager> GatewayFactory::buildRateLimite
     ratelimiter::RateLimiterInterface::Ptr totalOutgoingRateLimiter = nullptr;
     if (_rateLimiterConfig.totalOutgoingBwLimit > 0)
     {
-        totalOutgoingRateLimiter = rateLimiterFactory->buildTimeWindowRateLimiter(
+        totalOutgoingRateLimiter = rateLimiterFactory->buildLocalRateLimiter(
             _rateLimiterConfig.totalOutgoingBwLimit * timeWindowS, toMillisecond(timeWindowS),
-            allowExceedMaxPermitSize);
+            allowExceedMaxPermitSize, _rateLimiterConfig.enableShardedRatelimit);
 
         rateLimiterManager->registerRateLimiter(
             ratelimiter::RateLimiterManager::TOTAL_OUTGOING_KEY, totalOutgoingRateLimiter);
@@ -528,8 +529,9 @@ std::shared_ptr<ratelimiter::RateLimiterManager> GatewayFactory::buildRateLimite
     {
         for (const auto& [ip, bandWidth] : _rateLimiterConfig.ip2BwLimit)
         {
-            auto rateLimiterInterface = rateLimiterFactory->buildTimeWindowRateLimiter(
-                bandWidth * timeWindowS, toMillisecond(timeWindowS), allowExceedMaxPermitSize);
+            auto rateLimiterInterface = rateLimiterFactory->buildLocalRateLimiter(
+                bandWidth * timeWindowS, toMillisecond(timeWindowS), allowExceedMaxPermitSize,
+                _rateLimiterConfig.enableShardedRatelimit);
             rateLimiterManager->registerRateLimiter(ip, rateLimiterInterface);
         }
     }
@@ -549,8 +551,9 @@ std::shared_ptr<ratelimiter::RateLimiterManager> GatewayFactory::buildRateLimite
             }
             else
             {
-                rateLimiterInterface = rateLimiterFactory->buildTimeWindowRateLimiter(
-                    bandWidth * timeWindowS, toMillisecond(timeWindowS), allowExceedMaxPermitSize);
+                rateLimiterInterface = rateLimiterFactory->buildLocalRateLimiter(
+                    bandWidth * timeWindowS, toMillisecond(timeWindowS), allowExceedMaxPermitSize,
+                    _rateLimiterConfig.enableShardedRatelimit);
             }
 
             rateLimiterManager->registerRateLimiter(group, rateLimiterInterface);
@@ -599,6 +602,19 @@ std::shared_ptr<Service> GatewayFactory::buildService(const GatewayConfig::Ptr&
     asioInterface->setClientContext(clientCtx);
     asioInterface->setType(ASIOInterface::ASIO_TYPE::SSL);
 
+    // the dictionary announced in the handshake
+    if (!_config->compressDictionaryPath().empty())
+    {
+        auto content = readContents(boost::filesystem::path(_config->compressDictionaryPath()));
+        auto dictionary = std::make_shared<ZstdDictionary>(std::move(*content));
+        CompressPolicies::instance().setDictionary(dictionary);
+        GATEWAY_FACTORY_LOG(INFO) << LOG_BADGE("buildService")
+                                  << LOG_DESC("load compress dictionary")
+                                  << LOG_KV("path", _config->compressDictionaryPath())
+                                  << LOG_KV("id", dictionary->id())
+                                  << LOG_KV("size", dictionary->content().size());
+    }
+
     // Message Factory
     auto messageFactory = std::make_shared<P2PMessageFactoryV2>();
     // Session Factory
@@ -0,0 +1,230 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief pool of the byte buffers of the encoded and decoded messages
+ * @file BufferPool.h
+ */
+#pragma once
+
+#include <bcos-utilities/Common.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bcos
+{
+namespace gateway
+{
+
+// The buffers are kept in the power of two size classes from 256B to 4MB after released, each
+// class keeps MAX_FREE_BUFFERS buffers or MAX_CLASS_FREE_BYTES at most (one buffer at least), so
+// the large classes keep fewer buffers, the larger or the extra buffers are freed.
+// The free buffers are kept in the shard of the releasing thread, a thread takes the buffers from
+// its own shard and from the other shards only when its shard has none, the buffers encoded by one
+// thread and released by the io thread move between the shards this way
+class BufferPool
+{
+public:
+    constexpr static size_t MIN_BUFFER_SIZE = 256;
+    constexpr static size_t CLASSES_COUNT = 15;
+    constexpr static size_t MAX_FREE_BUFFERS = 64;
+    constexpr static size_t MAX_CLASS_FREE_BYTES = 2 * 1024 * 1024;
+    constexpr static size_t MAX_SHARDS = 64;
+
+    // The count of the free buffers kept by the class
+    constexpr static size_t maxFreeBuffers(size_t index)
+    {
+        return std::clamp<size_t>(
+            MAX_CLASS_FREE_BYTES / (MIN_BUFFER_SIZE << index), 1, MAX_FREE_BUFFERS);
+    }
+
+    struct Stat
+    {
+        uint64_t allocated = 0;  // buffers allocated when the pool has none
+        uint64_t reused = 0;     // buffers taken from the pool
+        uint64_t released = 0;   // buffers back to the pool
+        uint64_t dropped = 0;    // buffers freed for the pool is full or the size is too large
+    };
+
+    BufferPool() = default;
+    BufferPool(const BufferPool&) = delete;
+    BufferPool(BufferPool&&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+    ~BufferPool() noexcept = default;
+
+    // Never destroyed, the payloads released at exit still return to it
+    static BufferPool& instance()
+    {
+        static auto* pool = new BufferPool();
+        return *pool;
+    }
+
+    // An empty buffer with the capacity of at least the size
+    bytes acquire(size_t size)
+    {
+        auto index = acquireClass(size);
+        auto current = currentShard();
+        if (index < CLASSES_COUNT && m_freeCounts[index].load(std::memory_order_relaxed) > 0)
+        {
+            for (size_t i = 0; i < m_shards.size(); ++i)
+            {
+                auto& sizeClass = m_shards[(current + i) % m_shards.size()].classes[index];
+                // the other shards are skipped if busy
+                std::unique_lock lock(sizeClass.mutex, std::defer_lock);
+                if (i == 0)
+                {
+                    lock.lock();
+                }
+                else if (!lock.try_lock())
+                {
+                    continue;
+                }
+                if (!sizeClass.buffers.empty())
+                {
+                    auto buffer = std::move(sizeClass.buffers.back());
+                    sizeClass.buffers.pop_back();
+                    lock.unlock();
+                    m_freeCounts[index].fetch_sub(1, std::memory_order_relaxed);
+                    m_shards[current].reused.fetch_add(1, std::memory_order_relaxed);
+                    return buffer;
+                }
+            }
+        }
+        m_shards[current].allocated.fetch_add(1, std::memory_order_relaxed);
+        bytes buffer;
+        buffer.reserve(index < CLASSES_COUNT ? (MIN_BUFFER_SIZE << index) : size);
+        return buffer;
+    }
+
+    void release(bytes&& buffer)
+    {
+        auto capacity = buffer.capacity();
+        if (capacity < MIN_BUFFER_SIZE)
+        {  // not from the pool or moved
+            return;
+        }
+        // the largest class not larger than the capacity
+        auto index = static_cast<size_t>(std::bit_width(capacity / MIN_BUFFER_SIZE)) - 1;
+        auto& shard = m_shards[currentShard()];
+        // the free buffers of the class are counted over the shards
+        if (index < CLASSES_COUNT &&
+            m_freeCounts[index].fetch_add(1, std::memory_order_relaxed) < maxFreeBuffers(index))
+        {
+            buffer.clear();
+            auto& sizeClass = shard.classes[index];
+            {
+                std::unique_lock lock(sizeClass.mutex);
+                sizeClass.buffers.emplace_back(std::move(buffer));
+            }
+            shard.released.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (index < CLASSES_COUNT)
+        {
+            m_freeCounts[index].fetch_sub(1, std::memory_order_relaxed);
+        }
+        shard.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The copy of the data in a buffer of the pool, back to the pool with the last reference
+    std::shared_ptr<bytes> copyShared(bytesConstRef data)
+    {
+        auto buffer = acquire(data.size());
+        buffer.assign(data.begin(), data.end());
+        return {new bytes(std::move(buffer)), [this](bytes* released) {
+                    release(std::move(*released));
+                    delete released;
+                }};
+    }
+
+    Stat stat() const
+    {
+        Stat current;
+        for (auto const& shard : m_shards)
+        {
+            current.allocated += shard.allocated.load(std::memory_order_relaxed);
+            current.reused += shard.reused.load(std::memory_order_relaxed);
+            current.released += shard.released.load(std::memory_order_relaxed);
+            current.dropped += shard.dropped.load(std::memory_order_relaxed);
+        }
+        return current;
+    }
+
+    std::string statString() const
+    {
+        auto current = stat();
+        return "allocated: " + std::to_string(current.allocated) +
+               " ,reused: " + std::to_string(current.reused) +
+               " ,released: " + std::to_string(current.released) +
+               " ,dropped: " + std::to_string(current.dropped);
+    }
+
+private:
+    // the smallest class not smaller than the size
+    static size_t acquireClass(size_t size)
+    {
+        if (size <= MIN_BUFFER_SIZE)
+        {
+            return 0;
+        }
+        auto count = (size + MIN_BUFFER_SIZE - 1) / MIN_BUFFER_SIZE;
+        return static_cast<size_t>(std::bit_width(count - 1));
+    }
+
+    // power of two, not less than the cores
+    static size_t shardsCount()
+    {
+        static const size_t count = std::min(
+            std::bit_ceil(std::max<size_t>(std::thread::hardware_concurrency(), 1)), MAX_SHARDS);
+        return count;
+    }
+
+    // The threads take the shards in turn at the first call
+    static size_t currentShard()
+    {
+        static std::atomic_size_t threads{0};
+        thread_local const size_t shard =
+            threads.fetch_add(1, std::memory_order_relaxed) & (shardsCount() - 1);
+        return shard;
+    }
+
+    struct SizeClass
+    {
+        std::mutex mutex;
+        std::vector<bytes> buffers;
+    };
+    // The stat is counted in the shard of the thread, summed when called
+    struct alignas(64) Shard
+    {
+        std::array<SizeClass, CLASSES_COUNT> classes;
+        std::atomic_uint64_t allocated{0};
+        std::atomic_uint64_t reused{0};
+        std::atomic_uint64_t released{0};
+        std::atomic_uint64_t dropped{0};
+    };
+    std::vector<Shard> m_shards{shardsCount()};
+    std::array<std::atomic_size_t, CLASSES_COUNT> m_freeCounts{};
+
+};
+
+}  // namespace gateway
+}  // namespace bcos
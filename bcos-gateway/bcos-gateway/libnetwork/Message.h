@@ -21,6 +21,7 @@
 #pragma once
 
 #include "bcos-boostssl/websocket/WsError.h"
+#include "bcos-gateway/libnetwork/BufferPool.h"
 #include "bcos-utilities/CompositeBuffer.h"
 #include <bcos-utilities/Common.h>
 #include <boost/asio/buffer.hpp>
@@ -48,6 +49,29 @@ public:
 struct EncodedMessage : public bcos::ObjectCounter<EncodedMessage>
 {
     using Ptr = std::shared_ptr<EncodedMessage>;
+
+    EncodedMessage() = default;
+    EncodedMessage(const EncodedMessage&) = delete;
+    EncodedMessage(EncodedMessage&& other) noexcept
+      : header(std::move(other.header)),
+        payload(std::move(other.payload)),
+        compress(other.compress)
+    {}
+    EncodedMessage& operator=(const EncodedMessage&) = delete;
+    EncodedMessage& operator=(EncodedMessage&& other) noexcept
+    {
+        if (this != &other)
+        {
+            BufferPool::instance().release(std::move(header));
+            header = std::move(other.header);
+            payload = std::move(other.payload);
+            compress = other.compress;
+        }
+        return *this;
+    }
+    // the header buffer is taken from the pool by the encoder
+    ~EncodedMessage() { BufferPool::instance().release(std::move(header)); }
+
     bcos::bytes header;
     // CompositeBuffer::Ptr payload;
     std::shared_ptr<bcos::bytes> payload;
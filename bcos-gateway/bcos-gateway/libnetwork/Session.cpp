@@ -271,7 +271,7 @@ std::size_t Session::tryPopSomeEncodedMsgs(std::vector<EncodedMessage::Ptr>& enc
             break;
         }
 
-        EncodedMessage::Ptr encodedMsg = m_writeQueue.front();
+        auto& encodedMsg = m_writeQueue.front();
         totalDataSize += encodedMsg->dataSize();
 
         // data size will overflow
@@ -335,9 +335,12 @@ void Session::write()
                 // asio::buffer be used
                 auto self = std::weak_ptr<Session>(shared_from_this());
 
+                // gather write of the headers and the payloads shared with the messages, the
+                // handler holds the messages until the write finished
                 toMultiBuffers(m_writeConstBuffer, encodedMsgs);
                 server->asioInterface()->asyncWrite(m_socket, m_writeConstBuffer,
-                    [self, encodedMsgs](const boost::system::error_code _error, std::size_t _size) {
+                    [self, encodedMsgs = std::move(encodedMsgs)](
+                        const boost::system::error_code _error, std::size_t _size) {
                         auto session = self.lock();
                         if (!session)
                         {
@@ -279,7 +279,7 @@ private:
 
     MessageFactory::Ptr m_messageFactory;
 
-    std::list<EncodedMessage::Ptr> m_writeQueue;
+    std::deque<EncodedMessage::Ptr> m_writeQueue;
     std::atomic_bool m_writing = {false};
     bcos::Mutex x_writeQueue;
 
@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief compress level and threshold of the p2p messages of each module
+ * @file CompressPolicy.h
+ */
+#pragma once
+
+#include <bcos-framework/protocol/Protocol.h>
+#include <bcos-gateway/libp2p/Common.h>
+#include <bcos-utilities/ZstdCompress.h>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace gateway
+{
+
+struct CompressPolicy
+{
+    // the payloads not larger than the threshold are sent uncompressed
+    uint64_t threshold = c_compressThreshold;
+    int level = (int)c_zstdCompressLevel;
+    // the threshold for the peers negotiated the dictionary, the dictionary is not used if 0
+    uint64_t dictionaryThreshold = c_compressThreshold;
+};
+
+// The policies and the dictionary are set before the gateway started, read only after that
+class CompressPolicies
+{
+public:
+    CompressPolicies()
+    {
+        // latency critical, small votes are compressed only with the dictionary
+        m_policies[bcos::protocol::ModuleID::PBFT] = {c_compressThreshold, 1, 256};
+        // the transactions are repetitive
+        m_policies[bcos::protocol::ModuleID::TxsSync] = {512, 1, 128};
+        m_policies[bcos::protocol::ModuleID::ConsTxsSync] = {512, 1, 128};
+        m_policies[bcos::protocol::ModuleID::SYNC_PUSH_TRANSACTION] = {512, 1, 128};
+        // the blocks are large and not latency critical, the status messages are small
+        m_policies[bcos::protocol::ModuleID::BlockSync] = {c_compressThreshold, 3, 128};
+        m_defaultPolicy.dictionaryThreshold = 256;
+    }
+    CompressPolicies(const CompressPolicies&) = delete;
+    CompressPolicies(CompressPolicies&&) = delete;
+    CompressPolicies& operator=(const CompressPolicies&) = delete;
+    CompressPolicies& operator=(CompressPolicies&&) = delete;
+    ~CompressPolicies() noexcept = default;
+
+    static CompressPolicies& instance()
+    {
+        static auto* policies = new CompressPolicies();
+        return *policies;
+    }
+
+    // the default policy for the messages without moduleID or the modules not configured
+    CompressPolicy const& policy(std::optional<uint16_t> moduleID) const
+    {
+        if (moduleID)
+        {
+            auto it = m_policies.find(*moduleID);
+            if (it != m_policies.end())
+            {
+                return it->second;
+            }
+        }
+        return m_defaultPolicy;
+    }
+    void setPolicy(uint16_t moduleID, CompressPolicy policy) { m_policies[moduleID] = policy; }
+    void setDefaultPolicy(CompressPolicy policy) { m_defaultPolicy = policy; }
+
+    // the local dictionary, announced in the handshake
+    ZstdDictionary::ConstPtr dictionary() const { return m_dictionary; }
+    void setDictionary(ZstdDictionary::ConstPtr dictionary)
+    {
+        m_dictionary = std::move(dictionary);
+    }
+    ZstdDictionary::ConstPtr dictionary(uint32_t id) const
+    {
+        return (m_dictionary && m_dictionary->id() == id) ? m_dictionary : nullptr;
+    }
+    std::vector<uint32_t> dictionaryIDs() const
+    {
+        return m_dictionary ? std::vector<uint32_t>{m_dictionary->id()} : std::vector<uint32_t>{};
+    }
+    // the dictionaries supported by both sides
+    std::vector<uint32_t> negotiateDictionaryIDs(std::vector<uint32_t> const& peerIDs) const
+    {
+        std::vector<uint32_t> ids;
+        for (auto id : peerIDs)
+        {
+            if (dictionary(id))
+            {
+                ids.emplace_back(id);
+            }
+        }
+        return ids;
+    }
+
+private:
+    std::unordered_map<uint16_t, CompressPolicy> m_policies;
+    CompressPolicy m_defaultPolicy;
+    ZstdDictionary::ConstPtr m_dictionary;
+};
+
+}  // namespace gateway
+}  // namespace bcos
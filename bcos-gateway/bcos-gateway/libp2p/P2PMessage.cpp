@@ -20,6 +20,7 @@
 
 #include <bcos-gateway/Common.h>
 #include <bcos-gateway/libp2p/Common.h>
+#include <bcos-gateway/libp2p/CompressPolicy.h>
 #include <bcos-gateway/libp2p/P2PMessage.h>
 #include <bcos-utilities/ZstdCompress.h>
 #include <boost/asio/detail/socket_ops.hpp>
@@ -185,26 +186,26 @@ bool P2PMessage::encodeHeader(bytes& _buffer)
 
 bool P2PMessage::encode(EncodedMessage& _buffer)
 {
-    bool isCompressSuccess = false;
+    std::shared_ptr<bytes> compressData;
     if (_buffer.compress)
     {
-        auto compressData = std::make_shared<bcos::bytes>();
-        if (tryToCompressPayload(*compressData))
-        {
-            isCompressSuccess = true;
-            // set compress flag
-            m_ext |= bcos::protocol::MessageExtFieldFlag::Compress;
-            _buffer.payload = std::move(compressData);
-        }
+        compressData = compressedPayload();
     }
-
-    // No data compression is performed
-    if (!isCompressSuccess)
+    if (compressData)
+    {
+        // set compress flag
+        m_ext |= bcos::protocol::MessageExtFieldFlag::Compress;
+        _buffer.payload = std::move(compressData);
+    }
+    else
     {
+        // No data compression is performed, the message may be encoded with compression for
+        // the other peers before
+        m_ext &= (~bcos::protocol::MessageExtFieldFlag::Compress);
         _buffer.payload = m_payload;
     }
 
-    bytes headerBuffer;
+    auto headerBuffer = BufferPool::instance().acquire(HEADER_BUFFER_SIZE);
     // encode header
     if (!encodeHeader(headerBuffer))
     {
@@ -236,14 +237,16 @@ bool P2PMessage::encode(bcos::bytes& _buffer)
     _buffer.swap(emptyBuffer);
 
     // compress payload
-    bcos::bytes compressData;
-    bool isCompressSuccess = false;
-    if (tryToCompressPayload(compressData))
+    auto compressData = compressedPayload();
+    if (compressData)
     {
-        isCompressSuccess = true;
         // set compress flag
         m_ext |= bcos::protocol::MessageExtFieldFlag::Compress;
     }
+    else
+    {
+        m_ext &= (~bcos::protocol::MessageExtFieldFlag::Compress);
+    }
 
     if (!encodeHeader(_buffer))
     {
@@ -256,13 +259,13 @@ bool P2PMessage::encode(bcos::bytes& _buffer)
     }
 
     // encode payload
-    if (isCompressSuccess)
+    if (compressData)
     {
         P2PMSG_LOG(TRACE) << LOG_DESC("compress payload success")
-                          << LOG_KV("compressedData", (char*)compressData.data())
+                          << LOG_KV("compressedSize", compressData->size())
                           << LOG_KV("packageType", m_packetType) << LOG_KV("ext", m_ext)
                           << LOG_KV("seq", m_seq);
-        _buffer.insert(_buffer.end(), compressData.begin(), compressData.end());
+        _buffer.insert(_buffer.end(), compressData->begin(), compressData->end());
     }
     else
     {
@@ -282,19 +285,51 @@ bool P2PMessage::encode(bcos::bytes& _buffer)
 /// compress the payload data to be sended
 bool P2PMessage::tryToCompressPayload(bytes& compressData)
 {
-    if (m_payload->size() <= bcos::gateway::c_compressThreshold)
+    auto compressedData = compressedPayload();
+    if (!compressedData)
     {
         return false;
     }
+    compressData = *compressedData;
+    return true;
+}
 
+std::shared_ptr<bytes> P2PMessage::compressedPayload()
+{
     if (m_version < (uint16_t)(bcos::protocol::ProtocolVersion::V2))
     {
-        return false;
+        return nullptr;
     }
-
-    bool isCompressSuccess =
-        ZstdCompress::compress(ref(*m_payload), compressData, bcos::gateway::c_zstdCompressLevel);
-    return isCompressSuccess;
+    auto const& policies = CompressPolicies::instance();
+    std::optional<uint16_t> moduleID;
+    if (hasOptions() && m_options)
+    {
+        moduleID = m_options->moduleID();
+    }
+    auto const& policy = policies.policy(moduleID);
+    auto dictionary = (policy.dictionaryThreshold > 0 && m_compressDictionaryID != 0) ?
+                          policies.dictionary(m_compressDictionaryID) :
+                          nullptr;
+    auto threshold = dictionary ? policy.dictionaryThreshold : policy.threshold;
+    if (m_payload->size() <= threshold)
+    {
+        return nullptr;
+    }
+    size_t index = dictionary ? 1 : 0;
+    if (!m_compressChecked[index])
+    {
+        m_compressChecked[index] = true;
+        auto compressData = std::make_shared<bytes>();
+        auto success =
+            dictionary ?
+                ZstdCompress::compress(ref(*m_payload), *compressData, policy.level, *dictionary) :
+                ZstdCompress::compress(ref(*m_payload), *compressData, policy.level);
+        if (success)
+        {
+            m_compressedPayloads[index] = std::move(compressData);
+        }
+    }
+    return m_compressedPayloads[index];
 }
 
 int32_t P2PMessage::decodeHeader(const bytesConstRef& _buffer)
@@ -373,12 +408,21 @@ int32_t P2PMessage::decode(const bytesConstRef& _buffer)
     if ((m_ext & bcos::protocol::MessageExtFieldFlag::Compress) ==
         bcos::protocol::MessageExtFieldFlag::Compress)
     {
-        bool isUncompressSuccess = ZstdCompress::uncompress(data, *m_payload);
+        bool isUncompressSuccess = false;
+        auto dictionaryID = ZstdCompress::dictionaryID(data);
+        if (dictionaryID == 0)
+        {
+            isUncompressSuccess = ZstdCompress::uncompress(data, *m_payload);
+        }
+        else if (auto dictionary = CompressPolicies::instance().dictionary(dictionaryID))
+        {
+            isUncompressSuccess = ZstdCompress::uncompress(data, *m_payload, *dictionary);
+        }
         if (!isUncompressSuccess)
         {
             P2PMSG_LOG(ERROR) << LOG_DESC("ZstdCompress decode message error, uncompress failed")
                               << LOG_KV("packageType", m_packetType) << LOG_KV("ext", m_ext)
-                              << LOG_KV("seq", m_seq);
+                              << LOG_KV("seq", m_seq) << LOG_KV("dictionaryID", dictionaryID);
             // invalid packet?
             return MessageDecodeStatus::MESSAGE_ERROR;
         }
@@ -390,7 +434,7 @@ int32_t P2PMessage::decode(const bytesConstRef& _buffer)
     }
     else
     {
-        m_payload = std::make_shared<bytes>(data.begin(), data.end());
+        m_payload = BufferPool::instance().copyShared(data);
     }
 
     return (int32_t)m_length;
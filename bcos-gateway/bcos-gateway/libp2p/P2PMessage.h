@@ -25,6 +25,7 @@
 #include <bcos-gateway/libnetwork/Common.h>
 #include <bcos-gateway/libnetwork/Message.h>
 #include <bcos-utilities/Common.h>
+#include <array>
 #include <vector>
 
 #define CHECK_OFFSET_WITH_THROW_EXCEPTION(offset, length)                                    \
@@ -126,6 +127,9 @@ public:
     const static size_t MESSAGE_HEADER_LENGTH = 14;
     const static size_t MAX_MESSAGE_LENGTH =
         100 * 1024 * 1024;  ///< The maximum length of data is 100M.
+    /// The header buffer taken from the pool, enough for the header, options and the p2p node ids
+    /// of the most messages
+    const static size_t HEADER_BUFFER_SIZE = 512;
 public:
     P2PMessage()
     {
@@ -175,7 +179,19 @@ public:
     void setOptions(P2PMessageOptions::Ptr _options) { m_options = _options; }
 
     std::shared_ptr<bytes> payload() const { return m_payload; }
-    void setPayload(std::shared_ptr<bytes> _payload) { m_payload = _payload; }
+    void setPayload(std::shared_ptr<bytes> _payload)
+    {
+        m_payload = _payload;
+        m_compressedPayloads = {};
+        m_compressChecked = {};
+    }
+
+    // the dictionary negotiated with the peer, 0 if none
+    uint32_t compressDictionaryID() const { return m_compressDictionaryID; }
+    virtual void setCompressDictionaryID(uint32_t _dictionaryID)
+    {
+        m_compressDictionaryID = _dictionaryID;
+    }
 
     void setRespPacket() { m_ext |= bcos::protocol::MessageExtFieldFlag::Response; }
     bool encode(bytes& _buffer) override;
@@ -188,6 +204,10 @@ public:
 
     // compress payload if payload need to be compressed
     bool tryToCompressPayload(bytes& compressData);
+    // The payload is compressed once with and once without the dictionary, shared by the encoded
+    // messages of all the peers, only the header is encoded per peer. nullptr if the payload is
+    // not compressed for the version or the compress policy of the module
+    std::shared_ptr<bytes> compressedPayload();
 
     bool hasOptions() const
     {
@@ -232,6 +252,11 @@ protected:
     P2PMessageOptions::Ptr m_options;  ///< options fields
 
     std::shared_ptr<bytes> m_payload;  ///< payload data
+    uint32_t m_compressDictionaryID = 0;
+    // the compressed payloads shared by the encoded messages, without and with the dictionary,
+    // reset with the payload
+    std::array<std::shared_ptr<bytes>, 2> m_compressedPayloads;
+    std::array<bool, 2> m_compressChecked{};
 
     MessageExtAttributes::Ptr m_extAttr = nullptr;  ///< message additional attributes
 };
@@ -10,6 +10,7 @@
 #include <bcos-gateway/libnetwork/SessionFace.h>
 #include <bcos-gateway/libp2p/Common.h>
 #include <bcos-gateway/libp2p/P2PMessage.h>
+#include <atomic>
 #include <memory>
 
 namespace bcos
@@ -54,6 +55,8 @@ public:
     {
         WriteGuard l(x_protocolInfo);
         *m_protocolInfo = *_protocolInfo;
+        auto const& dictionaryIDs = _protocolInfo->compressDictionaryIDs();
+        m_compressDictionaryID = dictionaryIDs.empty() ? 0 : dictionaryIDs.front();
     }
     // empty when negotiate failed or negotiate unfinished
     virtual bcos::protocol::ProtocolInfo::ConstPtr protocolInfo() const
@@ -62,6 +65,8 @@ public:
         // ReadGuard l(x_protocolInfo);
         return m_protocolInfo;
     }
+    // the negotiated message compress dictionary, 0 if none
+    virtual uint32_t compressDictionaryID() const { return m_compressDictionaryID; }
 
 private:
     SessionFace::Ptr m_session;
@@ -74,6 +79,7 @@ private:
 
     bcos::protocol::ProtocolInfo::Ptr m_protocolInfo = nullptr;
     mutable bcos::SharedMutex x_protocolInfo;
+    std::atomic_uint32_t m_compressDictionaryID{0};
 };
 
 }  // namespace gateway
@@ -6,9 +6,11 @@
 #include "bcos-utilities/BoostLog.h"
 #include <bcos-framework/protocol/CommonError.h>
 #include <bcos-gateway/libnetwork/ASIOInterface.h>  // for ASIOInterface
+#include <bcos-gateway/libnetwork/BufferPool.h>
 #include <bcos-gateway/libnetwork/Common.h>         // for SocketFace
 #include <bcos-gateway/libnetwork/SocketFace.h>     // for SocketFace
 #include <bcos-gateway/libp2p/Common.h>
+#include <bcos-gateway/libp2p/CompressPolicy.h>
 #include <bcos-gateway/libp2p/P2PInterface.h>  // for SessionCallbackFunc...
 #include <bcos-gateway/libp2p/P2PMessage.h>
 #include <bcos-gateway/libp2p/P2PSession.h>  // for P2PSession
@@ -130,7 +132,8 @@ void Service::heartBeat()
         sessions = m_sessions;
     }
     SERVICE_LOG(INFO) << METRIC << LOG_DESC("heartBeat")
-                      << LOG_KV("connected count", sessions.size());
+                      << LOG_KV("connected count", sessions.size())
+                      << LOG_KV("buffer pool", BufferPool::instance().statString());
     for (auto& [p2pID, session] : sessions)
     {
         auto queueSize = session->session()->writeQueueSize();
@@ -291,6 +294,7 @@ void Service::sendMessageToSession(P2PSession::Ptr _p2pSession, P2PMessage::Ptr
 {
     auto protocolVersion = _p2pSession->protocolInfo()->version();
     _msg->setVersion(protocolVersion);
+    _msg->setCompressDictionaryID(_p2pSession->compressDictionaryID());
     if (!_callback)
     {
         _p2pSession->session()->asyncSendMessage(_msg, _options, nullptr);
@@ -540,15 +544,26 @@ void Service::asyncBroadcastMessage(P2PMessage::Ptr message, Options options)
 {
     try
     {
-        std::unordered_map<P2pID, P2PSession::Ptr> sessions;
+        std::vector<P2PSession::Ptr> sessions;
         {
             RecursiveGuard guard(x_sessions);
-            sessions = m_sessions;
+            sessions.reserve(m_sessions.size());
+            for (auto const& it : m_sessions)
+            {
+                if (it.first != id() && it.second->active())
+                {
+                    sessions.emplace_back(it.second);
+                }
+            }
         }
-
+        if (message->seq() == 0)
+        {
+            message->setSeq(m_messageFactory->newSeq());
+        }
+        // the payload is compressed at the first session and shared by the others
         for (auto& session : sessions)
         {
-            asyncSendMessageByNodeID(session.first, message, nullptr, options);
+            sendMessageToSession(std::move(session), message, options, nullptr);
         }
     }
     catch (std::exception& e)
@@ -666,7 +681,16 @@ void Service::asyncSendMessageByP2PNodeIDs(
 void Service::asyncSendProtocol(P2PSession::Ptr _session)
 {
     auto payload = std::make_shared<bytes>();
-    m_codec->encode(m_localProtocol, *payload);
+    auto localProtocol = m_localProtocol;
+    auto dictionaryIDs = CompressPolicies::instance().dictionaryIDs();
+    if (!dictionaryIDs.empty())
+    {
+        // announce the dictionaries, the peer uses them after the handshake
+        auto protocol = std::make_shared<bcos::protocol::ProtocolInfo>(*m_localProtocol);
+        protocol->setCompressDictionaryIDs(std::move(dictionaryIDs));
+        localProtocol = std::move(protocol);
+    }
+    m_codec->encode(localProtocol, *payload);
     auto message = std::static_pointer_cast<P2PMessage>(messageFactory()->buildMessage());
     message->setPacketType(GatewayMessageType::Handshake);
     auto seq = messageFactory()->newSeq();
@@ -724,6 +748,10 @@ void Service::onReceiveProtocol(
         }
         auto version = std::min(m_localProtocol->maxVersion(), protocolInfo->maxVersion());
         protocolInfo->setVersion(version);
+        // negotiated dictionary
+        protocolInfo->setCompressDictionaryIDs(
+            CompressPolicies::instance().negotiateDictionaryIDs(
+                protocolInfo->compressDictionaryIDs()));
         _session->setProtocolInfo(protocolInfo);
         SERVICE_LOG(INFO) << LOG_DESC("onReceiveProtocol: protocolNegotiate success")
                           << LOG_KV("peer", _session->p2pID())
@@ -731,7 +759,8 @@ void Service::onReceiveProtocol(
                           << LOG_KV("maxVersion", protocolInfo->maxVersion())
                           << LOG_KV("supportMinVersion", m_localProtocol->minVersion())
                           << LOG_KV("supportMaxVersion", m_localProtocol->maxVersion())
-                          << LOG_KV("negotiatedVersion", version);
+                          << LOG_KV("negotiatedVersion", version)
+                          << LOG_KV("compressDictionaryID", _session->compressDictionaryID());
     }
     catch (std::exception const& e)
     {
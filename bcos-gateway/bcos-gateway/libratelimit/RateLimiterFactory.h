@@ -26,6 +26,7 @@
 #include "bcos-utilities/BoostLog.h"
 #include <bcos-gateway/libratelimit/DistributedRateLimiter.h>
 #include <bcos-gateway/libratelimit/RateLimiterInterface.h>
+#include <bcos-gateway/libratelimit/ShardedTokenBucketRateLimiter.h>
 #include <bcos-gateway/libratelimit/TokenBucketRateLimiter.h>
 #include <sw/redis++/redis++.h>
 
@@ -62,6 +63,27 @@ public:
         return rateLimiter;
     }
 
+    // sharded token bucket rate limiter, lock free for the limiters shared by the io threads
+    RateLimiterInterface::Ptr buildShardedTokenBucketRateLimiter(
+        int64_t _maxPermits, int32_t _timeWindowMS = 1000, bool _allowExceedMaxPermitSize = false)
+    {
+        auto rateLimiter = std::make_shared<ShardedTokenBucketRateLimiter>(
+            _maxPermits, _timeWindowMS, _allowExceedMaxPermitSize);
+        return rateLimiter;
+    }
+
+    // the rate limiter of this gateway only
+    RateLimiterInterface::Ptr buildLocalRateLimiter(int64_t _maxPermits, int32_t _timeWindowMS,
+        bool _allowExceedMaxPermitSize, bool _sharded)
+    {
+        if (_sharded)
+        {
+            return buildShardedTokenBucketRateLimiter(
+                _maxPermits, _timeWindowMS, _allowExceedMaxPermitSize);
+        }
+        return buildTimeWindowRateLimiter(_maxPermits, _timeWindowMS, _allowExceedMaxPermitSize);
+    }
+
     // redis distributed rate limiter
     RateLimiterInterface::Ptr buildDistributedRateLimiter(const std::string& _distributedKey,
         int64_t _maxPermitsSize, int32_t _intervalSec, bool _allowExceedMaxPermitSize,
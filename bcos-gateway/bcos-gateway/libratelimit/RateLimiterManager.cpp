@@ -147,8 +147,9 @@ RateLimiterInterface::Ptr RateLimiterManager::getGroupRateLimiter(const std::str
         }
         else
         {
-            rateLimiter = m_rateLimiterFactory->buildTimeWindowRateLimiter(
-                groupOutgoingBwLimit * timeWindowS, timeWindowMS, allowExceedMaxPermitSize);
+            rateLimiter = m_rateLimiterFactory->buildLocalRateLimiter(
+                groupOutgoingBwLimit * timeWindowS, timeWindowMS, allowExceedMaxPermitSize,
+                m_rateLimiterConfig.enableShardedRatelimit);
         }
 
         auto result = registerRateLimiter(_group, rateLimiter);
@@ -194,8 +195,9 @@ RateLimiterInterface::Ptr RateLimiterManager::getInRateLimiter(
     bool allowExceedMaxPermitSize = m_rateLimiterConfig.allowExceedMaxPermitSize;
     int64_t QPS = m_rateLimiterConfig.p2pBasicMsgQPS;
 
-    rateLimiter = m_rateLimiterFactory->buildTimeWindowRateLimiter(
-        QPS * timeWindowS, timeWindowMS, allowExceedMaxPermitSize);
+    rateLimiter = m_rateLimiterFactory->buildLocalRateLimiter(
+        QPS * timeWindowS, timeWindowMS, allowExceedMaxPermitSize,
+        m_rateLimiterConfig.enableShardedRatelimit);
 
     auto result = registerRateLimiter(inKey, rateLimiter);
     return result.first ? rateLimiter : result.second;
@@ -248,8 +250,9 @@ RateLimiterInterface::Ptr RateLimiterManager::getInRateLimiter(
     }
     else
     {
-        rateLimiter = m_rateLimiterFactory->buildTimeWindowRateLimiter(
-            QPS * timeWindowS, timeWindowMS, allowExceedMaxPermitSize);
+        rateLimiter = m_rateLimiterFactory->buildLocalRateLimiter(
+            QPS * timeWindowS, timeWindowMS, allowExceedMaxPermitSize,
+            m_rateLimiterConfig.enableShardedRatelimit);
     }
 
     auto result = registerRateLimiter(inKey, rateLimiter);
@@ -294,8 +297,9 @@ RateLimiterInterface::Ptr RateLimiterManager::getConnRateLimiter(const std::stri
                                 << LOG_KV("connOutgoingBwLimit", connOutgoingBwLimit)
                                 << LOG_KV("timeWindowS", timeWindowS);
 
-        rateLimiter = m_rateLimiterFactory->buildTimeWindowRateLimiter(
-            connOutgoingBwLimit * timeWindowS, timeWindowMS, allowExceedMaxPermitSize);
+        rateLimiter = m_rateLimiterFactory->buildLocalRateLimiter(
+            connOutgoingBwLimit * timeWindowS, timeWindowMS, allowExceedMaxPermitSize,
+            m_rateLimiterConfig.enableShardedRatelimit);
         auto result = registerRateLimiter(rateLimiterKey, rateLimiter);
         rateLimiter = (result.first ? rateLimiter : result.second);
     }
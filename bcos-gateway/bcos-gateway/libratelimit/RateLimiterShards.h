@@ -0,0 +1,57 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief shards of the rate limiters and the stat, one per thread if the cores are enough
+ * @file RateLimiterShards.h
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <thread>
+
+namespace bcos
+{
+namespace gateway
+{
+namespace ratelimiter
+{
+
+constexpr static size_t MAX_RATELIMITER_SHARDS = 64;
+
+// power of two, not less than the cores
+inline size_t rateLimiterShardsCount()
+{
+    static const size_t count = std::min(
+        std::bit_ceil(std::max<size_t>(std::thread::hardware_concurrency(), 1)),
+        MAX_RATELIMITER_SHARDS);
+    return count;
+}
+
+// The threads take the shards in turn at the first call, the io threads of the gateway mostly
+// have their own shards
+inline size_t currentRateLimiterShard()
+{
+    static std::atomic_size_t threads{0};
+    thread_local const size_t shard =
+        threads.fetch_add(1, std::memory_order_relaxed) & (rateLimiterShardsCount() - 1);
+    return shard;
+}
+
+}  // namespace ratelimiter
+}  // namespace gateway
+}  // namespace bcos
@@ -123,6 +123,7 @@ void RateLimiterStat::updateInComing0(
     {
         return;
     }
+    auto& shard = localShard();
 
     std::string epKey = toEndpointKey(_endpoint);
     std::string totalKey = TOTAL_OUTGOING;
@@ -131,10 +132,10 @@ void RateLimiterStat::updateInComing0(
     //                     << LOG_KV("dataSize", _dataSize);
 
     {
-        std::lock_guard<std::mutex> lock(m_inLock);
+        std::lock_guard<std::mutex> lock(shard.inLock);
 
-        auto& totalInStat = m_inStat[totalKey];
-        auto& epInStat = m_inStat[epKey];
+        auto& totalInStat = shard.inStat[totalKey];
+        auto& epInStat = shard.inStat[epKey];
         if (_suc)
         {
             // update total incoming
@@ -155,8 +156,8 @@ void RateLimiterStat::updateInComing0(
     {
         std::string epPkgKey = toEndpointPkgTypeKey(_endpoint, _pgkType);
 
-        std::lock_guard<std::mutex> lock(m_inLock);
-        auto& epPkgInStat = m_inStat[epPkgKey];
+        std::lock_guard<std::mutex> lock(shard.inLock);
+        auto& epPkgInStat = shard.inStat[epPkgKey];
 
         if (_suc)
         {
@@ -176,13 +177,14 @@ void RateLimiterStat::updateOutGoing(const std::string& _endpoint, uint64_t _dat
     {
         return;
     }
+    auto& shard = localShard();
 
     std::string epKey = toEndpointKey(_endpoint);
     std::string totalKey = TOTAL_OUTGOING;
 
-    std::lock_guard<std::mutex> lock(m_outLock);
-    auto& totalOutStat = m_outStat[totalKey];
-    auto& epOutStat = m_outStat[epKey];
+    std::lock_guard<std::mutex> lock(shard.outLock);
+    auto& totalOutStat = shard.outStat[totalKey];
+    auto& epOutStat = shard.outStat[epKey];
 
     if (suc)
     {
@@ -207,13 +209,14 @@ void RateLimiterStat::updateInComing(
     {
         return;
     }
+    auto& shard = localShard();
 
     if (_groupID.empty() && (_moduleID != 0))
     {  // amop
         std::string moduleKey = toModuleKey(_moduleID);
-        std::lock_guard<std::mutex> lock(m_inLock);
+        std::lock_guard<std::mutex> lock(shard.inLock);
 
-        auto& moduleInStat = m_inStat[moduleKey];
+        auto& moduleInStat = shard.inStat[moduleKey];
 
         if (_suc)
         {
@@ -229,15 +232,15 @@ void RateLimiterStat::updateInComing(
 
     std::string groupKey = toGroupKey(_groupID);
 
-    std::lock_guard<std::mutex> lock(m_inLock);
-    auto& groupInStat = m_inStat[groupKey];
+    std::lock_guard<std::mutex> lock(shard.inLock);
+    auto& groupInStat = shard.inStat[groupKey];
     groupInStat.update(_dataSize);
 
     if (m_enableConnectDebugInfo && (_moduleID != 0))
     {
         std::string key = toModuleKey(_groupID, _moduleID);
 
-        auto& inStat = m_inStat[key];
+        auto& inStat = shard.inStat[key];
 
         if (_suc)
         {
@@ -257,15 +260,16 @@ void RateLimiterStat::updateOutGoing(
     {
         return;
     }
+    auto& shard = localShard();
 
     if (_groupID.empty())
     {
         if (_moduleID != 0)
         {  // AMOP
             std::string moduleKey = toModuleKey(_moduleID);
-            std::lock_guard<std::mutex> lock(m_outLock);
+            std::lock_guard<std::mutex> lock(shard.outLock);
 
-            auto& moduleOutStat = m_outStat[moduleKey];
+            auto& moduleOutStat = shard.outStat[moduleKey];
             moduleOutStat.update(_dataSize);
 
             if (suc)
@@ -287,9 +291,9 @@ void RateLimiterStat::updateOutGoing(
     }
 
     std::string groupKey = toGroupKey(_groupID);
-    std::lock_guard<std::mutex> lock(m_outLock);
+    std::lock_guard<std::mutex> lock(shard.outLock);
 
-    auto& groupOutStat = m_outStat[groupKey];
+    auto& groupOutStat = shard.outStat[groupKey];
     if (suc)
     {
         // update total outgoing
@@ -304,7 +308,7 @@ void RateLimiterStat::updateOutGoing(
     {
         std::string key = toModuleKey(_groupID, _moduleID);
 
-        auto& outStat = m_outStat[key];
+        auto& outStat = shard.outStat[key];
         if (suc)
         {
             // update total outgoing
@@ -320,37 +324,58 @@ void RateLimiterStat::updateOutGoing(
 
 void RateLimiterStat::flushStat()
 {
+    for (auto& shard : m_shards)
     {
-        std::lock_guard<std::mutex> lock(m_inLock);
-        for (auto& [k, s] : m_inStat)
         {
-            s.resetLast();
+            std::lock_guard<std::mutex> lock(shard.inLock);
+            for (auto& [k, s] : shard.inStat)
+            {
+                s.resetLast();
+            }
         }
-    }
 
-    {
-        std::lock_guard<std::mutex> lock(m_outLock);
-        for (auto& [k, s] : m_outStat)
         {
-            s.resetLast();
+            std::lock_guard<std::mutex> lock(shard.outLock);
+            for (auto& [k, s] : shard.outStat)
+            {
+                s.resetLast();
+            }
         }
     }
 }
 
-std::pair<std::string, std::string> RateLimiterStat::inAndOutStat(uint32_t _intervalMS)
+std::unordered_map<std::string, Stat> RateLimiterStat::inStat()
 {
     std::unordered_map<std::string, Stat> inStat;
-    std::unordered_map<std::string, Stat> outStat;
-
+    for (auto& shard : m_shards)
     {
-        std::lock_guard<std::mutex> lock(m_inLock);
-        inStat = m_inStat;
+        std::lock_guard<std::mutex> lock(shard.inLock);
+        for (const auto& [k, s] : shard.inStat)
+        {
+            inStat[k].merge(s);
+        }
     }
+    return inStat;
+}
 
+std::unordered_map<std::string, Stat> RateLimiterStat::outStat()
+{
+    std::unordered_map<std::string, Stat> outStat;
+    for (auto& shard : m_shards)
     {
-        std::lock_guard<std::mutex> lock(m_outLock);
-        outStat = m_outStat;
+        std::lock_guard<std::mutex> lock(shard.outLock);
+        for (const auto& [k, s] : shard.outStat)
+        {
+            outStat[k].merge(s);
+        }
     }
+    return outStat;
+}
+
+std::pair<std::string, std::string> RateLimiterStat::inAndOutStat(uint32_t _intervalMS)
+{
+    auto inStat = this->inStat();
+    auto outStat = this->outStat();
 
     std::map<std::string, Stat> inStatMap{inStat.begin(), inStat.end()};
     std::map<std::string, Stat> outStatMap{outStat.begin(), outStat.end()};
@@ -22,6 +22,7 @@
 #include "bcos-framework/protocol/Protocol.h"
 #include "bcos-gateway/Common.h"
 #include "bcos-utilities/Timer.h"
+#include <bcos-gateway/libratelimit/RateLimiterShards.h>
 #include <array>
 #include <memory>
 #include <mutex>
@@ -29,6 +30,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace bcos
 {
@@ -40,14 +42,14 @@ namespace ratelimiter
 //
 struct Stat
 {
-    uint64_t totalDataSize;
-    uint64_t lastDataSize;
+    uint64_t totalDataSize = 0;
+    uint64_t lastDataSize = 0;
 
-    uint64_t totalTimes;
-    int64_t lastTimes;
+    uint64_t totalTimes = 0;
+    int64_t lastTimes = 0;
 
-    uint64_t totalFailedTimes;
-    int64_t lastFailedTimes;
+    uint64_t totalFailedTimes = 0;
+    int64_t lastFailedTimes = 0;
 
 public:
     void resetLast()
@@ -72,6 +74,16 @@ public:
         lastFailedTimes++;
     }
 
+    void merge(const Stat& _stat)
+    {
+        totalDataSize += _stat.totalDataSize;
+        lastDataSize += _stat.lastDataSize;
+        totalTimes += _stat.totalTimes;
+        lastTimes += _stat.lastTimes;
+        totalFailedTimes += _stat.totalFailedTimes;
+        lastFailedTimes += _stat.lastFailedTimes;
+    }
+
     std::optional<std::string> toString(const std::string& _prefix, uint32_t _periodMS) const;
 };
 
@@ -133,8 +145,9 @@ public:
 
     std::pair<std::string, std::string> inAndOutStat(uint32_t _intervalMS);
 
-    const auto& inStat() const { return m_inStat; }
-    const auto& outStat() const { return m_outStat; }
+    // merged from the shards
+    std::unordered_map<std::string, Stat> inStat();
+    std::unordered_map<std::string, Stat> outStat();
 
     int32_t statInterval() const { return m_statInterval; }
     void setStatInterval(int32_t _statInterval) { m_statInterval = _statInterval; }
@@ -153,12 +166,18 @@ private:
     // print more debug info
     bool m_enableConnectDebugInfo = true;
 
-    std::mutex m_inLock;
-    std::mutex m_outLock;
-
-    // TODO: How to clean up the disconnected connections
-    std::unordered_map<std::string, Stat> m_inStat;
-    std::unordered_map<std::string, Stat> m_outStat;
+    // The packets are counted in the shard of the thread, merged when reported
+    struct alignas(64) StatShard
+    {
+        std::mutex inLock;
+        std::mutex outLock;
+
+        // TODO: How to clean up the disconnected connections
+        std::unordered_map<std::string, Stat> inStat;
+        std::unordered_map<std::string, Stat> outStat;
+    };
+    StatShard& localShard() { return m_shards[currentRateLimiterShard()]; }
+    std::vector<StatShard> m_shards{rateLimiterShardsCount()};
 
     // ratelimiter stat report period, default 1 min
     constexpr static int32_t DEFAULT_STAT_INTERVAL_MS = 60000;
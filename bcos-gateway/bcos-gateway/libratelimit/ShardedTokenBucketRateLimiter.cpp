@@ -0,0 +1,194 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief lock free token bucket rate limiter with the permits cached per thread
+ * @file ShardedTokenBucketRateLimiter.cpp
+ */
+#include "bcos-gateway/Common.h"
+#include "bcos-utilities/BoostLog.h"
+#include <bcos-gateway/libratelimit/RateLimiterShards.h>
+#include <bcos-gateway/libratelimit/ShardedTokenBucketRateLimiter.h>
+#include <bcos-utilities/Common.h>
+#include <chrono>
+#include <thread>
+
+using namespace bcos;
+using namespace bcos::gateway;
+using namespace bcos::gateway::ratelimiter;
+
+ShardedTokenBucketRateLimiter::ShardedTokenBucketRateLimiter(
+    int64_t _maxPermitsSize, int64_t _timeWindowMS, bool _allowExceedMaxPermitSize)
+  : m_maxPermitsSize(_maxPermitsSize),
+    m_timeWindowUs(std::max<int64_t>(_timeWindowMS, 1) * 1000),
+    m_allowExceedMaxPermitSize(_allowExceedMaxPermitSize),
+    // a shard caches 1/8 of the average share at most, the others can still get the most
+    m_batchSize(std::max<int64_t>(
+        _maxPermitsSize / (int64_t)(rateLimiterShardsCount() * 8), 1)),
+    m_refillIntervalUs(std::max<int64_t>(m_timeWindowUs / 100, 1000)),
+    m_permits(_maxPermitsSize),
+    m_lastRefillTime(utcSteadyTimeUs()),
+    m_shards(rateLimiterShardsCount())
+{
+    RATELIMIT_LOG(INFO) << LOG_BADGE("[NEWOBJ][ShardedTokenBucketRateLimiter]")
+                        << LOG_KV("maxPermitsSize", _maxPermitsSize)
+                        << LOG_KV("allowExceedMaxPermitSize", _allowExceedMaxPermitSize)
+                        << LOG_KV("timeWindowMS", _timeWindowMS)
+                        << LOG_KV("shards", m_shards.size()) << LOG_KV("batchSize", m_batchSize);
+}
+
+bool ShardedTokenBucketRateLimiter::tryAcquire(int64_t _requiredPermits)
+{
+    if (_requiredPermits > m_maxPermitsSize)
+    {
+        if (m_allowExceedMaxPermitSize)
+        {
+            return true;
+        }
+
+        // Notice: the acquire amount exceeded the maximum, it will never succeed
+        RATELIMIT_LOG(WARNING) << LOG_DESC("try acquire exceeded the maximum")
+                               << LOG_KV("requiredPermits", _requiredPermits)
+                               << LOG_KV("maxPermitsSize", m_maxPermitsSize);
+        return false;
+    }
+
+    auto& shard = m_shards[currentRateLimiterShard() & (m_shards.size() - 1)];
+    if (tryTake(shard.permits, _requiredPermits))
+    {
+        return true;
+    }
+
+    refill(utcSteadyTimeUs());
+    auto batchSize = std::max(_requiredPermits, m_batchSize);
+    auto lastRefillTime = m_lastRefillTime.load(std::memory_order_relaxed);
+    if (tryTake(m_permits, batchSize))
+    {
+        auto leftPermits = batchSize - _requiredPermits;
+        if (m_lastRefillTime.load(std::memory_order_relaxed) == lastRefillTime)
+        {
+            shard.permits.fetch_add(leftPermits, std::memory_order_relaxed);
+        }
+        else
+        {
+            // the shards have been collected and the bucket clamped by the refill meanwhile
+            returnPermits(leftPermits);
+        }
+        return true;
+    }
+    if (batchSize > _requiredPermits && tryTake(m_permits, _requiredPermits))
+    {
+        return true;
+    }
+    // the bucket is empty, take the permits cached by the other threads
+    for (auto& other : m_shards)
+    {
+        if (&other != &shard && tryTake(other.permits, _requiredPermits))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ShardedTokenBucketRateLimiter::acquire(int64_t _requiredPermits)
+{
+    if (_requiredPermits > m_maxPermitsSize)
+    {
+        if (m_allowExceedMaxPermitSize)
+        {
+            return true;
+        }
+
+        // Notice: the acquire amount exceeded the maximum, it will never succeed
+        RATELIMIT_LOG(WARNING) << LOG_DESC("acquire exceeded the maximum")
+                               << LOG_KV("requiredPermits", _requiredPermits)
+                               << LOG_KV("maxPermitsSize", m_maxPermitsSize);
+        return false;
+    }
+
+    while (!tryAcquire(_requiredPermits))
+    {
+        // sleep for the next refill
+        std::this_thread::sleep_for(std::chrono::microseconds(m_refillIntervalUs));
+    }
+    return true;
+}
+
+void ShardedTokenBucketRateLimiter::rollback(int64_t _requiredPermits)
+{
+    returnPermits(_requiredPermits);
+}
+
+int64_t ShardedTokenBucketRateLimiter::availablePermits() const
+{
+    auto permits = m_permits.load(std::memory_order_relaxed);
+    for (auto const& shard : m_shards)
+    {
+        permits += shard.permits.load(std::memory_order_relaxed);
+    }
+    return permits;
+}
+
+bool ShardedTokenBucketRateLimiter::tryTake(std::atomic_int64_t& _permits, int64_t _requiredPermits)
+{
+    auto permits = _permits.load(std::memory_order_relaxed);
+    while (permits >= _requiredPermits)
+    {
+        if (_permits.compare_exchange_weak(
+                permits, permits - _requiredPermits, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ShardedTokenBucketRateLimiter::refill(int64_t _nowUs)
+{
+    auto lastRefillTime = m_lastRefillTime.load(std::memory_order_relaxed);
+    auto elapsed = std::min(_nowUs - lastRefillTime, m_timeWindowUs);
+    if (elapsed < m_refillIntervalUs)
+    {
+        return;
+    }
+    // elapsed and maxPermitsSize are small enough to multiply
+    auto increased = elapsed * m_maxPermitsSize / m_timeWindowUs;
+    if (increased == 0)
+    {
+        // less than one permit, wait for more time
+        return;
+    }
+    if (!m_lastRefillTime.compare_exchange_strong(
+            lastRefillTime, _nowUs, std::memory_order_relaxed))
+    {
+        // refilled by the other thread
+        return;
+    }
+    // rebalance: the permits cached in the shards back to the bucket
+    for (auto& shard : m_shards)
+    {
+        increased += shard.permits.exchange(0, std::memory_order_relaxed);
+    }
+    returnPermits(increased);
+}
+
+void ShardedTokenBucketRateLimiter::returnPermits(int64_t _permits)
+{
+    auto permits = m_permits.load(std::memory_order_relaxed);
+    while (!m_permits.compare_exchange_weak(
+        permits, std::min(permits + _permits, m_maxPermitsSize), std::memory_order_relaxed))
+    {
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief lock free token bucket rate limiter with the permits cached per thread
+ * @file ShardedTokenBucketRateLimiter.h
+ */
+#pragma once
+
+#include <bcos-gateway/libratelimit/RateLimiterInterface.h>
+#include <bcos-utilities/ObjectCounter.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace bcos
+{
+namespace gateway
+{
+namespace ratelimiter
+{
+
+// The bucket holds maxPermitsSize permits at most and is refilled with maxPermitsSize permits
+// every time window. The threads take the permits in batches from the bucket into their shards
+// and acquire from the shards without touching the shared cache lines. The permits left in the
+// shards are collected back to the bucket when refilled, the rolled back permits go to the bucket
+// directly, the bucket is clamped to maxPermitsSize. A batch taken right before a refill may still
+// be cached in its shard after the refill, the available permits exceed maxPermitsSize by at most
+// shardsCount * batchSize until the next refill
+class ShardedTokenBucketRateLimiter : public RateLimiterInterface,
+                                      public bcos::ObjectCounter<ShardedTokenBucketRateLimiter>
+{
+public:
+    using Ptr = std::shared_ptr<ShardedTokenBucketRateLimiter>;
+    using ConstPtr = std::shared_ptr<const ShardedTokenBucketRateLimiter>;
+    using UniquePtr = std::unique_ptr<const ShardedTokenBucketRateLimiter>;
+
+    ShardedTokenBucketRateLimiter(int64_t _maxPermitsSize, int64_t _timeWindowMS = 1000,
+        bool _allowExceedMaxPermitSize = false);
+
+    ShardedTokenBucketRateLimiter(ShardedTokenBucketRateLimiter&&) = delete;
+    ShardedTokenBucketRateLimiter(const ShardedTokenBucketRateLimiter&) = delete;
+    ShardedTokenBucketRateLimiter& operator=(const ShardedTokenBucketRateLimiter&) = delete;
+    ShardedTokenBucketRateLimiter& operator=(ShardedTokenBucketRateLimiter&&) = delete;
+
+    ~ShardedTokenBucketRateLimiter() override = default;
+
+    bool acquire(int64_t _requiredPermits) override;
+    bool tryAcquire(int64_t _requiredPermits) override;
+    void rollback(int64_t _requiredPermits) override;
+
+    int64_t maxPermitsSize() const { return m_maxPermitsSize; }
+    int64_t timeWindowMS() const { return m_timeWindowUs / 1000; }
+    bool allowExceedMaxPermitSize() const { return m_allowExceedMaxPermitSize; }
+    size_t shardsCount() const { return m_shards.size(); }
+    // the permits in the bucket and the shards, summed when called
+    int64_t availablePermits() const;
+
+private:
+    static bool tryTake(std::atomic_int64_t& _permits, int64_t _requiredPermits);
+    void refill(int64_t _nowUs);
+    // add the permits to the bucket, no more than maxPermitsSize
+    void returnPermits(int64_t _permits);
+
+    struct alignas(64) Shard
+    {
+        std::atomic_int64_t permits{0};
+    };
+
+    int64_t m_maxPermitsSize;
+    int64_t m_timeWindowUs;
+    bool m_allowExceedMaxPermitSize;
+    // the permits moved from the bucket to a shard at once
+    int64_t m_batchSize;
+    int64_t m_refillIntervalUs;
+
+    alignas(64) std::atomic_int64_t m_permits;
+    alignas(64) std::atomic_int64_t m_lastRefillTime;
+    std::vector<Shard> m_shards;
+};
+
+}  // namespace ratelimiter
+}  // namespace gateway
+}  // namespace bcos
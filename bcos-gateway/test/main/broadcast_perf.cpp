@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file broadcast_perf.cpp
+ * @brief the encode cost of a broadcast message by the peers count, a message built for each peer
+ * compresses the payload for each peer, a message shared by the peers compresses it once
+ */
+#include "bcos-gateway/Common.h"
+#include "bcos-gateway/libp2p/P2PMessageV2.h"
+#include "bcos-utilities/Common.h"
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace bcos;
+using namespace gateway;
+
+P2PMessage::Ptr buildBroadcastMessage(std::shared_ptr<bytes> payload)
+{
+    auto factory = std::make_shared<P2PMessageFactoryV2>();
+    auto message = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    message->setVersion(2);
+    message->setSeq(0x12345678);
+    message->setPacketType(GatewayMessageType::BroadcastMessage);
+    message->setPayload(std::move(payload));
+
+    std::string groupID = "group";
+    std::string srcNodeID = "nodeID";
+    message->options()->setGroupID(groupID);
+    message->options()->setSrcNodeID(std::make_shared<bytes>(srcNodeID.begin(), srcNodeID.end()));
+    return message;
+}
+
+// Compressible as the blocks and transactions
+std::shared_ptr<bytes> buildBroadcastPayload(size_t size)
+{
+    auto payload = std::make_shared<bytes>(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        (*payload)[i] = (byte)((i * 7) % 13 + (i / 64) % 5);
+    }
+    return payload;
+}
+
+int main(int argc, const char** argv)
+{
+    if ((argc >= 2) && ((std::string(argv[1]) == "-h") || (std::string(argv[1]) == "--help")))
+    {
+        std::cerr << "./broadcast-perf [payloadSize] [loop]" << std::endl;
+        return -1;
+    }
+
+    size_t payloadSize = argc > 1 ? std::stoul(argv[1]) : 256 * 1024;
+    size_t loop = argc > 2 ? std::stoul(argv[2]) : 10;
+    auto payload = buildBroadcastPayload(payloadSize);
+
+    for (size_t peers : {1, 4, 16, 30, 64, 128})
+    {
+        size_t size = 0;
+        auto now = utcSteadyTime();
+        for (size_t i = 0; i < loop; ++i)
+        {
+            for (size_t peer = 0; peer < peers; ++peer)
+            {
+                auto message = buildBroadcastMessage(payload);
+                EncodedMessage encoded;
+                message->encode(encoded);
+                size += encoded.dataSize();
+            }
+        }
+        auto perPeerCost = utcSteadyTime() - now;
+
+        now = utcSteadyTime();
+        for (size_t i = 0; i < loop; ++i)
+        {
+            auto message = buildBroadcastMessage(payload);
+            for (size_t peer = 0; peer < peers; ++peer)
+            {
+                EncodedMessage encoded;
+                message->encode(encoded);
+                size += encoded.dataSize();
+            }
+        }
+        auto sharedCost = utcSteadyTime() - now;
+        std::cout << "broadcast " << payloadSize << " bytes to " << peers << " peers, loop: " << loop
+                  << ", message per peer cost: " << perPeerCost
+                  << "ms, shared message cost: " << sharedCost
+                  << "ms, encoded bytes: " << size << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file ratelimiter_perf.cpp
+ * @brief compare the acquire cost of the rate limiters and the stat update cost under contention
+ */
+#include "bcos-gateway/libratelimit/RateLimiterStat.h"
+#include "bcos-gateway/libratelimit/ShardedTokenBucketRateLimiter.h"
+#include "bcos-gateway/libratelimit/TimeWindowRateLimiter.h"
+#include "bcos-utilities/Common.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace bcos;
+using namespace gateway;
+
+int main(int argc, const char** argv)
+{
+    if ((argc >= 2) && ((std::string(argv[1]) == "-h") || (std::string(argv[1]) == "--help")))
+    {
+        std::cerr << "./ratelimiter-perf [threads] [acquirePerThread]" << std::endl;
+        return -1;
+    }
+
+    size_t threadsCount =
+        argc > 1 ? std::stoul(argv[1]) : std::max(std::thread::hardware_concurrency(), 4U);
+    int acquireCount = argc > 2 ? std::stoi(argv[2]) : 200000;
+    constexpr static int64_t maxPermitsSize = 1000000000;
+
+    auto runThreads = [&](auto&& work) {
+        auto startT = utcSteadyTime();
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threadsCount; i++)
+        {
+            threads.emplace_back([&]() {
+                for (int j = 0; j < acquireCount; j++)
+                {
+                    work();
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        return utcSteadyTime() - startT;
+    };
+
+    auto timeWindowRateLimiter =
+        std::make_shared<ratelimiter::TimeWindowRateLimiter>(maxPermitsSize);
+    auto timeWindowCost = runThreads([&]() { timeWindowRateLimiter->tryAcquire(1); });
+    auto shardedRateLimiter =
+        std::make_shared<ratelimiter::ShardedTokenBucketRateLimiter>(maxPermitsSize);
+    auto shardedCost = runThreads([&]() { shardedRateLimiter->tryAcquire(1); });
+    std::cout << "rate limiter acquire, threads: " << threadsCount
+              << ", acquire per thread: " << acquireCount
+              << ", TimeWindowRateLimiter cost: " << timeWindowCost
+              << "ms, ShardedTokenBucketRateLimiter cost: " << shardedCost << "ms" << std::endl;
+
+    auto rateLimiterStat = std::make_shared<ratelimiter::RateLimiterStat>();
+    auto statCost =
+        runThreads([&]() { rateLimiterStat->updateOutGoing("group0", 1000, 10, true); });
+    std::cout << "rate limiter stat update, threads: " << threadsCount
+              << ", update per thread: " << acquireCount << ", cost: " << statCost << "ms"
+              << std::endl;
+    return 0;
+}
@@ -24,6 +24,7 @@
 #define BOOST_TEST_MAIN
 
 #include <bcos-gateway/Common.h>
+#include <bcos-gateway/libp2p/CompressPolicy.h>
 #include <bcos-gateway/libp2p/P2PInterface.h>
 #include <bcos-gateway/libp2p/P2PMessage.h>
 #include <bcos-gateway/libp2p/P2PMessageV2.h>
@@ -474,6 +475,155 @@ BOOST_AUTO_TEST_CASE(test_P2PMessage_compress)
     */
 }
 
+P2PMessage::Ptr buildBroadcastMessage(std::shared_ptr<bytes> payload)
+{
+    auto factory = std::make_shared<P2PMessageFactoryV2>();
+    auto message = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    message->setVersion(2);
+    message->setSeq(0x12345678);
+    message->setPacketType(GatewayMessageType::BroadcastMessage);
+    message->setPayload(std::move(payload));
+
+    std::string groupID = "group";
+    std::string srcNodeID = "nodeID";
+    message->options()->setGroupID(groupID);
+    message->options()->setSrcNodeID(std::make_shared<bytes>(srcNodeID.begin(), srcNodeID.end()));
+    return message;
+}
+
+std::shared_ptr<bytes> buildBroadcastPayload(size_t size)
+{
+    auto payload = std::make_shared<bytes>(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        (*payload)[i] = (byte)((i * 7) % 13 + (i / 64) % 5);
+    }
+    return payload;
+}
+
+BOOST_AUTO_TEST_CASE(test_P2PMessage_sharedCompress)
+{
+    auto factory = std::make_shared<P2PMessageFactoryV2>();
+    auto payload = buildBroadcastPayload(10000);
+    auto message = buildBroadcastMessage(payload);
+
+    auto checkDecode = [&](EncodedMessage const& encoded) {
+        bytes buffer(encoded.header.begin(), encoded.header.end());
+        buffer.insert(buffer.end(), encoded.payload->begin(), encoded.payload->end());
+        auto decodeMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+        BOOST_CHECK_EQUAL(decodeMsg->decode(ref(buffer)), (int32_t)buffer.size());
+        BOOST_CHECK(*decodeMsg->payload() == *payload);
+    };
+
+    // the peers share the compressed payload
+    EncodedMessage first;
+    BOOST_CHECK(message->encode(first));
+    BOOST_CHECK(first.payload != payload);
+    BOOST_CHECK_LT(first.payloadSize(), payload->size());
+    EncodedMessage second;
+    BOOST_CHECK(message->encode(second));
+    BOOST_CHECK(second.payload == first.payload);
+    checkDecode(second);
+
+    // the peer of old version doesn't support compression
+    message->setVersion(1);
+    EncodedMessage old;
+    BOOST_CHECK(message->encode(old));
+    BOOST_CHECK(old.payload == payload);
+    BOOST_CHECK_EQUAL((message->ext() & bcos::protocol::MessageExtFieldFlag::Compress), 0);
+    checkDecode(old);
+
+    message->setVersion(2);
+    EncodedMessage withoutCompress;
+    withoutCompress.compress = false;
+    BOOST_CHECK(message->encode(withoutCompress));
+    BOOST_CHECK(withoutCompress.payload == payload);
+    checkDecode(withoutCompress);
+
+    // the new payload is compressed again
+    auto newPayload = buildBroadcastPayload(20000);
+    message->setPayload(newPayload);
+    payload = newPayload;
+    EncodedMessage third;
+    BOOST_CHECK(message->encode(third));
+    BOOST_CHECK(third.payload != first.payload);
+    checkDecode(third);
+}
+
+std::shared_ptr<bytes> buildVotePayload(size_t index)
+{
+    std::string vote = "{\"type\":\"prepare\",\"view\":" + std::to_string(index % 3) +
+                       ",\"index\":" + std::to_string(100000 + index) +
+                       ",\"hash\":\"0x" + std::to_string(index * 7919) + "\",\"sign\":\"";
+    vote.append(200, (char)('a' + index % 26));
+    return std::make_shared<bytes>(vote.begin(), vote.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_P2PMessage_compressPolicy)
+{
+    auto factory = std::make_shared<P2PMessageFactoryV2>();
+    auto& policies = CompressPolicies::instance();
+    auto checkDecode = [&](EncodedMessage const& encoded, bytes const& payload) {
+        bytes buffer(encoded.header.begin(), encoded.header.end());
+        buffer.insert(buffer.end(), encoded.payload->begin(), encoded.payload->end());
+        auto decodeMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+        BOOST_CHECK_EQUAL(decodeMsg->decode(ref(buffer)), (int32_t)buffer.size());
+        BOOST_CHECK(*decodeMsg->payload() == payload);
+    };
+
+    // the transactions are compressed above the lower threshold
+    auto payload = buildBroadcastPayload(800);
+    auto message = buildBroadcastMessage(payload);
+    BOOST_CHECK(!message->compressedPayload());
+    message->options()->setModuleID(bcos::protocol::ModuleID::TxsSync);
+    message->setPayload(payload);
+    BOOST_CHECK(message->compressedPayload());
+    message->options()->setModuleID(bcos::protocol::ModuleID::PBFT);
+    message->setPayload(payload);
+    BOOST_CHECK(!message->compressedPayload());
+
+    // the small votes are compressed with the negotiated dictionary
+    std::vector<bytes> samples;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        samples.emplace_back(*buildVotePayload(i));
+    }
+    auto dictionary = std::make_shared<ZstdDictionary>(ZstdDictionary::train(samples, 4096));
+    policies.setDictionary(dictionary);
+    BOOST_CHECK(policies.negotiateDictionaryIDs({1, dictionary->id()}) ==
+                std::vector<uint32_t>{dictionary->id()});
+    BOOST_CHECK(policies.negotiateDictionaryIDs({1}).empty());
+
+    auto vote = buildVotePayload(12345);
+    message->setPayload(vote);
+    EncodedMessage withoutDictionary;
+    BOOST_CHECK(message->encode(withoutDictionary));
+    BOOST_CHECK(withoutDictionary.payload == vote);
+    checkDecode(withoutDictionary, *vote);
+
+    message->setCompressDictionaryID(dictionary->id());
+    EncodedMessage withDictionary;
+    BOOST_CHECK(message->encode(withDictionary));
+    BOOST_CHECK_LT(withDictionary.payloadSize(), vote->size());
+    BOOST_CHECK_EQUAL(ZstdCompress::dictionaryID(ref(*withDictionary.payload)), dictionary->id());
+    checkDecode(withDictionary, *vote);
+
+    // the unknown dictionary is not used
+    message->setCompressDictionaryID(dictionary->id() + 1);
+    EncodedMessage unknownDictionary;
+    BOOST_CHECK(message->encode(unknownDictionary));
+    BOOST_CHECK(unknownDictionary.payload == vote);
+
+    // the peer without the dictionary can't decode
+    message->setCompressDictionaryID(dictionary->id());
+    BOOST_CHECK(message->encode(withDictionary));
+    policies.setDictionary(nullptr);
+    bytes buffer(withDictionary.header.begin(), withDictionary.header.end());
+    buffer.insert(buffer.end(), withDictionary.payload->begin(), withDictionary.payload->end());
+    auto decodeMsg = std::static_pointer_cast<P2PMessage>(factory->buildMessage());
+    BOOST_CHECK_EQUAL(decodeMsg->decode(ref(buffer)), MessageDecodeStatus::MESSAGE_ERROR);
+}
+
 BOOST_AUTO_TEST_CASE(test_P2PMessage_attr)
 {
     auto attr = std::make_shared<GatewayMessageExtAttributes>();
@@ -23,6 +23,8 @@
 #include "bcos-framework/protocol/Protocol.h"
 #include "bcos-gateway/libratelimit/DistributedRateLimiter.h"
 #include "bcos-gateway/libratelimit/RateLimiterFactory.h"
+#include "bcos-gateway/libratelimit/RateLimiterStat.h"
+#include "bcos-gateway/libratelimit/ShardedTokenBucketRateLimiter.h"
 #include "bcos-gateway/libratelimit/TimeWindowRateLimiter.h"
 #include <bcos-gateway/GatewayConfig.h>
 #include <bcos-gateway/GatewayFactory.h>
@@ -30,9 +32,11 @@
 #include <boost/filesystem.hpp>
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <thread>
+#include <vector>
 
 using namespace bcos;
 using namespace gateway;
@@ -143,6 +147,116 @@ BOOST_AUTO_TEST_CASE(test_timeWindowRateLimiter)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_shardedTokenBucketRateLimiter)
+{
+    int64_t maxPermitsSize = 2000;
+    int64_t timeWindowMS = 1000;
+    {
+        auto rateLimiter = std::make_shared<ratelimiter::ShardedTokenBucketRateLimiter>(
+            maxPermitsSize, timeWindowMS, true);
+        BOOST_CHECK(rateLimiter->tryAcquire(2 * maxPermitsSize));
+        BOOST_CHECK(rateLimiter->acquire(2 * maxPermitsSize));
+        BOOST_CHECK_EQUAL(rateLimiter->availablePermits(), maxPermitsSize);
+    }
+
+    auto rateLimiter = std::make_shared<ratelimiter::ShardedTokenBucketRateLimiter>(
+        maxPermitsSize, timeWindowMS, false);
+    BOOST_CHECK_EQUAL(rateLimiter->timeWindowMS(), timeWindowMS);
+    BOOST_CHECK_EQUAL(rateLimiter->maxPermitsSize(), maxPermitsSize);
+    BOOST_CHECK(!rateLimiter->allowExceedMaxPermitSize());
+    BOOST_CHECK_EQUAL(rateLimiter->availablePermits(), maxPermitsSize);
+    BOOST_CHECK(!rateLimiter->tryAcquire(maxPermitsSize + 1));
+    BOOST_CHECK(!rateLimiter->acquire(maxPermitsSize + 1));
+
+    // the permits cached in the shard are taken first
+    BOOST_CHECK(rateLimiter->tryAcquire(1));
+    BOOST_CHECK_EQUAL(rateLimiter->availablePermits(), maxPermitsSize - 1);
+    int64_t acquired = 1;
+    while (rateLimiter->tryAcquire(1))
+    {
+        acquired++;
+    }
+    // refilled while acquiring at most
+    BOOST_CHECK_GE(acquired, maxPermitsSize);
+    BOOST_CHECK_LE(acquired, maxPermitsSize + maxPermitsSize / 10);
+
+    rateLimiter->rollback(100);
+    BOOST_CHECK(rateLimiter->tryAcquire(100));
+
+    // refilled as time goes by, and never more than the max
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeWindowMS / 2));
+    BOOST_CHECK(rateLimiter->tryAcquire(maxPermitsSize / 4));
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * timeWindowMS));
+    BOOST_CHECK(rateLimiter->acquire(maxPermitsSize));
+    BOOST_CHECK_LE(rateLimiter->availablePermits(), maxPermitsSize / 10);
+    // the rolled back permits never fill the bucket over the max
+    rateLimiter->rollback(2 * maxPermitsSize);
+    BOOST_CHECK_LE(rateLimiter->availablePermits(), maxPermitsSize);
+}
+
+BOOST_AUTO_TEST_CASE(test_shardedTokenBucketRateLimiter_concurrent)
+{
+    int64_t maxPermitsSize = 100000;
+    int64_t timeWindowMS = 1000;
+    auto threadsCount = std::max(std::thread::hardware_concurrency(), 4U);
+    auto rateLimiter = std::make_shared<ratelimiter::ShardedTokenBucketRateLimiter>(
+        maxPermitsSize, timeWindowMS, false);
+
+    std::atomic_int64_t acquired{0};
+    auto startT = utcSteadyTime();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadsCount; i++)
+    {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 20000; j++)
+            {
+                if (rateLimiter->tryAcquire(1))
+                {
+                    acquired++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = utcSteadyTime() - startT;
+    // no more than the max and the refilled ones during the acquiring
+    BOOST_CHECK_GT(acquired, 0);
+    BOOST_CHECK_LE(acquired, maxPermitsSize + maxPermitsSize * (elapsed + 10) / timeWindowMS);
+    BOOST_CHECK_LE(acquired + rateLimiter->availablePermits(),
+        maxPermitsSize + maxPermitsSize * (elapsed + 10) / timeWindowMS);
+}
+
+BOOST_AUTO_TEST_CASE(test_rateLimiterStatMerge)
+{
+    auto threadsCount = std::max(std::thread::hardware_concurrency(), 4U);
+    auto updateCount = 20000;
+    // the packets counted by many threads are merged when reported
+    auto rateLimiterStat = std::make_shared<ratelimiter::RateLimiterStat>();
+    rateLimiterStat->start();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadsCount; i++)
+    {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < updateCount; j++)
+            {
+                rateLimiterStat->updateOutGoing("group0", 1000, 10, true);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto outStat = rateLimiterStat->outStat();
+    auto const& groupStat = outStat[ratelimiter::RateLimiterStat::toGroupKey("group0")];
+    BOOST_CHECK_EQUAL(groupStat.totalTimes, threadsCount * updateCount);
+    BOOST_CHECK_EQUAL(groupStat.totalDataSize, 10 * threadsCount * updateCount);
+    rateLimiterStat->stop();
+}
+
 BOOST_AUTO_TEST_CASE(test_rateLimiterManager)
 {
     auto gatewayFactory = std::make_shared<GatewayFactory>("", "");
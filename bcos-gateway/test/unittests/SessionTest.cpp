@@ -19,10 +19,12 @@
  * @date 2023-02-23
  */
 
+#include <bcos-gateway/libnetwork/BufferPool.h>
 #include <bcos-gateway/libnetwork/Session.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
+#include <thread>
 
 using namespace bcos;
 using namespace gateway;
@@ -157,4 +159,89 @@ BOOST_AUTO_TEST_CASE(SessionRecvBufferTest)
     }
 }
 
+BOOST_AUTO_TEST_CASE(BufferPoolTest)
+{
+    BufferPool pool;
+    auto buffer = pool.acquire(300);
+    BOOST_CHECK(buffer.empty());
+    BOOST_CHECK_EQUAL(buffer.capacity(), 512);
+    buffer.resize(300);
+    auto* data = buffer.data();
+    pool.release(std::move(buffer));
+
+    // the buffer is reused by the size of the same class
+    auto reused = pool.acquire(400);
+    BOOST_CHECK(reused.empty());
+    BOOST_CHECK_EQUAL(reused.data(), data);
+    auto small = pool.acquire(10);
+    BOOST_CHECK_EQUAL(small.capacity(), BufferPool::MIN_BUFFER_SIZE);
+    pool.release(std::move(reused));
+    pool.release(std::move(small));
+    pool.release(bytes(10));
+    auto stat = pool.stat();
+    BOOST_CHECK_EQUAL(stat.allocated, 2);
+    BOOST_CHECK_EQUAL(stat.reused, 1);
+    BOOST_CHECK_EQUAL(stat.released, 3);
+    BOOST_CHECK_EQUAL(stat.dropped, 0);
+
+    // too large to keep
+    bytes large;
+    large.reserve(BufferPool::MIN_BUFFER_SIZE << BufferPool::CLASSES_COUNT);
+    pool.release(std::move(large));
+    BOOST_CHECK_EQUAL(pool.stat().dropped, 1);
+
+    // the shared copy is back to the pool with the last reference
+    bytes payload(1000, 'a');
+    auto shared = pool.copyShared(ref(payload));
+    BOOST_CHECK(*shared == payload);
+    auto copy = shared;
+    shared.reset();
+    BOOST_CHECK_EQUAL(pool.stat().released, 3);
+    copy.reset();
+    BOOST_CHECK_EQUAL(pool.stat().released, 4);
+    BOOST_CHECK_EQUAL(pool.acquire(1024).capacity(), 1024);
+    BOOST_CHECK_EQUAL(pool.stat().reused, 2);
+
+    // the large classes keep fewer buffers
+    BOOST_CHECK_EQUAL(BufferPool::maxFreeBuffers(0), BufferPool::MAX_FREE_BUFFERS);
+    BOOST_CHECK_EQUAL(BufferPool::maxFreeBuffers(BufferPool::CLASSES_COUNT - 1), 1);
+    auto dropped = pool.stat().dropped;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        bytes buffer;
+        buffer.reserve(BufferPool::MIN_BUFFER_SIZE << (BufferPool::CLASSES_COUNT - 1));
+        pool.release(std::move(buffer));
+    }
+    BOOST_CHECK_EQUAL(pool.stat().dropped, dropped + 1);
+
+    // the buffer released by another thread is reused
+    bytes released;
+    released.reserve(BufferPool::MIN_BUFFER_SIZE << 2);
+    auto* releasedData = released.data();
+    std::thread([&pool, &released]() { pool.release(std::move(released)); }).join();
+    BOOST_CHECK_EQUAL(pool.acquire(BufferPool::MIN_BUFFER_SIZE << 2).data(), releasedData);
+}
+
+BOOST_AUTO_TEST_CASE(EncodedMessageMoveTest)
+{
+    auto released = BufferPool::instance().stat().released;
+    EncodedMessage message;
+    message.header = BufferPool::instance().acquire(100);
+    message.header.resize(100);
+    auto* data = message.header.data();
+    message.payload = std::make_shared<bytes>(10, 'a');
+
+    EncodedMessage moved(std::move(message));
+    BOOST_CHECK_EQUAL(moved.header.data(), data);
+    BOOST_CHECK_EQUAL(moved.dataSize(), 110);
+    BOOST_CHECK_EQUAL(message.dataSize(), 0);
+
+    // the replaced header is back to the pool
+    EncodedMessage assigned;
+    assigned.header = BufferPool::instance().acquire(100);
+    assigned = std::move(moved);
+    BOOST_CHECK_EQUAL(assigned.header.data(), data);
+    BOOST_CHECK_EQUAL(BufferPool::instance().stat().released, released + 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,8 @@
 #include <bcos-framework/protocol/Protocol.h>
 #include <bcos-utilities/ThreadPool.h>
 #include <boost/bind/bind.hpp>
+#include <algorithm>
+#include <thread>
 #include <unistd.h>
 #include "../libloki/FuzzEngine.h"
 #include <utility>
@@ -54,6 +56,8 @@ PBFTEngine::PBFTEngine(PBFTConfig::Ptr _config)
   : ConsensusEngine("pbft", 0),
     m_config(_config),
     m_worker(std::make_shared<ThreadPool>("pbftWorker", 1)),
+    m_verifyWorker(std::make_shared<ThreadPool>(
+        "pbftVerifier", std::clamp(std::thread::hardware_concurrency() / 2, 1U, 8U))),
     m_msgQueue(std::make_shared<PBFTMsgQueue>())
 {
     auto cacheFactory = std::make_shared<PBFTCacheFactory>();
@@ -189,6 +193,10 @@ void PBFTEngine::stop()
     {
         m_worker->stop();
     }
+    if (m_verifyWorker)
+    {
+        m_verifyWorker->stop();
+    }
     if (m_logSync)
     {
         m_logSync->stop();
@@ -564,8 +572,7 @@ void PBFTEngine::onReceivePBFTMessage(Error::Ptr _error, NodeIDPtr _fromNode, by
             });
             return;
         }
-        m_msgQueue->push(pbftMsg);
-        m_signalled.notify_all();
+        preVerifyAndPush(pbftMsg);
     }
     catch (std::exception const& _e)
     {
@@ -577,6 +584,44 @@ void PBFTEngine::onReceivePBFTMessage(Error::Ptr _error, NodeIDPtr _fromNode, by
     }
 }
 
+void PBFTEngine::preVerifyAndPush(PBFTBaseMessageInterface::Ptr _msg)
+{
+    auto nodeInfo = m_config->getConsensusNodeByIndex(_msg->generatedFrom());
+    if (!nodeInfo)
+    {
+        // rejected by the worker in checkSignature
+        m_msgQueue->push(_msg);
+        m_signalled.notify_all();
+        return;
+    }
+    // Note: the messages may be pushed out of order, the same as the messages re-pushed by the
+    // worker, the worker re-verifies the messages failed here with the latest consensus list
+    m_pendingVerifications++;
+    auto self = weak_from_this();
+    m_verifyWorker->enqueue([self, _msg, publicKey = nodeInfo->nodeID()]() {
+        auto pbftEngine = self.lock();
+        if (!pbftEngine)
+        {
+            return;
+        }
+        try
+        {
+            if (_msg->verifySignature(pbftEngine->m_config->cryptoSuite(), publicKey))
+            {
+                _msg->setVerifiedSigner(publicKey);
+            }
+        }
+        catch (std::exception const& e)
+        {
+            PBFT_LOG(WARNING) << LOG_DESC("preVerifyAndPush exception") << printPBFTMsgInfo(_msg)
+                              << LOG_KV("error", boost::diagnostic_information(e));
+        }
+        pbftEngine->m_msgQueue->push(_msg);
+        pbftEngine->m_pendingVerifications--;
+        pbftEngine->m_signalled.notify_all();
+    });
+}
+
 void PBFTEngine::clearAllCache()
 {
     RecursiveGuard l(m_mutex);
@@ -781,6 +826,12 @@ CheckResult PBFTEngine::checkSignature(PBFTBaseMessageInterface::Ptr _req)
         return CheckResult::INVALID;
     }
     auto publicKey = nodeInfo->nodeID();
+    // verified before pushed into the msgQueue
+    auto verifiedSigner = _req->verifiedSigner();
+    if (verifiedSigner && verifiedSigner->data() == publicKey->data())
+    {
+        return CheckResult::VALID;
+    }
     if (!_req->verifySignature(m_config->cryptoSuite(), publicKey))
     {
         PBFT_LOG(WARNING) << LOG_DESC("checkSignature failed for invalid signature")
@@ -96,6 +96,8 @@ public:
 
     void clearAllCache();
     void recoverState();
+    // the received messages being verified, not pushed into the msgQueue yet
+    size_t pendingVerifications() const { return m_pendingVerifications.load(); }
 
     void fetchAndUpdateLedgerConfig();
     void setLedgerFetcher(bcos::tool::LedgerConfigFetcher::Ptr _ledgerFetcher)
@@ -112,6 +114,10 @@ protected:
     virtual void onRecvProposal(bool _containSysTxs, bytesConstRef _proposalData,
         bcos::protocol::BlockNumber _proposalIndex, bcos::crypto::HashType const& _proposalHash);
 
+    // verify the signature of the received message with m_verifyWorker, then push it into the
+    // msgQueue, so that the worker can skip the verification
+    virtual void preVerifyAndPush(std::shared_ptr<PBFTBaseMessageInterface> _msg);
+
     // PBFT main processing function
     void executeWorker() override;
 
@@ -217,6 +223,9 @@ protected:
     // such as consensus node list, consensus weight, etc.
     std::shared_ptr<PBFTConfig> m_config;
     ThreadPool::Ptr m_worker;
+    // verify the signatures of the received messages in parallel
+    ThreadPool::Ptr m_verifyWorker;
+    std::atomic<size_t> m_pendingVerifications = {0};
 
     // PBFT message cache queue
     PBFTMsgQueuePtr m_msgQueue;
@@ -65,6 +65,9 @@ public:
     virtual void setSignatureDataHash(bcos::crypto::HashType const& _hash) = 0;
     virtual bool verifySignature(
         bcos::crypto::CryptoSuite::Ptr _cryptoSuite, bcos::crypto::PublicPtr _pubKey) = 0;
+    // the key the current signature has been verified with, nullptr if not verified or re-signed
+    virtual bcos::crypto::PublicPtr verifiedSigner() = 0;
+    virtual void setVerifiedSigner(bcos::crypto::PublicPtr _signer) = 0;
 
     virtual void setFrom(bcos::crypto::PublicPtr _from) = 0;
     virtual bcos::crypto::PublicPtr from() const = 0;
@@ -22,6 +22,7 @@
 #include "bcos-pbft/pbft/interfaces/PBFTBaseMessageInterface.h"
 #include "bcos-pbft/pbft/protocol/proto/PBFT.pb.h"
 #include <bcos-protocol/Common.h>
+#include <algorithm>
 namespace bcos
 {
 namespace consensus
@@ -105,6 +106,23 @@ public:
     {
         return _cryptoSuite->signatureImpl()->verify(_pubKey, signatureDataHash(), signatureData());
     }
+    bcos::crypto::PublicPtr verifiedSigner() override
+    {
+        auto signature = signatureData();
+        if (!m_verifiedSigner || m_verifiedSignatureHash != signatureDataHash() ||
+            !std::equal(signature.begin(), signature.end(), m_verifiedSignature.begin(),
+                m_verifiedSignature.end()))
+        {
+            return nullptr;
+        }
+        return m_verifiedSigner;
+    }
+    void setVerifiedSigner(bcos::crypto::PublicPtr _signer) override
+    {
+        m_verifiedSigner = std::move(_signer);
+        m_verifiedSignatureHash = signatureDataHash();
+        m_verifiedSignature = signatureData().toBytes();
+    }
 
     int64_t index() const override { return m_baseMessage->index(); }
     void setIndex(int64_t _index) override { m_baseMessage->set_index(_index); }
@@ -148,6 +166,11 @@ protected:
     bytesPointer m_signatureData;
 
     bcos::crypto::PublicPtr m_from;
+
+    // the signature verified before the message handled
+    bcos::crypto::PublicPtr m_verifiedSigner;
+    bcos::crypto::HashType m_verifiedSignatureHash;
+    bytes m_verifiedSignature;
 };
 }  // namespace consensus
 }  // namespace bcos
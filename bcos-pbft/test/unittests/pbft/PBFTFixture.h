@@ -147,6 +147,11 @@ public:
         bytesConstRef _data, std::function<void(bytesConstRef _respData)> _sendResponse) override
     {
         PBFTEngine::onReceivePBFTMessage(_error, _nodeID, _data, _sendResponse);
+        // wait for the message verified and pushed into the msgQueue
+        while (pendingVerifications() > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
     }
 
     // PBFT main processing function
@@ -391,11 +391,16 @@ inline void testPBFTMessage(PacketType _packetType, CryptoSuite::Ptr _cryptoSuit
     checkFakedBasePBFTMessage(decodedMsg, orgTimestamp, version, view, generatedFrom, proposalHash);
     // verify the signature
     BOOST_CHECK(decodedMsg->verifySignature(_cryptoSuite, keyPair->publicKey()) == true);
+    BOOST_CHECK(decodedMsg->verifiedSigner() == nullptr);
+    decodedMsg->setVerifiedSigner(keyPair->publicKey());
+    BOOST_CHECK(decodedMsg->verifiedSigner() == keyPair->publicKey());
     // case: another node fake the decodedMsg with error view
     KeyPairInterface::Ptr keyPair2 = _cryptoSuite->signatureImpl()->generateKeyPair();
     auto pbftCodec2 = std::make_shared<PBFTCodec>(keyPair2, _cryptoSuite, pbftMessageFactory);
     decodedMsg->setView(view + 1);
     encodedData = pbftCodec2->encode(decodedMsg, 1);
+    // re-signed
+    BOOST_CHECK(decodedMsg->verifiedSigner() == nullptr);
     auto decodedMsg2 =
         std::dynamic_pointer_cast<PBFTMessage>(pbftCodec2->decode(ref(*encodedData)));
     BOOST_CHECK(decodedMsg2->verifySignature(_cryptoSuite, keyPair->publicKey()) == false);
@@ -442,11 +447,15 @@ inline void testPBFTViewChangeMessage(CryptoSuite::Ptr _cryptoSuite)
         proposalHash, index, data, committedIndex, committedHash, proposalSize, _cryptoSuite);
     // verify the signature
     BOOST_CHECK(decodedMsg->verifySignature(_cryptoSuite, keyPair->publicKey()) == true);
+    decodedMsg->setVerifiedSigner(keyPair->publicKey());
+    BOOST_CHECK(decodedMsg->verifiedSigner() == keyPair->publicKey());
     // case: another node fake the decodedMsg with error view
     KeyPairInterface::Ptr keyPair2 = _cryptoSuite->signatureImpl()->generateKeyPair();
     auto pbftCodec2 = std::make_shared<PBFTCodec>(keyPair2, _cryptoSuite, pbftMessageFactory);
     decodedMsg->setView(view - 100);
     encodedData = pbftCodec2->encode(decodedMsg, 1);
+    // re-signed
+    BOOST_CHECK(decodedMsg->verifiedSigner() == nullptr);
     auto decodedMsg2 =
         std::dynamic_pointer_cast<PBFTViewChangeMsg>(pbftCodec2->decode(ref(*encodedData)));
     BOOST_CHECK(decodedMsg2->verifySignature(_cryptoSuite, keyPair->publicKey()) == false);
@@ -0,0 +1,402 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief map the tables to rocksdb column families with their own options
+ * @file RocksDBColumnFamilies.h
+ */
+
+#pragma once
+
+#include <bcos-framework/ledger/LedgerTypeDef.h>
+#include <rocksdb/cache.h>
+#include <rocksdb/convenience.h>
+#include <rocksdb/db.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/table.h>
+#include <rocksdb/write_batch.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace bcos::storage
+{
+
+// The db key is table + ':' + key, the tables are grouped by their access pattern
+enum class ColumnFamily : uint8_t
+{
+    DEFAULT,  // System tables and anything unknown
+    STATE,    // Contract storage, "/apps/" and "/tables/"
+    CODE,     // Contract code and abi, large and rarely updated values
+    LEDGER,   // Blocks, transactions and receipts, append only
+    COUNT
+};
+constexpr static std::array<std::string_view, static_cast<size_t>(ColumnFamily::COUNT)>
+    COLUMN_FAMILY_NAMES{"default", "state", "code", "ledger"};
+
+inline ColumnFamily tableColumnFamily(std::string_view table)
+{
+    if (table.starts_with("/apps/") || table.starts_with("/tables/"))
+    {
+        return ColumnFamily::STATE;
+    }
+    if (table == ledger::SYS_CODE_BINARY || table == ledger::SYS_CONTRACT_ABI)
+    {
+        return ColumnFamily::CODE;
+    }
+    if (table == ledger::SYS_HASH_2_NUMBER || table == ledger::SYS_NUMBER_2_HASH ||
+        table == ledger::SYS_NUMBER_2_BLOCK_HEADER || table == ledger::SYS_NUMBER_2_TXS ||
+        table == ledger::SYS_HASH_2_TX || table == ledger::SYS_HASH_2_RECEIPT ||
+        table == ledger::SYS_BLOCK_NUMBER_2_NONCES)
+    {
+        return ColumnFamily::LEDGER;
+    }
+    return ColumnFamily::DEFAULT;
+}
+
+inline ColumnFamily dbKeyColumnFamily(std::string_view dbKey)
+{
+    return tableColumnFamily(dbKey.substr(0, dbKey.find(':')));
+}
+
+// The prefix of a db key is its table part with the ':', the length follows the key format, e.g.
+// "/apps/" + 20 bytes address of the new executor or "/apps/" + 40 hex address of the legacy one.
+// The keys without ':' are out of the domain and never filtered
+class TablePrefixTransform : public rocksdb::SliceTransform
+{
+public:
+    const char* Name() const override { return "bcos.TablePrefixTransform"; }
+    rocksdb::Slice Transform(const rocksdb::Slice& key) const override
+    {
+        return {key.data(), std::string_view(key.data(), key.size()).find(':') + 1};
+    }
+    bool InDomain(const rocksdb::Slice& key) const override
+    {
+        return std::string_view(key.data(), key.size()).find(':') != std::string_view::npos;
+    }
+};
+
+struct ColumnFamilyOption
+{
+    size_t stateBlockCacheSize = 128 << 20;  // 128MB
+    size_t codeBlockCacheSize = 32 << 20;    // 32MB
+    size_t ledgerBlockCacheSize = 32 << 20;  // 32MB
+    // Prefix bloom on the table part of the state keys, see TablePrefixTransform
+    bool enableStatePrefixBloom = true;
+    bool enableCodeBlobFiles = true;
+    size_t minBlobSize = 1024;
+};
+
+// Handles of the opened column families, indexed by ColumnFamily. The handles are destroyed with
+// destroy() before the db closed
+class RocksDBColumnFamilies
+{
+public:
+    using Ptr = std::shared_ptr<RocksDBColumnFamilies>;
+
+    // The descriptors to open the db with, in the order of ColumnFamily
+    static std::vector<rocksdb::ColumnFamilyDescriptor> descriptors(
+        rocksdb::ColumnFamilyOptions const& base, rocksdb::BlockBasedTableOptions const& baseTable,
+        ColumnFamilyOption const& option)
+    {
+        std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+        descriptors.reserve(COLUMN_FAMILY_NAMES.size());
+        descriptors.emplace_back(std::string(COLUMN_FAMILY_NAMES[0]), base);
+
+        auto tableFactory = [&](size_t blockCacheSize) {
+            auto tableOptions = baseTable;
+            tableOptions.block_cache = rocksdb::NewLRUCache(blockCacheSize);
+            return std::shared_ptr<rocksdb::TableFactory>(
+                rocksdb::NewBlockBasedTableFactory(tableOptions));
+        };
+
+        auto state = base;
+        state.table_factory = tableFactory(option.stateBlockCacheSize);
+        if (option.enableStatePrefixBloom)
+        {
+            // Keys of a contract share the prefix, the seek of a table checks the prefix bloom
+            // only, point lookups still use the whole key filter. The scans across tables must
+            // set total_order_seek
+            state.prefix_extractor = std::make_shared<TablePrefixTransform>();
+            state.memtable_prefix_bloom_size_ratio = 0.1;
+        }
+        descriptors.emplace_back(std::string(COLUMN_FAMILY_NAMES[1]), std::move(state));
+
+        auto code = base;
+        code.table_factory = tableFactory(option.codeBlockCacheSize);
+        if (option.enableCodeBlobFiles)
+        {
+            code.enable_blob_files = true;
+            code.min_blob_size = option.minBlobSize;
+            code.blob_compression_type = base.compression;
+        }
+        descriptors.emplace_back(std::string(COLUMN_FAMILY_NAMES[2]), std::move(code));
+
+        auto ledger = base;
+        ledger.table_factory = tableFactory(option.ledgerBlockCacheSize);
+        descriptors.emplace_back(std::string(COLUMN_FAMILY_NAMES[3]), std::move(ledger));
+
+        return descriptors;
+    }
+
+    explicit RocksDBColumnFamilies(std::vector<rocksdb::ColumnFamilyHandle*> handles)
+      : m_handles(std::move(handles))
+    {
+        assert(m_handles.size() == COLUMN_FAMILY_NAMES.size());
+    }
+    RocksDBColumnFamilies(const RocksDBColumnFamilies&) = delete;
+    RocksDBColumnFamilies(RocksDBColumnFamilies&&) = delete;
+    RocksDBColumnFamilies& operator=(const RocksDBColumnFamilies&) = delete;
+    RocksDBColumnFamilies& operator=(RocksDBColumnFamilies&&) = delete;
+    ~RocksDBColumnFamilies() noexcept = default;
+
+    rocksdb::ColumnFamilyHandle* handle(ColumnFamily columnFamily) const
+    {
+        return m_handles[static_cast<size_t>(columnFamily)];
+    }
+    rocksdb::ColumnFamilyHandle* tableHandle(std::string_view table) const
+    {
+        return handle(tableColumnFamily(table));
+    }
+    rocksdb::ColumnFamilyHandle* dbKeyHandle(std::string_view dbKey) const
+    {
+        return handle(dbKeyColumnFamily(dbKey));
+    }
+    std::vector<rocksdb::ColumnFamilyHandle*> const& handles() const { return m_handles; }
+
+    void destroy(rocksdb::DB& db)
+    {
+        for (auto* handle : m_handles)
+        {
+            db.DestroyColumnFamilyHandle(handle);
+        }
+        m_handles.clear();
+    }
+
+private:
+    std::vector<rocksdb::ColumnFamilyHandle*> m_handles;
+};
+
+using RocksDBPtr = std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>;
+
+enum class RocksDBOpenMode : uint8_t
+{
+    PRIMARY,
+    READ_ONLY,
+    SECONDARY,
+};
+
+struct RocksDBOpenOption
+{
+    // create the column families for a new or empty db, a db with data in the default column
+    // family only must be migrated with migrateToColumnFamilies first
+    bool createColumnFamilies = false;
+    rocksdb::BlockBasedTableOptions tableOptions;
+    ColumnFamilyOption columnFamilyOption;
+    RocksDBOpenMode mode = RocksDBOpenMode::PRIMARY;
+    std::string secondaryPath;
+};
+
+// The column families of the db, empty if the db not exists
+inline std::vector<std::string> listColumnFamilies(
+    rocksdb::DBOptions const& options, std::string const& path)
+{
+    std::vector<std::string> names;
+    if (!rocksdb::DB::ListColumnFamilies(options, path, &names).ok())
+    {
+        names.clear();
+    }
+    return names;
+}
+
+inline bool hasColumnFamilies(std::vector<std::string> const& names)
+{
+    return std::all_of(COLUMN_FAMILY_NAMES.begin(), COLUMN_FAMILY_NAMES.end(),
+        [&names](std::string_view name) {
+            return std::find(names.begin(), names.end(), name) != names.end();
+        });
+}
+
+inline bool hasDataInDefaultColumnFamily(rocksdb::Options const& options, std::string const& path)
+{
+    rocksdb::DB* db = nullptr;
+    if (!rocksdb::DB::OpenForReadOnly(options, path, &db).ok())
+    {
+        // treat as not empty, never create the column families over unknown data
+        return true;
+    }
+    std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(rocksdb::ReadOptions()));
+    it->SeekToFirst();
+    auto hasData = it->Valid();
+    it.reset();
+    db->Close();
+    delete db;
+    return hasData;
+}
+
+// Open the db at path, with the column families if the db has them. All the opens of the node db,
+// including the offline tools, should go through this, a db with the column families can not be
+// opened without them. The column families is nullptr if the db is opened without them, the
+// deleter of the db destroys the handles
+inline std::tuple<rocksdb::Status, RocksDBPtr, RocksDBColumnFamilies::Ptr> openRocksDB(
+    rocksdb::Options options, std::string const& path, RocksDBOpenOption const& openOption = {})
+{
+    auto names = listColumnFamilies(options, path);
+    auto withColumnFamilies = hasColumnFamilies(names);
+    if (!withColumnFamilies && openOption.createColumnFamilies &&
+        openOption.mode == RocksDBOpenMode::PRIMARY)
+    {
+        if (!names.empty() && hasDataInDefaultColumnFamily(options, path))
+        {
+            return {rocksdb::Status::InvalidArgument(path,
+                        "the db has data without column families, migrate it with "
+                        "storage-tool --migrate_column_families first, or disable "
+                        "storage.enable_column_families"),
+                nullptr, nullptr};
+        }
+        withColumnFamilies = true;
+        options.create_missing_column_families = true;
+    }
+
+    rocksdb::DB* db = nullptr;
+    rocksdb::Status status;
+    RocksDBColumnFamilies::Ptr columnFamilies;
+    if (withColumnFamilies)
+    {
+        auto descriptors = RocksDBColumnFamilies::descriptors(rocksdb::ColumnFamilyOptions(options),
+            openOption.tableOptions, openOption.columnFamilyOption);
+        std::vector<rocksdb::ColumnFamilyHandle*> handles;
+        switch (openOption.mode)
+        {
+        case RocksDBOpenMode::PRIMARY:
+            status = rocksdb::DB::Open(options, path, descriptors, &handles, &db);
+            break;
+        case RocksDBOpenMode::READ_ONLY:
+            status = rocksdb::DB::OpenForReadOnly(options, path, descriptors, &handles, &db);
+            break;
+        case RocksDBOpenMode::SECONDARY:
+            status = rocksdb::DB::OpenAsSecondary(
+                options, path, openOption.secondaryPath, descriptors, &handles, &db);
+            break;
+        }
+        if (status.ok())
+        {
+            columnFamilies = std::make_shared<RocksDBColumnFamilies>(std::move(handles));
+        }
+    }
+    else
+    {
+        switch (openOption.mode)
+        {
+        case RocksDBOpenMode::PRIMARY:
+            status = rocksdb::DB::Open(options, path, &db);
+            break;
+        case RocksDBOpenMode::READ_ONLY:
+            status = rocksdb::DB::OpenForReadOnly(options, path, &db);
+            break;
+        case RocksDBOpenMode::SECONDARY:
+            status = rocksdb::DB::OpenAsSecondary(options, path, openOption.secondaryPath, &db);
+            break;
+        }
+    }
+    if (!status.ok())
+    {
+        return {status, nullptr, nullptr};
+    }
+    auto primary = openOption.mode == RocksDBOpenMode::PRIMARY;
+    return {status, RocksDBPtr(db, [columnFamilies, primary](rocksdb::DB* db) {
+                        if (primary)
+                        {
+                            rocksdb::CancelAllBackgroundWork(db, true);
+                        }
+                        if (columnFamilies)
+                        {
+                            columnFamilies->destroy(*db);
+                        }
+                        db->Close();
+                        delete db;
+                    }),
+        std::move(columnFamilies)};
+}
+
+// Move the keys of a db created without column families to their column families, offline only
+inline rocksdb::Status migrateToColumnFamilies(rocksdb::Options options, std::string const& path,
+    RocksDBOpenOption const& openOption = {}, size_t batchSize = 10000)
+{
+    if (hasColumnFamilies(listColumnFamilies(options, path)))
+    {
+        return rocksdb::Status::OK();
+    }
+    options.create_if_missing = false;
+    options.create_missing_column_families = true;
+    auto descriptors = RocksDBColumnFamilies::descriptors(rocksdb::ColumnFamilyOptions(options),
+        openOption.tableOptions, openOption.columnFamilyOption);
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    rocksdb::DB* db = nullptr;
+    auto status = rocksdb::DB::Open(options, path, descriptors, &handles, &db);
+    if (!status.ok())
+    {
+        return status;
+    }
+    RocksDBColumnFamilies columnFamilies(std::move(handles));
+    auto* defaultHandle = columnFamilies.handle(ColumnFamily::DEFAULT);
+    {
+        std::unique_ptr<rocksdb::Iterator> it(
+            db->NewIterator(rocksdb::ReadOptions(), defaultHandle));
+        rocksdb::WriteBatch batch;
+        size_t count = 0;
+        for (it->SeekToFirst(); it->Valid() && status.ok(); it->Next())
+        {
+            auto key = it->key();
+            auto columnFamily = dbKeyColumnFamily(std::string_view(key.data(), key.size()));
+            if (columnFamily == ColumnFamily::DEFAULT)
+            {
+                continue;
+            }
+            batch.Put(columnFamilies.handle(columnFamily), key, it->value());
+            batch.Delete(defaultHandle, key);
+            if (++count % batchSize == 0)
+            {
+                status = db->Write(rocksdb::WriteOptions(), &batch);
+                batch.Clear();
+            }
+        }
+        if (status.ok())
+        {
+            status = it->status();
+        }
+        if (status.ok() && batch.Count() > 0)
+        {
+            status = db->Write(rocksdb::WriteOptions(), &batch);
+        }
+    }
+    if (status.ok())
+    {
+        // drop the tombstones of the moved keys
+        status = db->CompactRange(rocksdb::CompactRangeOptions(), defaultHandle, nullptr, nullptr);
+    }
+    columnFamilies.destroy(*db);
+    db->Close();
+    delete db;
+    return status;
+}
+
+}  // namespace bcos::storage
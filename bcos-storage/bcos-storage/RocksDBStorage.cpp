@@ -29,8 +29,9 @@
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/table.h>
-#include <tbb/concurrent_vector.h>
+#include <tbb/enumerable_thread_specific.h>
 #include <boost/algorithm/hex.hpp>
+#include <chrono>
 #include <csignal>
 #include <exception>
 #include <future>
@@ -46,10 +47,20 @@ using namespace std;
 #define STORAGE_ROCKSDB_LOG(LEVEL) BCOS_LOG(LEVEL) << "[STORAGE-RocksDB]"
 
 RocksDBStorage::RocksDBStorage(std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>&& db,
-    const bcos::security::DataEncryptInterface::Ptr dataEncryption)
-  : m_db(std::move(db)), m_dataEncryption(dataEncryption)
+    const bcos::security::DataEncryptInterface::Ptr dataEncryption,
+    RocksDBColumnFamilies::Ptr columnFamilies)
+  : m_db(std::move(db)),
+    m_columnFamilies(std::move(columnFamilies)),
+    m_dataEncryption(dataEncryption)
+{}
+
+rocksdb::ColumnFamilyHandle* RocksDBStorage::columnFamily(std::string_view table) const
 {
-    m_writeBatch = std::make_shared<WriteBatch>();
+    if (m_columnFamilies)
+    {
+        return m_columnFamilies->tableHandle(table);
+    }
+    return m_db->DefaultColumnFamily();
 }
 
 void RocksDBStorage::asyncGetPrimaryKeys(std::string_view _table,
@@ -64,7 +75,8 @@ void RocksDBStorage::asyncGetPrimaryKeys(std::string_view _table,
 
     ReadOptions read_options;
     read_options.total_order_seek = true;
-    auto iter = std::unique_ptr<rocksdb::Iterator>(m_db->NewIterator(read_options));
+    auto iter =
+        std::unique_ptr<rocksdb::Iterator>(m_db->NewIterator(read_options, columnFamily(_table)));
 
     // check performance
     for (iter->Seek(keyPrefix); iter->Valid() && iter->key().starts_with(keyPrefix); iter->Next())
@@ -103,7 +115,7 @@ void RocksDBStorage::asyncGetRow(std::string_view _table, std::string_view _key,
         auto dbKey = toDBKey(_table, _key);
 
         auto status = m_db->Get(
-            ReadOptions(), m_db->DefaultColumnFamily(), Slice(dbKey.data(), dbKey.size()), &value);
+            ReadOptions(), columnFamily(_table), Slice(dbKey.data(), dbKey.size()), &value);
 
         if (!value.empty() && nullptr != m_dataEncryption)
         {
@@ -187,7 +199,7 @@ void RocksDBStorage::asyncGetRows(std::string_view _table,
 
         std::vector<PinnableSlice> values(keys.size());
         std::vector<Status> statusList(keys.size());
-        m_db->MultiGet(ReadOptions(), m_db->DefaultColumnFamily(), slices.size(), slices.data(),
+        m_db->MultiGet(ReadOptions(), columnFamily(_table), slices.size(), slices.data(),
             values.data(), statusList.data());
         tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
             [&](const tbb::blocked_range<size_t>& range) {
@@ -257,7 +269,7 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
             STORAGE_ROCKSDB_LOG(TRACE)
                 << LOG_DESC("asyncSetRow delete") << LOG_KV("table", _table)
                 << LOG_KV("key", boost::algorithm::hex_lower(std::string(_key)));
-            status = m_db->Delete(options, dbKey);
+            status = m_db->Delete(options, columnFamily(_table), dbKey);
         }
         else
         {
@@ -273,7 +285,7 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
                 value = m_dataEncryption->encrypt(value);
             }
 
-            status = m_db->Put(options, dbKey, value);
+            status = m_db->Put(options, columnFamily(_table), dbKey, value);
         }
 
         if (!status.ok())
@@ -296,30 +308,87 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
     }
 }
 
+namespace
+{
+// The rep of a WriteBatch is an 8 bytes sequence, a 4 bytes little endian count and the records.
+// Appending the records of the shards is what WriteBatchInternal::Append does, without replaying
+// every record through the public Put/Delete
+constexpr size_t WRITE_BATCH_HEADER_SIZE = 12;
+constexpr size_t WRITE_BATCH_COUNT_OFFSET = 8;
+
+uint32_t writeBatchCount(std::string_view rep)
+{
+    uint32_t count = 0;
+    for (size_t i = 0; i < sizeof(count); ++i)
+    {
+        auto byte = static_cast<uint8_t>(rep[WRITE_BATCH_COUNT_OFFSET + i]);
+        count |= static_cast<uint32_t>(byte) << (i * 8);
+    }
+    return count;
+}
+
+void setWriteBatchCount(std::string& rep, uint32_t count)
+{
+    for (size_t i = 0; i < sizeof(count); ++i)
+    {
+        rep[WRITE_BATCH_COUNT_OFFSET + i] = static_cast<char>((count >> (i * 8)) & 0xff);
+    }
+}
+
+std::shared_ptr<WriteBatch> mergeWriteBatches(WriteBatch const* base, auto const& shards)
+{
+    std::string rep;
+    size_t size = (base != nullptr) ? base->GetDataSize() : WRITE_BATCH_HEADER_SIZE;
+    for (auto const& shard : shards)
+    {
+        size += shard.GetDataSize() - WRITE_BATCH_HEADER_SIZE;
+    }
+    rep.reserve(size);
+    if (base != nullptr)
+    {
+        rep.append(base->Data());
+    }
+    else
+    {
+        rep.resize(WRITE_BATCH_HEADER_SIZE, 0);
+    }
+
+    auto count = writeBatchCount(rep);
+    for (auto const& shard : shards)
+    {
+        auto const& shardRep = shard.Data();
+        rep.append(shardRep, WRITE_BATCH_HEADER_SIZE, std::string::npos);
+        count += writeBatchCount(shardRep);
+    }
+    setWriteBatchCount(rep, count);
+    return std::make_shared<WriteBatch>(std::move(rep));
+}
+
+uint64_t steadyMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
 void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorageInterface& storage,
     std::function<void(Error::Ptr, uint64_t startTS, const std::string&)> callback)
 {
     __itt_task_begin(ittapi::ITT_DOMAINS::instance().ITT_DOMAIN_STORAGE, __itt_null, __itt_null,
         const_cast<__itt_string_handle*>(ITT_STRING_STORAGE_PREPARE));
-    std::ignore = param;
     try
     {
         STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncPrepare") << LOG_KV("number", param.number);
         auto start = utcSteadyTime();
-        {
-            std::unique_lock lock(m_writeBatchMutex);
-            if (!m_writeBatch)
-            {
-                m_writeBatch = std::make_shared<WriteBatch>();
-            }
-        }
+        auto startMicros = steadyMicros();
         std::atomic_uint64_t putCount{0};
         std::atomic_uint64_t deleteCount{0};
         atomic_bool isTableValid = true;
 
-        tbb::concurrent_vector<std::tuple<Entry::Status, std::string,
-            std::variant<std::monostate, std::string, Entry>>>
-            dataChanges;
+        // Every traverse thread encodes into its own batch, no lock and no intermediate copy of the
+        // entries, the shards are merged once at the end
+        tbb::enumerable_thread_specific<WriteBatch> shards;
         storage.parallelTraverse(true, [&](const std::string_view& table,
                                            const std::string_view& key, Entry const& entry) {
             if (!isValid(table, key))
@@ -328,6 +397,8 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                 return false;
             }
             auto dbKey = toDBKey(table, key);
+            auto* handle = columnFamily(table);
+            auto& shard = shards.local();
 
             if (entry.status() == Entry::DELETED)
             {
@@ -337,8 +408,7 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                                                << LOG_KV("key", toHex(key));
                 }
                 ++deleteCount;
-                dataChanges.emplace_back(
-                    std::tuple{entry.status(), std::move(dbKey), std::monostate{}});
+                shard.Delete(handle, dbKey);
             }
             else
             {
@@ -355,64 +425,43 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                 {
                     std::string encryptValue(value);
                     encryptValue = m_dataEncryption->encrypt(encryptValue);
-                    dataChanges.emplace_back(
-                        std::tuple{entry.status(), std::move(dbKey), std::move(encryptValue)});
+                    shard.Put(handle, dbKey, encryptValue);
                 }
                 else
                 {
-                    dataChanges.emplace_back(std::tuple{entry.status(), std::move(dbKey), entry});
+                    shard.Put(handle, dbKey, Slice(value.data(), value.size()));
                 }
             }
             return true;
         });
         auto encode = utcSteadyTime();
-        for (auto& [status, key, value] : dataChanges)
-        {
-            if (status == Entry::DELETED)
-            {
-                m_writeBatch->Delete(key);
-            }
-            else
-            {
-                auto& localKey = key;
-                std::visit(
-                    [this, &localKey](auto&& valueStr) {
-                        using ValueType = std::decay_t<decltype(valueStr)>;
-                        if constexpr (std::same_as<ValueType, std::string>)
-                        {
-                            m_writeBatch->Put(localKey, valueStr);
-                        }
-                        else if constexpr (std::same_as<ValueType, Entry>)
-                        {
-                            m_writeBatch->Put(localKey, valueStr.get());
-                        }
-                        else
-                        {
-                            STORAGE_ROCKSDB_LOG(FATAL) << "Unexpected monostate!";
-                        }
-                    },
-                    value);
-            }
-        }
 
         if (!isTableValid)
         {
-            {
-                std::unique_lock lock(m_writeBatchMutex);
-                m_writeBatch = nullptr;
-            }
             STORAGE_ROCKSDB_LOG(ERROR)
                 << LOG_DESC("asyncPrepare invalidTable") << LOG_KV("blockNumber", param.number);
             callback(BCOS_ERROR_UNIQUE_PTR(TableNotExists, "empty tableName or key"), 0, "");
             return;
         }
+
+        {
+            // Only the merge is under the lock, a commit writing the batch of the previous block
+            // doesn't hold it
+            std::unique_lock lock(m_writeBatchMutex);
+            auto& writeBatch = m_writeBatches[param.number];
+            writeBatch = mergeWriteBatches(writeBatch.get(), shards);
+        }
         auto end = utcSteadyTime();
+        m_prepareLatency.record(steadyMicros() - startMicros);
         STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncPrepare finished")
                                   << LOG_KV("blockNumber", param.number) << LOG_KV("put", putCount)
                                   << LOG_KV("delete", deleteCount)
+                                  << LOG_KV("shards", shards.size())
                                   << LOG_KV("startTS", param.timestamp)
                                   << LOG_KV("encode(ms)", encode - start)
-                                  << LOG_KV("time(ms)", end - start);
+                                  << LOG_KV("time(ms)", end - start)
+                                  << LOG_KV("p50(us)", m_prepareLatency.percentile(50))
+                                  << LOG_KV("p99(us)", m_prepareLatency.percentile(99));
         callback(nullptr, 0, "");
     }
     catch (const std::exception& e)
@@ -430,15 +479,28 @@ void RocksDBStorage::asyncCommit(
 
     size_t count = 0;
     auto start = utcSteadyTime();
-    std::ignore = params;
+    auto startMicros = steadyMicros();
     {
-        std::unique_lock lock(m_writeBatchMutex);
-        if (m_writeBatch)
+        // Commits are written in the order of the block number, the prepares go on meanwhile
+        std::unique_lock commitLock(m_commitMutex);
+        std::vector<std::tuple<protocol::BlockNumber, std::shared_ptr<WriteBatch>>> writeBatches;
+        {
+            std::unique_lock lock(m_writeBatchMutex);
+            auto end = m_writeBatches.upper_bound(params.number);
+            for (auto it = m_writeBatches.begin(); it != end; ++it)
+            {
+                writeBatches.emplace_back(it->first, std::move(it->second));
+            }
+            m_writeBatches.erase(m_writeBatches.begin(), end);
+        }
+
+        for (auto it = writeBatches.begin(); it != writeBatches.end(); ++it)
         {
+            auto& writeBatch = std::get<1>(*it);
             WriteOptions options;
             // options.sync = true;
-            count = m_writeBatch->Count();
-            auto status = m_db->Write(options, m_writeBatch.get());
+            count += writeBatch->Count();
+            auto status = m_db->Write(options, writeBatch.get());
             auto err = checkStatus(status);
             if (err)
             {
@@ -446,14 +508,22 @@ void RocksDBStorage::asyncCommit(
                     << LOG_DESC("asyncCommit failed") << LOG_KV("blockNumber", params.number)
                     << LOG_KV("message", err->errorMessage()) << LOG_KV("startTS", params.timestamp)
                     << LOG_KV("time(ms)", utcSteadyTime() - start);
-                lock.unlock();
+                {
+                    // Keep the batches not written for the retry
+                    std::unique_lock lock(m_writeBatchMutex);
+                    for (; it != writeBatches.end(); ++it)
+                    {
+                        m_writeBatches.emplace(std::get<0>(*it), std::move(std::get<1>(*it)));
+                    }
+                }
+                commitLock.unlock();
                 callback(err, 0);
                 return;
             }
-            m_writeBatch = nullptr;
         }
     }
     auto end = utcSteadyTime();
+    m_commitLatency.record(steadyMicros() - startMicros);
     __itt_task_end(ittapi::ITT_DOMAINS::instance().ITT_DOMAIN_STORAGE);
     callback(nullptr, 0);
     STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncCommit finished")
@@ -461,7 +531,9 @@ void RocksDBStorage::asyncCommit(
                               << LOG_KV("startTS", params.timestamp)
                               << LOG_KV("time(ms)", end - start)
                               << LOG_KV("callback time(ms)", utcSteadyTime() - end)
-                              << LOG_KV("count", count);
+                              << LOG_KV("count", count)
+                              << LOG_KV("p50(us)", m_commitLatency.percentile(50))
+                              << LOG_KV("p99(us)", m_commitLatency.percentile(99));
     if (enableRocksDBMemoryStatistics)
     {
         auto* tableOptions =
@@ -489,10 +561,10 @@ void RocksDBStorage::asyncRollback(
 
     auto start = utcSteadyTime();
 
-    std::ignore = params;
     {
+        // The blocks prepared after the rolled back one are based on it, drop them too
         std::unique_lock lock(m_writeBatchMutex);
-        m_writeBatch = nullptr;
+        m_writeBatches.erase(m_writeBatches.lower_bound(params.number), m_writeBatches.end());
     }
     auto end = utcSteadyTime();
     __itt_task_end(ittapi::ITT_DOMAINS::instance().ITT_DOMAIN_STORAGE);
@@ -557,6 +629,7 @@ bcos::Error::Ptr RocksDBStorage::setRows(std::string_view table,
                     }
                 });
             auto writeBatch = WriteBatch();
+            auto* handle = columnFamily(table);
             size_t dataSize = 0;
             for (size_t i = 0; i < keys.size(); ++i)
             {
@@ -564,12 +637,12 @@ bcos::Error::Ptr RocksDBStorage::setRows(std::string_view table,
                 if (m_dataEncryption)
                 {
                     dataSize += realKeys[i].size() + encryptedValues[i].size();
-                    writeBatch.Put(realKeys[i], encryptedValues[i]);
+                    writeBatch.Put(handle, realKeys[i], encryptedValues[i]);
                 }
                 else
                 {
                     dataSize += realKeys[i].size() + values[i].size();
-                    writeBatch.Put(std::move(realKeys[i]), std::move(values[i]));
+                    writeBatch.Put(handle, std::move(realKeys[i]), std::move(values[i]));
                 }
             }
             WriteOptions options;
@@ -613,9 +686,10 @@ bcos::Error::Ptr RocksDBStorage::deleteRows(std::string_view table,
                     }
                 });
             auto writeBatch = WriteBatch();
+            auto* handle = columnFamily(table);
             for (size_t i = 0; i < keys.size(); ++i)
             {
-                writeBatch.Delete(realKeys[i]);
+                writeBatch.Delete(handle, realKeys[i]);
             }
             WriteOptions options;
             auto status = m_db->Write(options, &writeBatch);
@@ -23,10 +23,14 @@
  */
 #pragma once
 
+#include "RocksDBColumnFamilies.h"
+#include <bcos-framework/protocol/ProtocolTypeDef.h>
 #include <bcos-framework/storage/StorageInterface.h>
 #include <bcos-security/bcos-security/DataEncryption.h>
+#include <bcos-utilities/LatencyHistogram.h>
 #include <rocksdb/db.h>
 #include <tbb/parallel_for.h>
+#include <map>
 
 namespace rocksdb
 {
@@ -40,7 +44,8 @@ class RocksDBStorage : public TransactionalStorageInterface
 public:
     using Ptr = std::shared_ptr<RocksDBStorage>;
     explicit RocksDBStorage(std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>&& db,
-        const bcos::security::DataEncryptInterface::Ptr dataEncryption);
+        const bcos::security::DataEncryptInterface::Ptr dataEncryption,
+        RocksDBColumnFamilies::Ptr columnFamilies = nullptr);
 
     ~RocksDBStorage() {}
 
@@ -82,14 +87,27 @@ public:
                               const gsl::span<std::string const>>&) noexcept override;
 
     rocksdb::DB& rocksDB() { return *m_db; }
+    // Nullptr if the db is opened without column families
+    RocksDBColumnFamilies const* columnFamilies() const { return m_columnFamilies.get(); }
+    // Microseconds of asyncPrepare and asyncCommit
+    LatencyHistogram const& prepareLatency() const { return m_prepareLatency; }
+    LatencyHistogram const& commitLatency() const { return m_commitLatency; }
 
     void stop() override;
 
 private:
     Error::Ptr checkStatus(rocksdb::Status const& status);
-    std::shared_ptr<rocksdb::WriteBatch> m_writeBatch = nullptr;
+    rocksdb::ColumnFamilyHandle* columnFamily(std::string_view table) const;
+    // The prepared batches by block number, the prepare of a block may go ahead of the commit
+    // of the previous one
+    std::map<protocol::BlockNumber, std::shared_ptr<rocksdb::WriteBatch>> m_writeBatches;
     std::mutex m_writeBatchMutex;
+    std::mutex m_commitMutex;
+    LatencyHistogram m_prepareLatency;
+    LatencyHistogram m_commitLatency;
     std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>> m_db;
+    // The deleter of m_db destroys the handles
+    RocksDBColumnFamilies::Ptr m_columnFamilies;
 
     // Security Storage
     bcos::security::DataEncryptInterface::Ptr m_dataEncryption{nullptr};
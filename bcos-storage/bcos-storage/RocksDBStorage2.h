@@ -1,4 +1,5 @@
 #pragma once
+#include "RocksDBColumnFamilies.h"
 #include "bcos-concepts/Exception.h"
 #include <bcos-concepts/ByteBuffer.h>
 #include <bcos-framework/storage2/Storage.h>
@@ -47,6 +48,18 @@ private:
     ::rocksdb::DB& m_rocksDB;
     [[no_unique_address]] KeyResolver m_keyResolver;
     [[no_unique_address]] ValueResolver m_valueResolver;
+    // Nullptr for the db opened without column families, everything goes to the default one
+    storage::RocksDBColumnFamilies const* m_columnFamilies = nullptr;
+
+    ::rocksdb::ColumnFamilyHandle* columnFamily(auto const& encodedKey)
+    {
+        if (m_columnFamilies != nullptr)
+        {
+            return m_columnFamilies->dbKeyHandle(
+                std::string_view(RANGES::data(encodedKey), RANGES::size(encodedKey)));
+        }
+        return m_rocksDB.DefaultColumnFamily();
+    }
 
 public:
     RocksDBStorage2(::rocksdb::DB& rocksDB) : m_rocksDB(rocksDB) {}
@@ -56,6 +69,13 @@ public:
         m_keyResolver(std::forward<KeyResolver>(keyResolver)),
         m_valueResolver(std::forward<ValueResolver>(valueResolver))
     {}
+    RocksDBStorage2(::rocksdb::DB& rocksDB, KeyResolver&& keyResolver,
+        ValueResolver&& valueResolver, storage::RocksDBColumnFamilies const* columnFamilies)
+      : m_rocksDB(rocksDB),
+        m_keyResolver(std::forward<KeyResolver>(keyResolver)),
+        m_valueResolver(std::forward<ValueResolver>(valueResolver)),
+        m_columnFamilies(columnFamilies)
+    {}
     using Key = KeyType;
     using Value = ValueType;
 
@@ -103,7 +123,7 @@ public:
 
                 auto key = m_keyResolver.encode(keys[0]);
                 auto& status = readIterator.m_status[0];
-                status = m_rocksDB.Get(::rocksdb::ReadOptions(), m_rocksDB.DefaultColumnFamily(),
+                status = m_rocksDB.Get(::rocksdb::ReadOptions(), columnFamily(key),
                     ::rocksdb::Slice(RANGES::data(key), RANGES::size(key)),
                     &readIterator.m_results[0]);
                 if (!status.ok() && !status.IsNotFound())
@@ -127,12 +147,15 @@ public:
             return ::rocksdb::Slice(RANGES::data(encodedKey), RANGES::size(encodedKey));
         }) | RANGES::to<std::vector<::rocksdb::Slice>>();
 
+        auto columnFamilies = encodedKeys | RANGES::views::transform([this](const auto& encodedKey) {
+            return columnFamily(encodedKey);
+        }) | RANGES::to<std::vector<::rocksdb::ColumnFamilyHandle*>>();
+
         readIterator.m_results.resize(RANGES::size(rocksDBKeys));
         readIterator.m_status.resize(RANGES::size(rocksDBKeys));
 
-        m_rocksDB.MultiGet(::rocksdb::ReadOptions(), m_rocksDB.DefaultColumnFamily(),
-            rocksDBKeys.size(), rocksDBKeys.data(), readIterator.m_results.data(),
-            readIterator.m_status.data());
+        m_rocksDB.MultiGet(::rocksdb::ReadOptions(), rocksDBKeys.size(), columnFamilies.data(),
+            rocksDBKeys.data(), readIterator.m_results.data(), readIterator.m_status.data());
         return readIteratorAwaitable;
     }
 
@@ -146,7 +169,8 @@ public:
             auto encodedKey = m_keyResolver.encode(key);
             auto encodedValue = m_valueResolver.encode(value);
 
-            writeBatch.Put(::rocksdb::Slice(RANGES::data(encodedKey), RANGES::size(encodedKey)),
+            writeBatch.Put(columnFamily(encodedKey),
+                ::rocksdb::Slice(RANGES::data(encodedKey), RANGES::size(encodedKey)),
                 ::rocksdb::Slice(RANGES::data(encodedValue), RANGES::size(encodedValue)));
         }
 
@@ -167,7 +191,8 @@ public:
         for (auto const& key : keys)
         {
             auto encodedKey = m_keyResolver.encode(key);
-            writeBatch.Delete(::rocksdb::Slice(RANGES::data(encodedKey), RANGES::size(encodedKey)));
+            writeBatch.Delete(columnFamily(encodedKey),
+                ::rocksdb::Slice(RANGES::data(encodedKey), RANGES::size(encodedKey)));
         }
 
         ::rocksdb::WriteOptions options;
@@ -185,7 +210,9 @@ public:
         friend class RocksDBStorage2;
 
     private:
-        std::unique_ptr<::rocksdb::Iterator> m_rocksDBIterator;
+        // One iterator per column family, walked one after another
+        std::vector<std::unique_ptr<::rocksdb::Iterator>> m_rocksDBIterators;
+        size_t m_current = 0;
         RocksDBStorage2& m_self;
         bool m_started = false;
 
@@ -193,53 +220,77 @@ public:
         using Key = KeyType;
         using Value = ValueType;
 
-        SeekIterator(std::unique_ptr<::rocksdb::Iterator> rocksDBIterator, RocksDBStorage2& self)
-          : m_rocksDBIterator(std::move(rocksDBIterator)), m_self(self)
+        SeekIterator(std::vector<std::unique_ptr<::rocksdb::Iterator>> rocksDBIterators,
+            RocksDBStorage2& self)
+          : m_rocksDBIterators(std::move(rocksDBIterators)), m_self(self)
         {}
 
         task::AwaitableValue<bool> next()
         {
             if (m_started)
             {
-                m_rocksDBIterator->Next();
+                m_rocksDBIterators[m_current]->Next();
             }
             else
             {
                 m_started = true;
             }
-            return {m_rocksDBIterator->Valid()};
+            while (!m_rocksDBIterators[m_current]->Valid() &&
+                   m_current + 1 < m_rocksDBIterators.size())
+            {
+                ++m_current;
+            }
+            return {m_rocksDBIterators[m_current]->Valid()};
         }
         task::AwaitableValue<bool> hasValue() const { return {true}; }
         task::AwaitableValue<Key> key() const
         {
-            auto slice = m_rocksDBIterator->key();
+            auto slice = m_rocksDBIterators[m_current]->key();
             return {m_self.m_keyResolver.decode(slice.ToStringView())};
         }
         task::AwaitableValue<Value> value() const
         {
-            auto slice = m_rocksDBIterator->value();
+            auto slice = m_rocksDBIterators[m_current]->value();
             return {m_self.m_valueResolver.decode(slice.ToStringView())};
         }
     };
 
+    // With column families the keys are ordered within each column family only: seek from the
+    // begin walks all the column families, seek from a key walks the column family of the key
     task::AwaitableValue<SeekIterator> seek(auto const& key) &
     {
-        task::AwaitableValue<SeekIterator> iteratorAwaitable(
-            {std::unique_ptr<::rocksdb::Iterator>(
-                 m_rocksDB.NewIterator(::rocksdb::ReadOptions(), m_rocksDB.DefaultColumnFamily())),
-                *this});
-        auto& iterator = iteratorAwaitable.value();
+        ::rocksdb::ReadOptions readOptions;
+        // The state column family has a prefix extractor, seek across the prefixes
+        readOptions.total_order_seek = true;
+
+        std::vector<std::unique_ptr<::rocksdb::Iterator>> rocksDBIterators;
         if constexpr (std::is_same_v<storage2::STORAGE_BEGIN_TYPE,
                           std::remove_cvref_t<decltype(key)>>)
         {
-            iterator.m_rocksDBIterator->SeekToFirst();
+            if (m_columnFamilies != nullptr)
+            {
+                for (auto* handle : m_columnFamilies->handles())
+                {
+                    rocksDBIterators.emplace_back(m_rocksDB.NewIterator(readOptions, handle));
+                }
+            }
+            else
+            {
+                rocksDBIterators.emplace_back(
+                    m_rocksDB.NewIterator(readOptions, m_rocksDB.DefaultColumnFamily()));
+            }
+            for (auto& rocksDBIterator : rocksDBIterators)
+            {
+                rocksDBIterator->SeekToFirst();
+            }
         }
         else
         {
-            iterator.m_rocksDBIterator->Seek(
-                ::rocksdb::Slice(RANGES::data(key), RANGES::size(key)));
+            auto& rocksDBIterator = rocksDBIterators.emplace_back(
+                m_rocksDB.NewIterator(readOptions, columnFamily(key)));
+            rocksDBIterator->Seek(::rocksdb::Slice(RANGES::data(key), RANGES::size(key)));
         }
-        return iteratorAwaitable;
+        return {SeekIterator{std::move(rocksDBIterators), *this}};
     }
 
     auto refToPointer(auto&& value)
@@ -354,14 +405,15 @@ public:
                                 else if constexpr (std::is_same_v<KeyValueBuffer, ItemType>)
                                 {
                                     auto& [keyBuffer, valueBuffer] = item;
-                                    writeBatch.Put(::rocksdb::Slice(RANGES::data(keyBuffer),
-                                                       RANGES::size(keyBuffer)),
+                                    writeBatch.Put(columnFamily(keyBuffer),
+                                        ::rocksdb::Slice(
+                                            RANGES::data(keyBuffer), RANGES::size(keyBuffer)),
                                         ::rocksdb::Slice(
                                             RANGES::data(valueBuffer), RANGES::size(valueBuffer)));
                                 }
                                 else if constexpr (std::is_same_v<DeleteKeyBuffer, ItemType>)
                                 {
-                                    writeBatch.Delete(
+                                    writeBatch.Delete(columnFamily(item),
                                         ::rocksdb::Slice(RANGES::data(item), RANGES::size(item)));
                                 }
                                 else
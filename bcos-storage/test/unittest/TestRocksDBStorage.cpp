@@ -692,6 +692,67 @@ BOOST_AUTO_TEST_CASE(commitAndCheck)
             params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
     }
 }
+
+BOOST_AUTO_TEST_CASE(pipelinedCommit)
+{
+    auto makeState = [this](std::string_view key, std::string_view value) {
+        auto state = std::make_shared<StateStorage>(rocksDBStorage);
+        Entry entry;
+        entry.importFields({std::string(value)});
+        state->asyncSetRow(testTableName, key, std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+        return state;
+    };
+    auto getValue = [this](std::string_view key) {
+        std::optional<std::string> value;
+        rocksDBStorage->asyncGetRow(
+            testTableName, key, [&value](Error::UniquePtr error, std::optional<Entry> entry) {
+                BOOST_CHECK(!error);
+                if (entry)
+                {
+                    value.emplace(entry->getField(0));
+                }
+            });
+        return value;
+    };
+    auto prepare = [this](protocol::BlockNumber number, StateStorage& state) {
+        bcos::protocol::TwoPCParams params;
+        params.number = number;
+        rocksDBStorage->asyncPrepare(params, state,
+            [](Error::Ptr error, uint64_t, const std::string&) { BOOST_CHECK(!error); });
+    };
+    auto commit = [this](protocol::BlockNumber number) {
+        bcos::protocol::TwoPCParams params;
+        params.number = number;
+        rocksDBStorage->asyncCommit(
+            params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    };
+
+    // Block 11 prepared before block 10 committed, prepare of the same block twice is merged
+    prepare(10, *makeState("pipeline_key1", "v10"));
+    prepare(10, *makeState("pipeline_key2", "v10"));
+    prepare(11, *makeState("pipeline_key1", "v11"));
+    BOOST_CHECK(!getValue("pipeline_key1"));
+
+    commit(10);
+    BOOST_CHECK_EQUAL(getValue("pipeline_key1").value_or(""), "v10");
+    BOOST_CHECK_EQUAL(getValue("pipeline_key2").value_or(""), "v10");
+
+    commit(11);
+    BOOST_CHECK_EQUAL(getValue("pipeline_key1").value_or(""), "v11");
+
+    // Rollback drops the batch of the block and the ones after it
+    prepare(12, *makeState("pipeline_key3", "v12"));
+    prepare(13, *makeState("pipeline_key3", "v13"));
+    bcos::protocol::TwoPCParams params;
+    params.number = 12;
+    rocksDBStorage->asyncRollback(params, [](Error::Ptr error) { BOOST_CHECK(!error); });
+    commit(13);
+    BOOST_CHECK(!getValue("pipeline_key3"));
+
+    BOOST_CHECK_GE(rocksDBStorage->prepareLatency().count(), 5);
+    BOOST_CHECK_GE(rocksDBStorage->commitLatency().count(), 3);
+}
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace bcos::test
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <bcos-framework/storage/Entry.h>
 #include <bcos-framework/storage2/StringPool.h>
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
+#include <bcos-storage/RocksDBColumnFamilies.h>
 #include <bcos-storage/RocksDBStorage2.h>
 #include <bcos-storage/StateKVResolver.h>
 #include <fmt/format.h>
@@ -205,4 +206,176 @@ BOOST_AUTO_TEST_CASE(merge)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(columnFamilies)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        constexpr static std::string_view path = "./rocksdbtestdb_cf";
+        ::rocksdb::Options options;
+        options.create_if_missing = true;
+        options.create_missing_column_families = true;
+        storage::ColumnFamilyOption columnFamilyOption;
+        columnFamilyOption.minBlobSize = 16;
+        auto descriptors = storage::RocksDBColumnFamilies::descriptors(
+            ::rocksdb::ColumnFamilyOptions(options), ::rocksdb::BlockBasedTableOptions{},
+            columnFamilyOption);
+        std::vector<::rocksdb::ColumnFamilyHandle*> handles;
+        ::rocksdb::DB* db = nullptr;
+        auto status = ::rocksdb::DB::Open(
+            ::rocksdb::DBOptions(options), std::string(path), descriptors, &handles, &db);
+        BOOST_REQUIRE(status.ok());
+        std::unique_ptr<::rocksdb::DB> cfRocksDB(db);
+        storage::RocksDBColumnFamilies columnFamilies(std::move(handles));
+
+        RocksDBStorage2<StateKey, StateValue, StateKeyResolver,
+            bcos::storage2::rocksdb::StateValueResolver>
+            rocksDB(
+                *cfRocksDB, StateKeyResolver(stringPool), StateValueResolver{}, &columnFamilies);
+
+        std::vector<std::string_view> tables{
+            "/apps/contract", ledger::SYS_CODE_BINARY, ledger::SYS_HASH_2_TX, ledger::SYS_CONFIG};
+        auto keys = RANGES::views::iota(0, 100) | RANGES::views::transform([&](int num) {
+            return StateKey{
+                storage2::string_pool::makeStringID(stringPool, tables[num % tables.size()]),
+                fmt::format("Key~{}", num)};
+        });
+        auto values = RANGES::views::iota(0, 100) | RANGES::views::transform([](int num) {
+            storage::Entry entry;
+            entry.set(fmt::format("Entry value is: i am a value!!!!!!! {}", num));
+            return entry;
+        });
+        co_await rocksDB.write(keys, values);
+
+        // Read back with the storage, single key and multi keys
+        auto value = co_await storage2::readOne(rocksDB, keys[1]);
+        BOOST_REQUIRE(value);
+        BOOST_CHECK_EQUAL(value->get(), "Entry value is: i am a value!!!!!!! 1");
+        auto it = co_await rocksDB.read(keys);
+        int i = 0;
+        while (co_await it.next())
+        {
+            BOOST_REQUIRE(co_await it.hasValue());
+            BOOST_CHECK_EQUAL((co_await it.value()).get(),
+                fmt::format("Entry value is: i am a value!!!!!!! {}", i));
+            ++i;
+        }
+        BOOST_CHECK_EQUAL(i, 100);
+
+        // Each table is in its column family only
+        auto expected = std::array{storage::ColumnFamily::STATE, storage::ColumnFamily::CODE,
+            storage::ColumnFamily::LEDGER, storage::ColumnFamily::DEFAULT};
+        for (size_t index = 0; index < tables.size(); ++index)
+        {
+            BOOST_CHECK(storage::tableColumnFamily(tables[index]) == expected[index]);
+            auto dbKey = fmt::format("{}:Key~{}", tables[index], index);
+            for (auto columnFamily : expected)
+            {
+                std::string dbValue;
+                auto getStatus = cfRocksDB->Get(
+                    ::rocksdb::ReadOptions(), columnFamilies.handle(columnFamily), dbKey, &dbValue);
+                BOOST_CHECK_EQUAL(getStatus.ok(), columnFamily == expected[index]);
+            }
+        }
+
+        // Seek from a key walks its column family, seek from the begin walks all of them
+        auto seekIt = co_await rocksDB.seek(std::string_view("/apps/contract:"));
+        i = 0;
+        while (co_await seekIt.next())
+        {
+            auto key = co_await seekIt.key();
+            BOOST_CHECK_EQUAL(*std::get<0>(key), "/apps/contract");
+            ++i;
+        }
+        BOOST_CHECK_EQUAL(i, 25);
+
+        // The state prefix is the table part of both the raw and the hex address formats
+        storage::TablePrefixTransform prefixTransform;
+        auto hexKey = std::string("/apps/") + std::string(40, 'a') + ":key";
+        BOOST_CHECK_EQUAL(prefixTransform.Transform(hexKey).ToString(), hexKey.substr(0, 47));
+        BOOST_CHECK_EQUAL(
+            prefixTransform.Transform(std::string_view("/apps/contract:Key~0")).ToString(),
+            "/apps/contract:");
+        BOOST_CHECK(!prefixTransform.InDomain(std::string_view("/tables/t1")));
+
+        co_await rocksDB.remove(RANGES::views::take(keys, 10));
+        auto beginIt = co_await rocksDB.seek(storage2::STORAGE_BEGIN);
+        i = 0;
+        while (co_await beginIt.next())
+        {
+            ++i;
+        }
+        BOOST_CHECK_EQUAL(i, 90);
+
+        columnFamilies.destroy(*cfRocksDB);
+        cfRocksDB.reset();
+        boost::filesystem::remove_all(std::string(path));
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(openAndMigrateColumnFamilies)
+{
+    std::string path = "./rocksdbtestdb_migrate";
+    boost::filesystem::remove_all(path);
+    ::rocksdb::Options options;
+    options.create_if_missing = true;
+    storage::RocksDBOpenOption openOption;
+    openOption.createColumnFamilies = true;
+
+    // A db with data but without the column families is never opened with empty ones
+    {
+        auto [status, db, columnFamilies] = storage::openRocksDB(options, path);
+        BOOST_REQUIRE(status.ok());
+        BOOST_CHECK(!columnFamilies);
+        BOOST_CHECK(db->Put(::rocksdb::WriteOptions(), "/apps/contract:key", "state").ok());
+        BOOST_CHECK(db->Put(::rocksdb::WriteOptions(), "s_hash_2_tx:key", "ledger").ok());
+        BOOST_CHECK(db->Put(::rocksdb::WriteOptions(), "s_config:key", "config").ok());
+    }
+    {
+        auto [status, db, columnFamilies] = storage::openRocksDB(options, path, openOption);
+        BOOST_CHECK(status.IsInvalidArgument());
+        BOOST_CHECK(!db);
+    }
+
+    BOOST_REQUIRE(storage::migrateToColumnFamilies(options, path).ok());
+    BOOST_CHECK(storage::hasColumnFamilies(storage::listColumnFamilies(options, path)));
+
+    // Opened with the column families even if not asked for, the keys are in their families
+    for (auto mode : {storage::RocksDBOpenMode::PRIMARY, storage::RocksDBOpenMode::READ_ONLY})
+    {
+        storage::RocksDBOpenOption readOption;
+        readOption.mode = mode;
+        auto [status, db, columnFamilies] = storage::openRocksDB(options, path, readOption);
+        BOOST_REQUIRE(status.ok());
+        BOOST_REQUIRE(columnFamilies);
+        for (auto [key, value] : std::array<std::pair<std::string_view, std::string_view>, 3>{
+                 {{"/apps/contract:key", "state"}, {"s_hash_2_tx:key", "ledger"},
+                     {"s_config:key", "config"}}})
+        {
+            std::string dbValue;
+            BOOST_CHECK(db->Get(::rocksdb::ReadOptions(), columnFamilies->dbKeyHandle(key),
+                              std::string(key), &dbValue)
+                            .ok());
+            BOOST_CHECK_EQUAL(dbValue, value);
+            if (storage::dbKeyColumnFamily(key) != storage::ColumnFamily::DEFAULT)
+            {
+                BOOST_CHECK(db->Get(::rocksdb::ReadOptions(), std::string(key), &dbValue)
+                                .IsNotFound());
+            }
+        }
+    }
+
+    // A new db is created with the column families
+    std::string newPath = "./rocksdbtestdb_newcf";
+    boost::filesystem::remove_all(newPath);
+    {
+        auto [status, db, columnFamilies] = storage::openRocksDB(options, newPath, openOption);
+        BOOST_REQUIRE(status.ok());
+        BOOST_CHECK(columnFamilies);
+    }
+    BOOST_CHECK(storage::hasColumnFamilies(storage::listColumnFamilies(options, newPath)));
+
+    boost::filesystem::remove_all(path);
+    boost::filesystem::remove_all(newPath);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,256 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief compact binary encoding of the KeyPage pages and table meta
+ * @file KeyPageFormat.h
+ */
+#pragma once
+
+#include <bcos-framework/storage/Common.h>
+#include <bcos-utilities/Error.h>
+#include <boost/endian/conversion.hpp>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace bcos::storage
+{
+
+enum class PageFormat : uint8_t
+{
+    BOOST_ARCHIVE = 0,  // boost::serialization binary archive, the format before 3.5
+    BINARY_V1 = 1,
+};
+
+// Encoded value starts with 0xFF 'K' 'P' <version>. The boost archives start with a uint32
+// count, the magic read as a count is more than 20 million entries, can't be a valid page
+constexpr static std::string_view PAGE_FORMAT_MAGIC{"\xFF" "KP", 3};
+constexpr static size_t PAGE_FORMAT_HEADER_SIZE = PAGE_FORMAT_MAGIC.size() + 1;
+
+inline bool isBinaryPageFormat(std::string_view value)
+{
+    return value.size() >= PAGE_FORMAT_HEADER_SIZE && value.starts_with(PAGE_FORMAT_MAGIC) &&
+           static_cast<uint8_t>(value[PAGE_FORMAT_MAGIC.size()]) ==
+               static_cast<uint8_t>(PageFormat::BINARY_V1);
+}
+
+class PageFormatWriter
+{
+public:
+    explicit PageFormatWriter(std::string& buffer) : m_buffer(buffer) {}
+
+    void writeHeader()
+    {
+        m_buffer.append(PAGE_FORMAT_MAGIC);
+        m_buffer.push_back(static_cast<char>(PageFormat::BINARY_V1));
+    }
+    template <class Integer>
+    void write(Integer value)
+    {
+        boost::endian::native_to_little_inplace(value);
+        m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    template <class Integer>
+    void write(size_t offset, Integer value)
+    {
+        boost::endian::native_to_little_inplace(value);
+        std::memcpy(m_buffer.data() + offset, &value, sizeof(value));
+    }
+    void write(std::string_view bytes) { m_buffer.append(bytes); }
+    size_t size() const { return m_buffer.size(); }
+
+private:
+    std::string& m_buffer;
+};
+
+// Bounds checked reader, throws on the truncated or corrupted value
+class PageFormatReader
+{
+public:
+    explicit PageFormatReader(std::string_view buffer) : m_buffer(buffer)
+    {
+        if (!isBinaryPageFormat(buffer))
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "Invalid page format"));
+        }
+        m_offset = PAGE_FORMAT_HEADER_SIZE;
+    }
+
+    template <class Integer>
+    Integer read()
+    {
+        Integer value;
+        std::memcpy(&value, take(sizeof(value)).data(), sizeof(value));
+        return boost::endian::little_to_native(value);
+    }
+    std::string_view read(size_t length) { return take(length); }
+    size_t offset() const { return m_offset; }
+    bool finished() const { return m_offset == m_buffer.size(); }
+
+private:
+    std::string_view take(size_t length)
+    {
+        if (length > m_buffer.size() - m_offset)
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "Truncated page format"));
+        }
+        auto bytes = m_buffer.substr(m_offset, length);
+        m_offset += length;
+        return bytes;
+    }
+
+    std::string_view m_buffer;
+    size_t m_offset = 0;
+};
+
+// Page v1: header, uint32 count, uint32 offsets[count + 1] relative to the records, then the
+// sorted records of uint32 keySize, key and value. Entries are read in place with binary search
+class PageView
+{
+public:
+    // Checks the offsets and key sizes, the accessors don't check the bounds again. The buffer
+    // checked before can skip the check
+    explicit PageView(std::string_view buffer, bool check = true) : m_buffer(buffer)
+    {
+        if (!check)
+        {
+            m_count = readUint32(PAGE_FORMAT_HEADER_SIZE);
+            m_offsets = PAGE_FORMAT_HEADER_SIZE + sizeof(uint32_t);
+            m_records = m_offsets + (m_count + 1) * sizeof(uint32_t);
+            return;
+        }
+        PageFormatReader reader(buffer);
+        m_count = reader.read<uint32_t>();
+        if (m_count > (buffer.size() - reader.offset()) / sizeof(uint32_t))
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "Invalid page count"));
+        }
+        m_offsets = reader.offset();
+        reader.read((m_count + 1) * sizeof(uint32_t));
+        m_records = reader.offset();
+
+        size_t previous = 0;
+        for (size_t i = 0; i <= m_count; ++i)
+        {
+            auto offset = this->offset(i);
+            if (offset < previous || offset > buffer.size() - m_records ||
+                (i > 0 && offset - previous < sizeof(uint32_t) + keySize(i - 1, offset)))
+            {
+                BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "Invalid page offset"));
+            }
+            previous = offset;
+        }
+        if (previous != buffer.size() - m_records)
+        {
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "Invalid page size"));
+        }
+    }
+
+    size_t count() const { return m_count; }
+    std::string_view key(size_t index) const
+    {
+        auto begin = m_records + offset(index);
+        return m_buffer.substr(begin + sizeof(uint32_t), readUint32(begin));
+    }
+    std::string_view value(size_t index) const
+    {
+        auto begin = m_records + offset(index);
+        auto valueBegin = begin + sizeof(uint32_t) + readUint32(begin);
+        return m_buffer.substr(valueBegin, m_records + offset(index + 1) - valueBegin);
+    }
+    // Sum of the key and value sizes
+    size_t dataSize() const { return offset(m_count) - m_count * sizeof(uint32_t); }
+
+    std::optional<size_t> find(std::string_view key) const
+    {
+        auto index = lowerBound(key);
+        if (index < m_count && this->key(index) == key)
+        {
+            return index;
+        }
+        return std::nullopt;
+    }
+    // Index of the first key not less than the key, count() if not found
+    size_t lowerBound(std::string_view key) const
+    {
+        size_t low = 0;
+        size_t high = m_count;
+        while (low < high)
+        {
+            auto middle = low + (high - low) / 2;
+            if (this->key(middle) < key)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    // forEachRecord(emit) calls emit(key, value) count times in the order of the keys
+    static std::string encode(size_t count, auto&& forEachRecord)
+    {
+        std::string buffer;
+        PageFormatWriter writer(buffer);
+        writer.writeHeader();
+        writer.write((uint32_t)count);
+        auto offsets = writer.size();
+        buffer.resize(offsets + (count + 1) * sizeof(uint32_t));
+        auto begin = writer.size();
+        size_t index = 0;
+        forEachRecord([&](std::string_view key, std::string_view value) {
+            assert(index < count);
+            writer.write(offsets + index * sizeof(uint32_t), (uint32_t)(writer.size() - begin));
+            writer.write((uint32_t)key.size());
+            writer.write(key);
+            writer.write(value);
+            ++index;
+        });
+        assert(index == count);
+        writer.write(offsets + count * sizeof(uint32_t), (uint32_t)(writer.size() - begin));
+        return buffer;
+    }
+
+private:
+    uint32_t readUint32(size_t position) const
+    {
+        uint32_t value;
+        std::memcpy(&value, m_buffer.data() + position, sizeof(value));
+        return boost::endian::little_to_native(value);
+    }
+    size_t offset(size_t index) const { return readUint32(m_offsets + index * sizeof(uint32_t)); }
+    size_t keySize(size_t index, size_t end) const
+    {
+        auto begin = offset(index);
+        if (end - begin < sizeof(uint32_t))
+        {
+            return end - begin;
+        }
+        return readUint32(m_records + begin);
+    }
+
+    std::string_view m_buffer;
+    size_t m_count = 0;
+    size_t m_offsets = 0;
+    size_t m_records = 0;
+};
+
+}  // namespace bcos::storage
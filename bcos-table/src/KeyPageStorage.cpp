@@ -45,48 +45,141 @@ void KeyPageStorage::asyncGetPrimaryKeys(std::string_view tableView,
             std::vector<std::string>());
         return;
     }
-    // page
-    auto [error, data] = getData(tableView, TABLE_META_KEY);
+    std::vector<std::string> ret;
+    ret.reserve(_condition->getLimit().second);
+    RangeIterator iterator(*this, tableView, *_condition, false);
+    while (iterator.next())
+    {
+        ret.emplace_back(iterator.key());
+    }
+    if (auto error = iterator.takeError())
+    {
+        _callback(std::move(error), std::vector<std::string>());
+        return;
+    }
+    _callback(nullptr, std::move(ret));
+}
+
+Error::UniquePtr KeyPageStorage::scanRows(std::string_view table, const Condition& condition,
+    std::function<bool(std::string_view key, const Entry& entry)> visitor)
+{
+    if (m_ignoreTables->find(table) != m_ignoreTables->end())
+    {
+        return BCOS_ERROR_UNIQUE_PTR(StorageError::ReadError,
+            std::string("scan ").append(table).append(" is not supported"));
+    }
+    RangeIterator iterator(*this, table, condition);
+    while (iterator.next())
+    {
+        if (!m_readOnly)
+        {
+            m_readLength += iterator.key().size() + iterator.entry().size();
+        }
+        if (!visitor(iterator.key(), iterator.entry()))
+        {
+            break;
+        }
+    }
+    return iterator.takeError();
+}
+
+bool KeyPageStorage::RangeIterator::next()
+{
+    if (m_index + 1 < m_rows.size())
+    {
+        ++m_index;
+        return true;
+    }
+    while (!m_end)
+    {
+        m_rows.clear();
+        m_index = 0;
+        readPage();
+        if (!m_rows.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void KeyPageStorage::RangeIterator::readPage()
+{
+    auto limit = m_condition.getLimit();
+    auto offset = limit.first;
+    auto total = limit.second;
+    if (m_count >= total)
+    {
+        m_end = true;
+        return;
+    }
+    auto [error, data] = m_storage.getData(m_table, TABLE_META_KEY);
     if (error)
     {
-        _callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(StorageError::ReadError,
-                      std::string("get table meta data failed, table:").append(tableView), *error),
-            std::vector<std::string>());
+        m_error = BCOS_ERROR_WITH_PREV_UNIQUE_PTR(StorageError::ReadError,
+            std::string("get table meta data failed, table:").append(m_table), *error);
+        m_end = true;
         return;
     }
-    std::vector<std::string> ret;
     auto* meta = data.value()->getTableMeta();
     auto readLock = meta->rLock();
     auto& pageInfo = meta->getAllPageInfoNoLock();
-    auto [offset, total] = _condition->getLimit();
-    ret.reserve(total);
-    size_t validCount = 0;
-    for (auto& info : pageInfo)
+    auto it = m_pageKey ? meta->upper_bound(*m_pageKey) :
+                          meta->lower_bound(m_condition.lowerBound());
+    // skip the pages emptied by rollback
+    while (it != pageInfo.end() && (it->getCount() == 0 || it->getPageKey().empty()))
     {
-        auto [error, data] = getData(tableView, info.getPageKey(), info.getCount() > 0);
-        boost::ignore_unused(error);
-        assert(!error);
-        auto* page = data.value()->getPage();
-        auto [entries, pageLock] = page->getEntries();
-        boost::ignore_unused(pageLock);
-        for (auto& it : entries)
+        ++it;
+    }
+    if (it == pageInfo.end())
+    {
+        m_end = true;
+        return;
+    }
+    m_pageKey = it->getPageKey();
+    Data* pageData = it->getPageData();
+    if (pageData == nullptr)
+    {
+        auto [error, pageDataOp] = m_storage.getData(m_table, *m_pageKey, true);
+        if (error)
         {
-            if (it.second.status() != Entry::DELETED && _condition->isValid(it.first))
-            {
-                if (validCount >= offset && validCount < offset + total)
-                {
-                    ret.emplace_back(it.first);
-                }
-                ++validCount;
-                if (validCount == offset + total)
-                {
-                    break;
-                }
-            }
+            m_error = BCOS_ERROR_WITH_PREV_UNIQUE_PTR(StorageError::ReadError,
+                std::string("get page failed, table:").append(m_table), *error);
+            m_end = true;
+            return;
         }
+        pageData = pageDataOp.value();
+        it->setPageData(pageData);
     }
-    readLock.unlock();
-    _callback(nullptr, std::move(ret));
+    if (pageData->entry.status() == Entry::Status::EMPTY)
+    {
+        return;
+    }
+    auto* page = pageData->getPage();
+    page->forEach(m_condition.lowerBound(), [&](std::string_view key, auto&& readEntry) {
+        if (m_condition.isBeyond(key))
+        {
+            m_end = true;
+            return false;
+        }
+        if (!m_condition.isValid(key))
+        {
+            return true;
+        }
+        if (m_skipped < offset)
+        {
+            ++m_skipped;
+            return true;
+        }
+        m_rows.emplace_back(key, m_readEntry ? readEntry() : Entry());
+        ++m_count;
+        if (m_count >= total)
+        {
+            m_end = true;
+            return false;
+        }
+        return true;
+    });
 }
 
 void KeyPageStorage::asyncGetRow(std::string_view tableView, std::string_view keyView,
@@ -251,7 +344,7 @@ void KeyPageStorage::parallelTraverse(bool onlyDirty,
                         {
                             auto* meta = it.second->getTableMeta();
                             Entry entry;
-                            entry.setObject(*meta);
+                            entry.set(meta->encode(s_pageFormat));
                             m_size += entry.size();
                             if (!m_readOnly)
                             {
@@ -295,7 +388,7 @@ void KeyPageStorage::parallelTraverse(bool onlyDirty,
                             }
                             else
                             {
-                                entry.setObject(*page);
+                                entry.set(page->encode(s_pageFormat));
                                 m_size += entry.size();
                                 entry.setStatus(it.second->entry.status());
                                 if (!m_readOnly)
@@ -698,7 +791,7 @@ auto KeyPageStorage::getEntryFromPage(std::string_view table, std::string_view k
             if (data.value()->entry.dirty())
             {
                 Entry entry;
-                entry.setObject(*meta);
+                entry.set(meta->encode(s_pageFormat));
                 entry.setStatus(data.value()->entry.status());
                 return std::make_pair(nullptr, std::move(entry));
             }
@@ -771,7 +864,7 @@ auto KeyPageStorage::getEntryFromPage(std::string_view table, std::string_view k
                         << LOG_KV("dirty", data.value()->entry.dirty());
                 }
                 Entry entry;
-                entry.setObject(*page);
+                entry.set(page->encode(s_pageFormat));
                 entry.setStatus(pageData->entry.status());
                 return std::make_pair(nullptr, std::move(entry));
             }
@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include "KeyPageFormat.h"
 #include "StateStorageInterface.h"
 #include <boost/archive/basic_archive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
@@ -84,6 +85,18 @@ constexpr static int32_t ARCHIVE_FLAG =
 
 const char* const TABLE_META_KEY = "";
 const size_t MIN_PAGE_SIZE = 2048;
+
+template <class Object>
+std::string encodeArchive(const Object& object)
+{
+    std::string value;
+    boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> outputStream(value);
+    boost::archive::binary_oarchive archive(outputStream, ARCHIVE_FLAG);
+    archive << object;
+    outputStream.flush();
+    return value;
+}
+
 class KeyPageStorage : public virtual storage::StateStorageInterface
 {
 public:
@@ -147,6 +160,53 @@ public:
 
     void rollback(const Recoder& recoder) override;
 
+    // Format of the pages and table meta written by the process, both formats are readable, the
+    // pages of the old format are rewritten in the new format when they are modified
+    static void setPageFormat(PageFormat format) { s_pageFormat = format; }
+    static PageFormat pageFormat() { return s_pageFormat; }
+
+    Error::UniquePtr scanRows(std::string_view table, const Condition& condition,
+        std::function<bool(std::string_view key, const Entry& entry)> visitor) override;
+
+    // Ordered scan of the rows matched the condition, skips the offset and ends after the count of
+    // the condition limit. The rows are read a page at a time without the locks held between two
+    // pages, the next page is located by the pageKey of the last one
+    class RangeIterator
+    {
+    public:
+        // The condition must outlive the iterator, readEntry false to read the keys only
+        RangeIterator(KeyPageStorage& storage, std::string_view table, const Condition& condition,
+            bool readEntry = true)
+          : m_storage(storage), m_table(table), m_condition(condition), m_readEntry(readEntry)
+        {}
+        RangeIterator(const RangeIterator&) = delete;
+        RangeIterator(RangeIterator&&) = delete;
+        RangeIterator& operator=(const RangeIterator&) = delete;
+        RangeIterator& operator=(RangeIterator&&) = delete;
+        ~RangeIterator() noexcept = default;
+
+        // false at the end or on error
+        bool next();
+        std::string_view key() const { return m_rows[m_index].first; }
+        const Entry& entry() const { return m_rows[m_index].second; }
+        Error::UniquePtr takeError() { return std::move(m_error); }
+
+    private:
+        void readPage();
+
+        KeyPageStorage& m_storage;
+        std::string m_table;
+        const Condition& m_condition;
+        bool m_readEntry = true;
+        std::optional<std::string> m_pageKey;
+        std::vector<std::pair<std::string, Entry>> m_rows;
+        size_t m_index = 0;
+        size_t m_skipped = 0;
+        size_t m_count = 0;
+        bool m_end = false;
+        Error::UniquePtr m_error;
+    };
+
     struct Data;
     class PageInfo
     {  // all methods is not thread safe
@@ -179,6 +239,14 @@ public:
             }
             return {};
         }
+        [[nodiscard]] auto pageKeyView() const -> std::string_view
+        {
+            if (m_data)
+            {
+                return m_data->pageKey;
+            }
+            return {};
+        }
         void setCount(uint16_t _count)
         {
             prepareMyData();
@@ -263,6 +331,11 @@ public:
             {
                 return;
             }
+            if (isBinaryPageFormat(value))
+            {
+                decode(value);
+                return;
+            }
             boost::iostreams::stream<boost::iostreams::array_source> inputStream(
                 value.data(), value.size());
             boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
@@ -490,6 +563,32 @@ public:
             os << "]";
             return os;
         }
+        // Removes the empty pages before encoding, like the boost serialization
+        std::string encode(PageFormat format) const
+        {
+            if (format == PageFormat::BOOST_ARCHIVE)
+            {
+                return encodeArchive(*this);
+            }
+            // header, uint32 count, then uint32 keySize, key, uint16 count and uint16 size of pages
+            std::string buffer;
+            PageFormatWriter writer(buffer);
+            auto writeLock = lock();
+            auto invalid = removeEmptyPagesNoLock();
+            writer.writeHeader();
+            writer.write((uint32_t)pages->size());
+            for (const auto& pageInfo : *pages)
+            {
+                auto pageKey = pageInfo.pageKeyView();
+                writer.write((uint32_t)pageKey.size());
+                writer.write(pageKey);
+                writer.write(pageInfo.getCount());
+                writer.write(pageInfo.getSize());
+            }
+            KeyPage_LOG(DEBUG) << LOG_DESC("Encode meta") << LOG_KV("valid", pages->size())
+                               << LOG_KV("invalid", invalid) << LOG_KV("size", buffer.size());
+            return buffer;
+        }
         double hitRate() const { return hit / (double)getPageInfoCount; }
         uint64_t rowCount() const { return m_rows; }
 
@@ -507,23 +606,28 @@ public:
         std::unique_ptr<std::vector<PageInfo>> pages = nullptr;
         friend class boost::serialization::access;
         size_t lastPageInfoIndex = 0;
-        template <class Archive>
-        void save(Archive& ar, const unsigned int version) const
+        void decode(std::string_view value)
         {
-            std::ignore = version;
-            // auto len = (uint32_t)pages->size();
-            // ar& len;
-            // for (size_t i = 0; i < pages->size(); ++i)
-            // {
-            //     if (pages->at(i).getCount() == 0)
-            //     {
-            //         continue;
-            //     }
-            //     ar & pages->at(i);
-            // }
-            int invalid = 0;
+            PageFormatReader reader(value);
+            auto count = reader.read<uint32_t>();
+            pages = std::make_unique<std::vector<PageInfo>>();
+            pages->reserve(std::min<size_t>(count, value.size() / (sizeof(uint32_t) * 2)));
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto pageKey = reader.read(reader.read<uint32_t>());
+                auto pageCount = reader.read<uint16_t>();
+                auto pageSize = reader.read<uint16_t>();
+                pages->emplace_back(std::string(pageKey), pageCount, pageSize, nullptr);
+            }
+            if (!reader.finished())
+            {
+                BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::ReadError, "Invalid meta size"));
+            }
+        }
+        size_t removeEmptyPagesNoLock() const
+        {
+            size_t invalid = 0;
             m_rows = 0;
-            auto writeLock = lock();
             for (auto it = pages->begin(); it != pages->end();)
             {
                 if (it->getCount() == 0 || it->getPageKey().empty())
@@ -541,6 +645,24 @@ public:
                     ++it;
                 }
             }
+            return invalid;
+        }
+        template <class Archive>
+        void save(Archive& ar, const unsigned int version) const
+        {
+            std::ignore = version;
+            // auto len = (uint32_t)pages->size();
+            // ar& len;
+            // for (size_t i = 0; i < pages->size(); ++i)
+            // {
+            //     if (pages->at(i).getCount() == 0)
+            //     {
+            //         continue;
+            //     }
+            //     ar & pages->at(i);
+            // }
+            auto writeLock = lock();
+            auto invalid = removeEmptyPagesNoLock();
             ar << *pages;
             KeyPage_LOG(DEBUG) << LOG_DESC("Serialize meta") << LOG_KV("valid", pages->size())
                                << LOG_KV("invalid", invalid);
@@ -572,22 +694,39 @@ public:
             {
                 return;
             }
-            boost::iostreams::stream<boost::iostreams::array_source> inputStream(
-                value.data(), value.size());
-            boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
-            archive >> *this;
-            if (pageKey != entries.rbegin()->first)
+            std::string_view endKey;
+            if (isBinaryPageFormat(value))
+            {  // keep the encoded page, the entries are read in place until the page modified
+                PageView view(value);
+                m_validCount = view.count();
+                m_size = view.dataSize();
+                if (m_validCount == 0)
+                {
+                    return;
+                }
+                m_encoded = std::string(value);
+                endKey = encodedView().key(m_validCount - 1);
+            }
+            else
+            {
+                boost::iostreams::stream<boost::iostreams::array_source> inputStream(
+                    value.data(), value.size());
+                boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
+                archive >> *this;
+                endKey = entries.rbegin()->first;
+            }
+            if (pageKey != endKey)
             {
                 KeyPage_LOG(INFO) << LOG_DESC("load page with invalid pageKey")
                                   << LOG_KV("pageKey", toHex(pageKey))
-                                  << LOG_KV("validPageKey", toHex(entries.rbegin()->first))
-                                  << LOG_KV("valid", m_validCount)
-                                  << LOG_KV("count", entries.size());
+                                  << LOG_KV("validPageKey", toHex(endKey))
+                                  << LOG_KV("valid", m_validCount);
                 m_invalidPageKeys.insert(std::string(pageKey));
             }
         }
         Page(const Page& page)
           : entries(page.entries),
+            m_encoded(page.m_encoded),
             m_size(page.m_size),
             m_validCount(page.m_validCount),
             m_invalidPageKeys(page.m_invalidPageKeys)
@@ -597,6 +736,7 @@ public:
             if (this != &p)
             {
                 entries = p.entries;
+                m_encoded = p.m_encoded;
                 m_size = p.m_size;
                 m_validCount = p.m_validCount;
                 m_invalidPageKeys = p.m_invalidPageKeys;
@@ -606,6 +746,7 @@ public:
         Page(Page&& p) noexcept
         {
             entries = std::move(p.entries);
+            m_encoded = std::move(p.m_encoded);
             m_size = p.m_size;
             m_validCount = p.m_validCount;
             m_invalidPageKeys = std::move(p.m_invalidPageKeys);
@@ -615,6 +756,7 @@ public:
             if (this != &p)
             {
                 entries = std::move(p.entries);
+                m_encoded = std::move(p.m_encoded);
                 m_size = p.m_size;
                 m_validCount = p.m_validCount;
                 m_invalidPageKeys = std::move(p.m_invalidPageKeys);
@@ -625,6 +767,19 @@ public:
         std::optional<Entry> getEntry(std::string_view key)
         {
             std::shared_lock lock(mutex);
+            if (lazy())
+            {
+                auto view = encodedView();
+                auto index = view.find(key);
+                if (!index)
+                {
+                    return std::nullopt;
+                }
+                Entry entry;
+                entry.set(view.value(*index));
+                entry.setStatus(Entry::Status::NORMAL);
+                return entry;
+            }
             auto it = entries.find(key);
             if (it != entries.end())
             {
@@ -662,6 +817,7 @@ public:
         getEntries()
         {
             std::unique_lock lock(mutex);
+            materialize();
             return std::make_pair(std::ref(entries), std::move(lock));
         }
         inline std::tuple<std::optional<Entry>, bool> setEntry(
@@ -671,6 +827,7 @@ public:
             bool pageInfoChanged = false;
             std::optional<Entry> ret;
             std::unique_lock lock(mutex);
+            materialize();
             auto it = entries.lower_bound(key);
             m_size += entry.size();
             if (it != entries.end() && it->first == key)
@@ -765,6 +922,10 @@ public:
         auto count() const -> size_t
         {
             std::shared_lock lock(mutex);
+            if (lazy())
+            {
+                return encodedView().count();
+            }
             return entries.size();
         }
         auto invalidKeySet() const -> const std::set<std::string>&
@@ -776,6 +937,10 @@ public:
         auto startKey() const -> std::string
         {
             std::shared_lock lock(mutex);
+            if (lazy())
+            {
+                return std::string(encodedView().key(0));
+            }
             if (entries.empty())
             {
                 return "";
@@ -785,16 +950,57 @@ public:
         std::string endKey() const
         {
             std::shared_lock lock(mutex);
+            if (lazy())
+            {
+                auto view = encodedView();
+                return std::string(view.key(view.count() - 1));
+            }
             if (entries.empty())
             {
                 return "";
             }
             return entries.rbegin()->first;
         }
+        // Visits the valid entries from the first key not less than begin in the order of the keys,
+        // visitor(key, readEntry) returns false to stop, readEntry() returns the entry
+        void forEach(std::string_view begin, auto&& visitor) const
+        {
+            std::shared_lock lock(mutex);
+            if (lazy())
+            {
+                auto view = encodedView();
+                for (auto i = view.lowerBound(begin); i < view.count(); ++i)
+                {
+                    auto readEntry = [&view, i]() {
+                        Entry entry;
+                        entry.set(view.value(i));
+                        entry.setStatus(Entry::Status::NORMAL);
+                        return entry;
+                    };
+                    if (!visitor(view.key(i), readEntry))
+                    {
+                        return;
+                    }
+                }
+                return;
+            }
+            for (auto it = entries.lower_bound(begin); it != entries.end(); ++it)
+            {
+                if (it->second.status() == Entry::Status::DELETED)
+                {
+                    continue;
+                }
+                if (!visitor(std::string_view(it->first), [&it]() { return it->second; }))
+                {
+                    return;
+                }
+            }
+        }
         auto split(size_t threshold)
         {
             auto page = Page();
             std::unique_lock lock(mutex);
+            materialize();
             // split this page to two pages
             auto iter = entries.begin();
             while (iter != entries.end())
@@ -844,6 +1050,8 @@ public:
             if (this != &p)
             {
                 std::unique_lock lock(mutex);
+                materialize();
+                p.materialize();
                 for (auto iter = p.entries.begin(); iter != p.entries.end();)
                 {
                     m_size += iter->second.size();
@@ -872,6 +1080,7 @@ public:
         void clean(const std::string_view& pageKey)
         {
             std::unique_lock lock(mutex);
+            materialize();
             for (auto iter = entries.begin(); iter != entries.end();)
             {
                 if (iter->second.status() != Entry::Status::DELETED)
@@ -903,6 +1112,7 @@ public:
         auto hash(const std::string& table, const bcos::crypto::Hash::Ptr& hashImpl,
             uint32_t blockVersion) const -> crypto::HashType
         {
+            // Entries of a lazy page are not read yet, none of them is dirty
             bcos::crypto::HashType pageHash(0);
             auto hash = hashImpl->hash(table);
             // std::shared_lock lock(mutex);
@@ -936,6 +1146,7 @@ public:
         void rollback(const Recoder::Change& change)
         {
             std::unique_lock lock(mutex);
+            materialize();
             auto it = entries.find(change.key);
             if (change.entry)
             {
@@ -1015,10 +1226,54 @@ public:
         void setTableMeta(TableMeta* _meta) { m_meta = _meta; }
         TableMeta* myTableMeta() { return m_meta; }
 
+        // Not thread safe like the boost serialization, the deleted entries are skipped
+        std::string encode(PageFormat format) const
+        {
+            if (format == PageFormat::BOOST_ARCHIVE)
+            {
+                return encodeArchive(*this);
+            }
+            if (lazy())
+            {  // not modified since loaded
+                return m_encoded;
+            }
+            return PageView::encode(m_validCount, [this](auto&& emit) {
+                for (const auto& [key, entry] : entries)
+                {
+                    if (entry.status() != Entry::Status::DELETED)
+                    {
+                        emit(key, entry.get());
+                    }
+                }
+            });
+        }
+        bool lazy() const { return !m_encoded.empty(); }
+        PageView encodedView() const { return PageView(m_encoded, false); }
+
     private:
+        // Decodes the entries of the lazy page, called with the unique lock
+        void materialize()
+        {
+            if (!lazy())
+            {
+                return;
+            }
+            auto view = encodedView();
+            for (size_t i = 0; i < view.count(); ++i)
+            {
+                Entry entry;
+                entry.set(view.value(i));
+                entry.setStatus(Entry::Status::NORMAL);
+                entries.emplace_hint(entries.end(), view.key(i), std::move(entry));
+            }
+            m_encoded.clear();
+        }
+
         //   PageInfo* pageInfo;
         mutable std::shared_mutex mutex;
         std::map<std::string, Entry, std::less<>> entries;
+        // The binary page before its entries decoded, empty if entries is used
+        std::string m_encoded;
         uint32_t m_size = 0;        // page real size
         uint32_t m_validCount = 0;  // valid entry count
         friend class boost::serialization::access;
@@ -1030,6 +1285,18 @@ public:
         {
             std::ignore = version;
             ar&(uint32_t)m_validCount;
+            if (lazy())
+            {
+                auto view = encodedView();
+                for (size_t i = 0; i < view.count(); ++i)
+                {
+                    ar& std::string(view.key(i));
+                    auto value = view.value(i);
+                    ar&(uint32_t)value.size();
+                    ar.save_binary(value.data(), value.size());
+                }
+                return;
+            }
             [[maybe_unused]] size_t count = 0;
             for (const auto& i : entries)
             {
@@ -1317,6 +1584,7 @@ private:
     std::vector<Bucket> m_buckets;
     std::shared_ptr<const std::set<std::string, std::less<>>> m_ignoreTables;
     bool m_ignoreNotExist = false;
+    inline static std::atomic<PageFormat> s_pageFormat = PageFormat::BOOST_ARCHIVE;
 };
 
 }  // namespace bcos::storage
@@ -105,6 +105,36 @@ void StorageInterface::asyncOpenTable(std::string_view tableName,
     });
 }
 
+bcos::Error::UniquePtr StorageInterface::scanRows(std::string_view table,
+    const Condition& condition,
+    std::function<bool(std::string_view key, const Entry& entry)> visitor)
+{
+    Error::UniquePtr keysError;
+    std::vector<std::string> keys;
+    asyncGetPrimaryKeys(
+        table, condition, [&](Error::UniquePtr error, std::vector<std::string> primaryKeys) {
+            keysError = std::move(error);
+            keys = std::move(primaryKeys);
+        });
+    if (keysError)
+    {
+        return keysError;
+    }
+    for (const auto& key : keys)
+    {
+        auto [error, entry] = getRow(table, key);
+        if (error)
+        {
+            return std::move(error);
+        }
+        if (entry && !visitor(key, *entry))
+        {
+            break;
+        }
+    }
+    return nullptr;
+}
+
 void StorageInterface::asyncGetTableInfo(
     std::string_view tableName, std::function<void(Error::UniquePtr, TableInfo::ConstPtr)> callback)
 {
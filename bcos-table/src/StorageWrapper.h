@@ -59,6 +59,21 @@ public:
         return std::move(keys);
     }
 
+    // Rows of the condition in the order of the keys, visitor returns false to stop
+    virtual void scanRows(const std::string_view& table, const storage::Condition& condition,
+        std::function<bool(std::string_view key, const storage::Entry& entry)> visitor)
+    {
+        auto error = m_storage->scanRows(table, condition, std::move(visitor));
+
+        // After coroutine switch, set the recoder
+        setRecoder(m_recoder);
+
+        if (error)
+        {
+            BOOST_THROW_EXCEPTION(*error);
+        }
+    }
+
     std::optional<storage::Entry> getRowInternal(
         const std::string_view& table, const std::string_view& _key)
     {
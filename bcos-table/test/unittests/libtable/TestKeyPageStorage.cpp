@@ -3057,5 +3057,317 @@ BOOST_AUTO_TEST_CASE(TableMeta_read_write_mutex)
     // boost::log::core::get()->set_logging_enabled(false);
 }
 
+BOOST_AUTO_TEST_CASE(pageBinaryFormat)
+{
+    KeyPageStorage::Page page;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        Entry entry;
+        entry.set(std::string(i * 3, 'v'));
+        page.setEntry("key" + boost::lexical_cast<std::string>(1000 + i), std::move(entry));
+    }
+    Entry deleted;
+    deleted.setStatus(Entry::Status::DELETED);
+    page.setEntry("key1050", std::move(deleted));
+    auto binary = page.encode(PageFormat::BINARY_V1);
+    auto archive = page.encode(PageFormat::BOOST_ARCHIVE);
+    BOOST_REQUIRE(isBinaryPageFormat(binary));
+    BOOST_REQUIRE(!isBinaryPageFormat(archive));
+    BOOST_CHECK_LT(binary.size(), archive.size());
+
+    KeyPageStorage::Page lazyPage(binary, "key1099");
+    KeyPageStorage::Page oldPage(archive, "key1099");
+    BOOST_REQUIRE(lazyPage.lazy());
+    BOOST_REQUIRE(!oldPage.lazy());
+    BOOST_CHECK_EQUAL(lazyPage.validCount(), 99);
+    BOOST_CHECK_EQUAL(lazyPage.count(), oldPage.count());
+    BOOST_CHECK_EQUAL(lazyPage.size(), oldPage.size());
+    BOOST_CHECK_EQUAL(lazyPage.startKey(), "key1000");
+    BOOST_CHECK_EQUAL(lazyPage.endKey(), "key1099");
+    BOOST_CHECK_EQUAL(lazyPage.invalidKeyCount(), 0);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        auto key = "key" + boost::lexical_cast<std::string>(1000 + i);
+        auto entry = lazyPage.getEntry(key);
+        BOOST_CHECK_EQUAL(entry.has_value(), oldPage.getEntry(key).has_value());
+        if (i != 50)
+        {
+            BOOST_CHECK_EQUAL(entry->get(), std::string(i * 3, 'v'));
+            BOOST_CHECK_EQUAL(entry->status(), Entry::Status::NORMAL);
+        }
+    }
+    BOOST_CHECK(!lazyPage.getEntry("key0").has_value());
+    BOOST_CHECK(!lazyPage.getEntry("key2000").has_value());
+    // Not modified, the encoded page is reused
+    BOOST_CHECK(lazyPage.lazy());
+    BOOST_CHECK_EQUAL(lazyPage.encode(PageFormat::BINARY_V1), binary);
+    BOOST_CHECK_EQUAL(lazyPage.encode(PageFormat::BOOST_ARCHIVE), archive);
+    BOOST_CHECK_EQUAL(oldPage.encode(PageFormat::BINARY_V1), binary);
+
+    Entry entry;
+    entry.set("new value");
+    lazyPage.setEntry("key1050", std::move(entry));
+    BOOST_CHECK(!lazyPage.lazy());
+    BOOST_CHECK_EQUAL(lazyPage.validCount(), 100);
+    BOOST_CHECK_EQUAL(lazyPage.getEntry("key1050")->get(), "new value");
+    BOOST_CHECK_EQUAL(lazyPage.getEntry("key1051")->get(), std::string(51 * 3, 'v'));
+
+    // The pageKey is not the last key
+    KeyPageStorage::Page invalidKeyPage(binary, "key1100");
+    BOOST_CHECK_EQUAL(invalidKeyPage.invalidKeyCount(), 1);
+
+    BOOST_CHECK_THROW(KeyPageStorage::Page(binary.substr(0, binary.size() - 1), "key1099"),
+        bcos::Error);
+    auto corrupted = binary;
+    corrupted[PAGE_FORMAT_HEADER_SIZE + sizeof(uint32_t) * 2] = '\xFF';
+    BOOST_CHECK_THROW(KeyPageStorage::Page(corrupted, "key1099"), bcos::Error);
+}
+
+BOOST_AUTO_TEST_CASE(tableMetaBinaryFormat)
+{
+    KeyPageStorage::TableMeta meta;
+    for (int i = 0; i < 100; ++i)
+    {
+        meta.insertPageInfoNoLock(
+            KeyPageStorage::PageInfo(std::to_string(1000 + i), i % 10 == 0 ? 0 : i, i, nullptr));
+    }
+    auto binary = meta.encode(PageFormat::BINARY_V1);
+    // Empty pages removed
+    BOOST_CHECK_EQUAL(meta.size(), 90);
+    BOOST_CHECK_EQUAL(meta.rowCount(), 4500);
+    auto archive = meta.encode(PageFormat::BOOST_ARCHIVE);
+    BOOST_REQUIRE(isBinaryPageFormat(binary));
+    BOOST_CHECK_LT(binary.size(), archive.size());
+
+    KeyPageStorage::TableMeta binaryMeta(binary);
+    KeyPageStorage::TableMeta archiveMeta(archive);
+    auto& pages = binaryMeta.getAllPageInfoNoLock();
+    auto& archivePages = archiveMeta.getAllPageInfoNoLock();
+    BOOST_REQUIRE_EQUAL(pages.size(), archivePages.size());
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(pages[i].getPageKey(), archivePages[i].getPageKey());
+        BOOST_CHECK_EQUAL(pages[i].getCount(), archivePages[i].getCount());
+        BOOST_CHECK_EQUAL(pages[i].getSize(), archivePages[i].getSize());
+    }
+    BOOST_CHECK_EQUAL(binaryMeta.encode(PageFormat::BINARY_V1), binary);
+    BOOST_CHECK_THROW(KeyPageStorage::TableMeta(binary.substr(0, binary.size() - 1)), bcos::Error);
+}
+
+BOOST_AUTO_TEST_CASE(migrateArchivePages)
+{
+    auto valueFields = "value1";
+    auto stateStorage = make_shared<StateStorage>(nullptr);
+    StateStorageInterface::Ptr prev = stateStorage;
+    auto commit = [&](KeyPageStorage& storage) {
+        storage.parallelTraverse(true, [&](auto&& tableView, auto&& keyView, auto&& entry) {
+            stateStorage->asyncSetRow(tableView, keyView, entry, [](Error::UniquePtr) {});
+            return true;
+        });
+    };
+    auto tableName = "table_000";
+
+    KeyPageStorage::setPageFormat(PageFormat::BOOST_ARCHIVE);
+    auto tableStorage = std::make_shared<KeyPageStorage>(prev, 2048);
+    BOOST_REQUIRE(tableStorage->createTable(tableName, valueFields));
+    auto table = tableStorage->openTable(tableName);
+    for (size_t k = 0; k < 200; ++k)
+    {
+        auto entry = table->newEntry();
+        entry.setField(0, "value" + boost::lexical_cast<std::string>(k));
+        table->setRow("key" + boost::lexical_cast<std::string>(1000 + k), entry);
+    }
+    commit(*tableStorage);
+    size_t archivePages = 0;
+    stateStorage->parallelTraverse(false, [&](auto&& tableView, auto&&, auto&& entry) {
+        if (tableView == tableName)
+        {
+            BOOST_CHECK(!isBinaryPageFormat(entry.get()));
+            ++archivePages;
+        }
+        return true;
+    });
+    BOOST_CHECK_GT(archivePages, 2);
+
+    // Read the old pages, the modified page and the meta are written in the new format
+    KeyPageStorage::setPageFormat(PageFormat::BINARY_V1);
+    auto tableStorage2 = std::make_shared<KeyPageStorage>(prev, 2048);
+    auto table2 = tableStorage2->openTable(tableName);
+    for (size_t k = 0; k < 200; ++k)
+    {
+        auto entry = table2->getRow("key" + boost::lexical_cast<std::string>(1000 + k));
+        BOOST_REQUIRE(entry);
+        BOOST_CHECK_EQUAL(entry->getField(0), "value" + boost::lexical_cast<std::string>(k));
+    }
+    auto entry = table2->newEntry();
+    entry.setField(0, "modified");
+    table2->setRow("key1000", entry);
+    commit(*tableStorage2);
+    size_t binaryPages = 0;
+    stateStorage->parallelTraverse(false, [&](auto&& tableView, auto&&, auto&& entry) {
+        if (tableView == tableName && isBinaryPageFormat(entry.get()))
+        {
+            ++binaryPages;
+        }
+        return true;
+    });
+    // The pages not modified are still in the old format
+    BOOST_CHECK_GE(binaryPages, 1);
+    BOOST_CHECK_LT(binaryPages, archivePages);
+
+    auto tableStorage3 = std::make_shared<KeyPageStorage>(prev, 2048);
+    auto table3 = tableStorage3->openTable(tableName);
+    BOOST_CHECK_EQUAL(table3->getRow("key1000")->getField(0), "modified");
+    BOOST_CHECK_EQUAL(table3->getRow("key1199")->getField(0), "value199");
+    KeyPageStorage::setPageFormat(PageFormat::BOOST_ARCHIVE);
+}
+
+BOOST_AUTO_TEST_CASE(pageFormatRoundTrip)
+{
+    KeyPageStorage::Page page;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        Entry entry;
+        entry.set(std::string(i % 64, 'a' + i % 26));
+        page.setEntry("key1234567890123456789" + boost::lexical_cast<std::string>(1000 + i),
+            std::move(entry));
+    }
+    auto binary = page.encode(PageFormat::BINARY_V1);
+    auto archive = page.encode(PageFormat::BOOST_ARCHIVE);
+
+    // Decode each format and encode in the other, the pages are the same in both formats
+    auto pageKey = "key12345678901234567891199";
+    KeyPageStorage::Page fromBinary(binary, pageKey);
+    KeyPageStorage::Page fromArchive(archive, pageKey);
+    BOOST_CHECK_EQUAL(fromBinary.encode(PageFormat::BOOST_ARCHIVE), archive);
+    BOOST_CHECK_EQUAL(fromArchive.encode(PageFormat::BINARY_V1), binary);
+    KeyPageStorage::Page binaryAgain(fromArchive.encode(PageFormat::BINARY_V1), pageKey);
+    KeyPageStorage::Page archiveAgain(fromBinary.encode(PageFormat::BOOST_ARCHIVE), pageKey);
+    BOOST_CHECK_EQUAL(binaryAgain.count(), page.count());
+    BOOST_CHECK_EQUAL(archiveAgain.count(), page.count());
+    for (size_t i = 0; i < 200; ++i)
+    {
+        auto key = "key1234567890123456789" + boost::lexical_cast<std::string>(1000 + i);
+        auto expected = page.getEntry(key);
+        BOOST_REQUIRE(expected);
+        for (auto* decoded : {&fromBinary, &fromArchive, &binaryAgain, &archiveAgain})
+        {
+            auto entry = decoded->getEntry(key);
+            BOOST_REQUIRE(entry);
+            BOOST_CHECK_EQUAL(entry->get(), expected->get());
+            BOOST_CHECK_EQUAL(entry->status(), Entry::Status::NORMAL);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(scanRows)
+{
+    auto valueFields = "value1";
+    auto stateStorage = make_shared<StateStorage>(nullptr);
+    StateStorageInterface::Ptr prev = stateStorage;
+    auto tableName = "table_scan";
+
+    auto tableStorage = std::make_shared<KeyPageStorage>(prev, 1024);
+    BOOST_REQUIRE(tableStorage->createTable(tableName, valueFields));
+    auto table = tableStorage->openTable(tableName);
+    for (size_t k = 0; k < 1000; ++k)
+    {
+        auto entry = table->newEntry();
+        entry.setField(0, "value" + boost::lexical_cast<std::string>(k));
+        table->setRow("key" + boost::lexical_cast<std::string>(1000 + k), entry);
+    }
+    for (size_t k = 0; k < 1000; k += 10)
+    {
+        table->setRow(
+            "key" + boost::lexical_cast<std::string>(1000 + k), table->newDeletedEntry());
+    }
+    tableStorage->parallelTraverse(true, [&](auto&& tableView, auto&& keyView, auto&& entry) {
+        stateStorage->asyncSetRow(tableView, keyView, entry, [](Error::UniquePtr) {});
+        return true;
+    });
+
+    // The storage of the current block and the storage reading the committed pages
+    auto committedStorage = std::make_shared<KeyPageStorage>(prev, 1024);
+    for (auto storage : {tableStorage, committedStorage})
+    {
+        auto check = [&](Condition const& condition) {
+            std::vector<std::string> keys;
+            auto error = storage->scanRows(
+                tableName, condition, [&](std::string_view key, const Entry& entry) {
+                    auto k = boost::lexical_cast<size_t>(key.substr(3)) - 1000;
+                    BOOST_CHECK_EQUAL(
+                        entry.getField(0), "value" + boost::lexical_cast<std::string>(k));
+                    keys.emplace_back(key);
+                    return true;
+                });
+            BOOST_REQUIRE(!error);
+            BOOST_CHECK(std::is_sorted(keys.begin(), keys.end()));
+            std::vector<std::string> expected;
+            auto [offset, count] = condition.getLimit();
+            for (size_t k = 0; k < 1000 && expected.size() < count; ++k)
+            {
+                auto key = "key" + boost::lexical_cast<std::string>(1000 + k);
+                if (k % 10 == 0 || !condition.isValid(key))
+                {
+                    continue;
+                }
+                if (offset > 0)
+                {
+                    --offset;
+                }
+                else
+                {
+                    expected.emplace_back(key);
+                }
+            }
+            BOOST_CHECK_EQUAL_COLLECTIONS(
+                keys.begin(), keys.end(), expected.begin(), expected.end());
+            return keys.size();
+        };
+
+        Condition all;
+        all.limit(0, 2000);
+        BOOST_CHECK_EQUAL(check(all), 900);
+        Condition page;
+        page.limit(450, 100);
+        BOOST_CHECK_EQUAL(check(page), 100);
+        Condition range;
+        range.GE("key1500");
+        range.LT("key1600");
+        range.limit(0, 500);
+        BOOST_CHECK_EQUAL(check(range), 90);
+        range.limit(85, 500);
+        BOOST_CHECK_EQUAL(check(range), 5);
+        Condition prefix;
+        prefix.startsWith("key12");
+        prefix.limit(0, 500);
+        BOOST_CHECK_EQUAL(check(prefix), 90);
+        Condition none;
+        none.GT("key2");
+        none.limit(0, 500);
+        BOOST_CHECK_EQUAL(check(none), 0);
+
+        size_t visited = 0;
+        BOOST_REQUIRE(!storage->scanRows(tableName, all, [&](std::string_view, const Entry&) {
+            return ++visited < 3;
+        }));
+        BOOST_CHECK_EQUAL(visited, 3);
+    }
+
+    Condition condition;
+    condition.GT("b");
+    condition.GE("c");
+    condition.LE("f");
+    BOOST_CHECK_EQUAL(condition.lowerBound(), "c");
+    BOOST_CHECK(!condition.isBeyond("a"));
+    BOOST_CHECK(!condition.isBeyond("f"));
+    BOOST_CHECK(condition.isBeyond("fa"));
+    Condition prefix;
+    prefix.startsWith("ab");
+    BOOST_CHECK(!prefix.isBeyond("aa"));
+    BOOST_CHECK(!prefix.isBeyond("abz"));
+    BOOST_CHECK(prefix.isBeyond("ac"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
@@ -31,6 +31,10 @@ void ProtocolInfoCodecImpl::encode(
     tarsProtocolInfo.moduleID = _protocol->protocolModuleID();
     tarsProtocolInfo.minVersion = (int32_t)_protocol->minVersion();
     tarsProtocolInfo.maxVersion = (int32_t)_protocol->maxVersion();
+    for (auto dictionaryID : _protocol->compressDictionaryIDs())
+    {
+        tarsProtocolInfo.compressDictionaryIDs.emplace_back((int32_t)dictionaryID);
+    }
     tars::TarsOutputStream<bcostars::protocol::BufferWriterByteVector> output;
     tarsProtocolInfo.writeTo(output);
     output.getByteBuffer().swap(_encodeData);
@@ -47,5 +51,11 @@ bcos::protocol::ProtocolInfo::Ptr ProtocolInfoCodecImpl::decode(bcos::bytesConst
     protocolInfo->setProtocolModuleID((bcos::protocol::ProtocolModuleID)tarsProtocolInfo.moduleID);
     protocolInfo->setMinVersion(tarsProtocolInfo.minVersion);
     protocolInfo->setMaxVersion(tarsProtocolInfo.maxVersion);
+    std::vector<uint32_t> compressDictionaryIDs;
+    for (auto dictionaryID : tarsProtocolInfo.compressDictionaryIDs)
+    {
+        compressDictionaryIDs.emplace_back((uint32_t)dictionaryID);
+    }
+    protocolInfo->setCompressDictionaryIDs(std::move(compressDictionaryIDs));
     return protocolInfo;
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <bcos-tars-protocol/protocol/ExecutionMessageImpl.h>
 #include <bcos-tars-protocol/protocol/GroupInfoCodecImpl.h>
 #include <bcos-tars-protocol/protocol/MemberImpl.h>
+#include <bcos-tars-protocol/protocol/ProtocolInfoCodecImpl.h>
 #include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
 #include <bcos-tars-protocol/protocol/TransactionMetaDataImpl.h>
 #include <bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h>
@@ -588,6 +589,27 @@ BOOST_AUTO_TEST_CASE(testMemberImpl)
     BOOST_CHECK(decodedProtocolInfo->minVersion() == protocolInfo.minVersion());
 }
 
+BOOST_AUTO_TEST_CASE(protocolInfoCodec)
+{
+    auto codec = std::make_shared<bcostars::protocol::ProtocolInfoCodecImpl>();
+    auto protocolInfo = std::make_shared<bcos::protocol::ProtocolInfo>(
+        bcos::protocol::ProtocolModuleID::GatewayService, 1, 2);
+    bcos::bytes encodedData;
+    codec->encode(protocolInfo, encodedData);
+    auto decodedProtocolInfo = codec->decode(bcos::ref(encodedData));
+    BOOST_CHECK(decodedProtocolInfo->protocolModuleID() == protocolInfo->protocolModuleID());
+    BOOST_CHECK_EQUAL(decodedProtocolInfo->minVersion(), 1);
+    BOOST_CHECK_EQUAL(decodedProtocolInfo->maxVersion(), 2);
+    BOOST_CHECK(decodedProtocolInfo->compressDictionaryIDs().empty());
+
+    // the dictionary ids larger than INT32_MAX
+    protocolInfo->setCompressDictionaryIDs({1234567, 0x80000001});
+    codec->encode(protocolInfo, encodedData);
+    decodedProtocolInfo = codec->decode(bcos::ref(encodedData));
+    BOOST_CHECK(
+        decodedProtocolInfo->compressDictionaryIDs() == protocolInfo->compressDictionaryIDs());
+}
+
 void checkExecutionMessage(bcostars::protocol::ExecutionMessageImpl::Ptr executionMsg,
     bcostars::protocol::ExecutionMessageImpl::Ptr anotherExecutionMsg)
 {
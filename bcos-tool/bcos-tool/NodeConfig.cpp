@@ -623,11 +623,18 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
     m_storagePath = _pt.get<std::string>("storage.data_path", "data/" + m_groupId);
     m_storageType = _pt.get<std::string>("storage.type", "RocksDB");
     m_keyPageSize = _pt.get<int32_t>("storage.key_page_size", 10240);
+    // The binary pages can't be read by the nodes of the older versions, enable it only after all
+    // the nodes are upgraded, the boost archive pages are always readable
+    m_keyPageBinaryFormat = _pt.get<bool>("storage.key_page_binary_format", false);
     m_maxWriteBufferNumber = _pt.get<int32_t>("storage.max_write_buffer_number", 4);
     m_maxBackgroundJobs = _pt.get<int32_t>("storage.max_background_jobs", 4);
     m_writeBufferSize = _pt.get<size_t>("storage.write_buffer_size", 64 << 20);
     m_minWriteBufferNumberToMerge = _pt.get<int32_t>("storage.min_write_buffer_number_to_merge", 1);
     m_blockCacheSize = _pt.get<size_t>("storage.block_cache_size", 128 << 20);
+    m_enableColumnFamilies = _pt.get<bool>("storage.enable_column_families", false);
+    m_stateBlockCacheSize = _pt.get<size_t>("storage.state_block_cache_size", 128 << 20);
+    m_codeBlockCacheSize = _pt.get<size_t>("storage.code_block_cache_size", 32 << 20);
+    m_ledgerBlockCacheSize = _pt.get<size_t>("storage.ledger_block_cache_size", 32 << 20);
     m_enableDBStatistics = _pt.get<bool>("storage.enable_statistics", false);
     m_pdCaPath = _pt.get<std::string>("storage.pd_ssl_ca_path", "");
     m_pdCertPath = _pt.get<std::string>("storage.pd_ssl_cert_path", "");
@@ -650,7 +657,9 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
     m_cacheSize = _pt.get<ssize_t>("storage.cache_size", DEFAULT_CACHE_SIZE);
     g_BCOSConfig.setStorageType(m_storageType);  // Set storageType to global
     NodeConfig_LOG(INFO) << LOG_DESC("loadStorageConfig") << LOG_KV("storagePath", m_storagePath)
-                         << LOG_KV("KeyPage", m_keyPageSize) << LOG_KV("storageType", m_storageType)
+                         << LOG_KV("KeyPage", m_keyPageSize)
+                         << LOG_KV("keyPageBinaryFormat", m_keyPageBinaryFormat)
+                         << LOG_KV("storageType", m_storageType)
                          << LOG_KV("pdAddrs", pd_addrs) << LOG_KV("pdCaPath", m_pdCaPath)
                          << LOG_KV("enableArchive", m_enableArchive)
                          << LOG_KV("archiveListenIP", m_archiveListenIP)
@@ -694,17 +703,37 @@ void NodeConfig::loadOthersConfig(boost::property_tree::ptree const& _pt)
 {
     m_sendTxTimeout = _pt.get<int>("others.send_tx_timeout", -1);
     m_vmCacheSize = _pt.get<int>("executor.vm_cache_size", 1024);
+    // Executions of a contract on the baseline interpreter before the advanced analysis, only for
+    // the baseline scheduler, 0 always uses the advanced analysis
+    m_vmPromoteThreshold = _pt.get<size_t>("executor.vm_promote_threshold", 0);
     m_enableBaselineScheduler = _pt.get<bool>("executor.baseline_scheduler", false);
     m_baselineSchedulerConfig.chunkSize =
         _pt.get<int>("executor.baseline_scheduler_chunksize", 1000);
     m_baselineSchedulerConfig.maxThread = _pt.get<int>("executor.baseline_scheduler_maxthread", 16);
     m_baselineSchedulerConfig.parallel =
         _pt.get<bool>("executor.baseline_scheduler_parallel", false);
+    // Adjust the chunk size of the parallel baseline scheduler by the conflicts of each pass, and
+    // execute the rest of the block serially when most chunks abort
+    m_baselineSchedulerConfig.adaptive =
+        _pt.get<bool>("executor.baseline_scheduler_adaptive", false);
+    // Compact the read layers of the blocks not committed yet in background when there are more
+    // than the threshold, 0 to disable
+    m_baselineSchedulerConfig.compactionThreshold =
+        _pt.get<size_t>("executor.baseline_scheduler_compaction_threshold", 0);
+    // Load the state keys the transactions of a block read first into the cache with one backend
+    // read before executing the block, on by default
+    m_baselineSchedulerConfig.prefetch =
+        _pt.get<bool>("executor.baseline_scheduler_prefetch", true);
 
     m_tarsRPCConfig.configPath = _pt.get<std::string>("rpc.tars_rpc_config", "");
 
     NodeConfig_LOG(INFO) << LOG_DESC("loadOthersConfig") << LOG_KV("sendTxTimeout", m_sendTxTimeout)
-                         << LOG_KV("vmCacheSize", m_vmCacheSize);
+                         << LOG_KV("vmCacheSize", m_vmCacheSize)
+                         << LOG_KV("vmPromoteThreshold", m_vmPromoteThreshold)
+                         << LOG_KV("baselineSchedulerAdaptive", m_baselineSchedulerConfig.adaptive)
+                         << LOG_KV("baselineSchedulerCompactionThreshold",
+                                m_baselineSchedulerConfig.compactionThreshold)
+                         << LOG_KV("baselineSchedulerPrefetch", m_baselineSchedulerConfig.prefetch);
 }
 
 void NodeConfig::loadConsensusConfig(boost::property_tree::ptree const& _pt)
@@ -123,12 +123,17 @@ public:
     std::string const& storagePath() const { return m_storagePath; }
     std::string const& storageType() const { return m_storageType; }
     size_t keyPageSize() const { return m_keyPageSize; }
+    bool keyPageBinaryFormat() const { return m_keyPageBinaryFormat; }
     int maxWriteBufferNumber() const { return m_maxWriteBufferNumber; }
     bool enableStatistics() const { return m_enableDBStatistics; }
     int maxBackgroundJobs() const { return m_maxBackgroundJobs; }
     size_t writeBufferSize() const { return m_writeBufferSize; }
     int minWriteBufferNumberToMerge() const { return m_minWriteBufferNumberToMerge; }
     size_t blockCacheSize() const { return m_blockCacheSize; }
+    bool enableColumnFamilies() const { return m_enableColumnFamilies; }
+    size_t stateBlockCacheSize() const { return m_stateBlockCacheSize; }
+    size_t codeBlockCacheSize() const { return m_codeBlockCacheSize; }
+    size_t ledgerBlockCacheSize() const { return m_ledgerBlockCacheSize; }
     std::vector<std::string> const& pdAddrs() const { return m_pd_addrs; }
     std::string const& pdCaPath() const { return m_pdCaPath; }
     std::string const& pdCertPath() const { return m_pdCertPath; }
@@ -151,6 +156,7 @@ public:
     bool isAuthCheck() const { return m_isAuthCheck; }
     bool isSerialExecute() const { return m_isSerialExecute; }
     size_t vmCacheSize() const { return m_vmCacheSize; }
+    size_t vmPromoteThreshold() const { return m_vmPromoteThreshold; }
 
     std::string const& authAdminAddress() const { return m_authAdminAddress; }
 
@@ -242,6 +248,9 @@ public:
         int parallel = 0;
         int chunkSize = 0;
         int maxThread = 0;
+        bool adaptive = false;
+        size_t compactionThreshold = 0;
+        bool prefetch = true;
     };
     BaselineSchedulerConfig const& baselineSchedulerConfig() const
     {
@@ -339,6 +348,7 @@ private:
     std::string m_storagePath;
     std::string m_storageType = "RocksDB";
     size_t m_keyPageSize = 10240;
+    bool m_keyPageBinaryFormat = false;
     std::vector<std::string> m_pd_addrs;
     std::string m_pdCaPath;
     std::string m_pdCertPath;
@@ -349,6 +359,10 @@ private:
     size_t m_writeBufferSize = 64 << 21;
     int m_minWriteBufferNumberToMerge = 2;
     size_t m_blockCacheSize = 128 << 20;
+    bool m_enableColumnFamilies = false;
+    size_t m_stateBlockCacheSize = 128 << 20;
+    size_t m_codeBlockCacheSize = 32 << 20;
+    size_t m_ledgerBlockCacheSize = 32 << 20;
 
     bool m_enableArchive = false;
     std::string m_archiveListenIP;
@@ -362,6 +376,7 @@ private:
     bool m_isAuthCheck = false;
     bool m_isSerialExecute = false;
     size_t m_vmCacheSize = 1024;
+    size_t m_vmPromoteThreshold = 0;
     std::string m_authAdminAddress;
     bool m_enableBaselineScheduler = false;
     BaselineSchedulerConfig m_baselineSchedulerConfig;
@@ -34,6 +34,13 @@ public:
     virtual bcos::protocol::TransactionStatus verify(bcos::protocol::Transaction::ConstPtr _tx) = 0;
     virtual bcos::protocol::TransactionStatus submittedToChain(
         bcos::protocol::Transaction::ConstPtr _tx) = 0;
+    // check the signature only, a verified tx is not recovered again in verify(), so the
+    // signatures of a batch can be checked in parallel before verify() them one by one
+    virtual bcos::protocol::TransactionStatus checkSignature(
+        [[maybe_unused]] bcos::protocol::Transaction::ConstPtr _tx)
+    {
+        return bcos::protocol::TransactionStatus::None;
+    }
     virtual NonceCheckerInterface::Ptr ledgerNonceChecker() { return m_ledgerNonceChecker; }
     virtual void setLedgerNonceChecker(NonceCheckerInterface::Ptr _ledgerNonceChecker)
     {
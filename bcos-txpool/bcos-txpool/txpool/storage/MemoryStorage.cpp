@@ -27,6 +27,7 @@
 #include <boost/throw_exception.hpp>
 #include <memory>
 #include <tuple>
+#include <unordered_set>
 #include <variant>
 
 using namespace bcos;
@@ -55,18 +56,31 @@ MemoryStorage::MemoryStorage(
     m_inRateCollector.start();
     m_sealRateCollector.start();
     m_removeRateCollector.start();
+    m_admitNotifier =
+        std::make_shared<ThreadPool>("txAdmitNotify", std::max(_notifyWorkerNum, (size_t)1));
+    m_admissionQueue = std::make_unique<TxAdmissionQueue>(m_config->txValidator(),
+        [this](std::vector<TxAdmissionQueue::Item>& _items,
+            std::vector<TransactionStatus> const& _signatureStatus) {
+            admitTransactions(_items, _signatureStatus);
+        });
     TXPOOL_LOG(INFO) << LOG_DESC("init MemoryStorage of txpool")
                      << LOG_KV("txNotifierWorkerNum", _notifyWorkerNum)
                      << LOG_KV("txsExpirationTime", m_txsExpirationTime)
                      << LOG_KV("poolLimit", m_config->poolLimit());
 }
 
+MemoryStorage::~MemoryStorage()
+{
+    m_admissionQueue->stop();
+}
+
 void MemoryStorage::start()
 {
     if (m_cleanUpTimer)
     {
         m_cleanUpTimer->start();
     }
+    m_admissionQueue->start();
 }
 
 void MemoryStorage::stop()
@@ -75,6 +89,7 @@ void MemoryStorage::stop()
     {
         m_cleanUpTimer->stop();
     }
+    m_admissionQueue->stop();
 }
 
 task::Task<protocol::TransactionSubmitResult::Ptr> MemoryStorage::submitTransaction(
@@ -88,8 +103,7 @@ task::Task<protocol::TransactionSubmitResult::Ptr> MemoryStorage::submitTransact
         {
             try
             {
-                auto result = m_self->verifyAndSubmitTransaction(
-                    std::move(m_transaction),
+                TxSubmitCallback submitCallback =
                     [this, m_handle = handle](Error::Ptr error,
                         bcos::protocol::TransactionSubmitResult::Ptr result) mutable {
                         if (error)
@@ -105,16 +119,26 @@ task::Task<protocol::TransactionSubmitResult::Ptr> MemoryStorage::submitTransact
                         {
                             m_handle.resume();
                         }
-                    },
-                    true, true);
-
-                if (result != TransactionStatus::None)
-                {
+                    };
+                auto onAdmitted = [this, handle](TransactionStatus result) {
                     TXPOOL_LOG(DEBUG) << "Submit transaction error! " << result;
                     m_submitResult.emplace<Error::Ptr>(
                         BCOS_ERROR_PTR((int32_t)result, bcos::protocol::toString(result)));
                     handle.resume();
+                };
+
+                TxAdmissionQueue::Item item{.transaction = std::move(m_transaction),
+                    .submitCallback = std::move(submitCallback),
+                    .onAdmitted = std::move(onAdmitted)};
+                // verify the signature in batch on the admission thread if it is running
+                if (m_self->m_admissionQueue->push(std::move(item)))
+                {
+                    return;
                 }
+                std::vector<TxAdmissionQueue::Item> items;
+                items.emplace_back(std::move(item));
+                m_self->admitTransactions(
+                    items, m_self->m_admissionQueue->checkSignatures({items[0].transaction}));
             }
             catch (std::exception& e)
             {
@@ -217,6 +241,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
                 {
                     m_sealedTxsSize++;
                     tx->setSealed(true);
+                    m_readyQueue.erase(*tx);
                 }
                 tx->setBatchId(_tx->batchId());
                 tx->setBatchHash(_tx->batchHash());
@@ -260,6 +285,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
         {
             tx->setSealed(true);
             m_sealedTxsSize++;
+            m_readyQueue.erase(*tx);
         }
     }
     else
@@ -315,6 +341,122 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
     return result;
 }
 
+void MemoryStorage::admitTransactions(std::vector<TxAdmissionQueue::Item>& _items,
+    std::vector<TransactionStatus> const& _signatureStatus)
+{
+    std::vector<TransactionStatus> results(_signatureStatus.begin(), _signatureStatus.end());
+    std::vector<std::pair<HashType, Transaction::Ptr>> acceptedTxs;
+    acceptedTxs.reserve(_items.size());
+    // the same tx may be submitted twice in one batch, only the first one is accepted
+    std::unordered_set<HashType> acceptedHashes;
+    size_t txsSize = m_txsTable.size();
+    if (m_tpsStatstartTime == 0 && txsSize == 0)
+    {
+        m_tpsStatstartTime = utcTime();
+    }
+    // check all the txs before touching the pool, the rejected txs never reach the pool
+    for (auto&& [item, result] : RANGES::views::zip(_items, results))
+    {
+        try
+        {
+            if (result == TransactionStatus::None)
+            {
+                result = txpoolStorageCheck(*item.transaction);
+            }
+            if (result == TransactionStatus::None &&
+                acceptedHashes.contains(item.transaction->hash()))
+            {
+                result = TransactionStatus::AlreadyInTxPool;
+            }
+            if (result == TransactionStatus::None &&
+                txsSize + acceptedTxs.size() >= m_config->poolLimit())
+            {
+                result = TransactionStatus::TxPoolIsFull;
+            }
+            if (result == TransactionStatus::None)
+            {
+                // the sender has been recovered, verify() skips the signature
+                result = m_config->txValidator()->verify(item.transaction);
+                m_inRateCollector.update(1, true);
+            }
+        }
+        catch (std::exception& e)
+        {
+            TXPOOL_LOG(ERROR) << "Unexpected exception: " << boost::diagnostic_information(e);
+            result = TransactionStatus::Malformed;
+        }
+        if (result == TransactionStatus::None)
+        {
+            item.transaction->setSubmitCallback(std::move(item.submitCallback));
+            acceptedHashes.insert(item.transaction->hash());
+            acceptedTxs.emplace_back(item.transaction->hash(), item.transaction);
+        }
+    }
+
+    // insert the accepted txs in one pass, every bucket of the pool is locked once
+    std::unordered_set<HashType> insertedTxs;
+    bool insertFailed = false;
+    try
+    {
+        m_txsTable.sortByBucket(acceptedTxs);
+        m_txsTable.batchInsert(acceptedTxs,
+            [&insertedTxs](bool _inserted, HashType const& _txHash, TxsMap::WriteAccessor::Ptr) {
+                if (_inserted)
+                {
+                    insertedTxs.insert(_txHash);
+                }
+            });
+    }
+    catch (std::exception& e)
+    {
+        TXPOOL_LOG(ERROR) << LOG_DESC("admitTransactions: batch insert exception")
+                          << LOG_KV("errorInfo", boost::diagnostic_information(e));
+        insertFailed = true;
+    }
+    for (auto&& [item, result] : RANGES::views::zip(_items, results))
+    {
+        if (result != TransactionStatus::None)
+        {
+            continue;
+        }
+        if (!insertedTxs.contains(item.transaction->hash()))
+        {
+            result =
+                insertFailed ? TransactionStatus::Malformed : TransactionStatus::AlreadyInTxPool;
+            continue;
+        }
+        // in the pool, only the submitCallback resumes the submitter from now on
+        if (!item.transaction->sealed())
+        {
+            m_readyQueue.push(item.transaction);
+        }
+    }
+    if (!insertedTxs.empty())
+    {
+        try
+        {
+            m_onReady();
+            notifyUnsealedTxsSize();
+        }
+        catch (std::exception& e)
+        {
+            TXPOOL_LOG(WARNING) << LOG_DESC("admitTransactions: notify exception")
+                                << LOG_KV("errorInfo", boost::diagnostic_information(e));
+        }
+    }
+
+    // resume the rejected submitters on the notifier, not the admission thread
+    for (auto&& [item, result] : RANGES::views::zip(_items, results))
+    {
+        if (result != TransactionStatus::None)
+        {
+            m_admitNotifier->enqueue([onAdmitted = std::move(item.onAdmitted), result = result]() {
+                onAdmitted(result);
+            });
+        }
+    }
+}
+
 void MemoryStorage::notifyInvalidReceipt(
     HashType const& _txHash, TransactionStatus _status, TxSubmitCallback _txSubmitCallback)
 {
@@ -348,6 +490,10 @@ TransactionStatus MemoryStorage::insertWithoutLock(Transaction::Ptr transaction)
             return TransactionStatus::AlreadyInTxPool;
         }
     }
+    if (!transaction->sealed())
+    {
+        m_readyQueue.push(transaction);
+    }
     m_onReady();
 
     notifyUnsealedTxsSize();
@@ -374,6 +520,10 @@ void MemoryStorage::onTxRemoved(const Transaction::Ptr& _tx, bool needNotifyUnse
     {
         --m_sealedTxsSize;
     }
+    if (_tx)
+    {
+        m_readyQueue.erase(*_tx);
+    }
     if (needNotifyUnsealedTxsSize)
     {
         notifyUnsealedTxsSize();
@@ -609,7 +759,7 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
     TxsHashSetPtr _avoidTxs, bool _avoidDuplicate)
 {
     TXPOOL_LOG(INFO) << LOG_DESC("begin batchFetchTxs") << LOG_KV("pendingTxs", m_txsTable.size())
-                     << LOG_KV("limit", _txsLimit);
+                     << LOG_KV("readyTxs", m_readyQueue.size()) << LOG_KV("limit", _txsLimit);
     auto blockFactory = m_config->blockFactory();
     auto recordT = utcTime();
     auto startT = utcTime();
@@ -633,6 +783,7 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
         if (_avoidDuplicate && tx->sealed())
         {
             ++sealed;
+            m_readyQueue.erase(*tx);
             return;
         }
 
@@ -703,20 +854,26 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
         tx->setSealed(true);
         tx->setBatchId(-1);
         tx->setBatchHash(HashType());
-        m_knownLatestSealedTxHash = txHash;
+        m_readyQueue.erase(*tx);
         m_sealRateCollector.update(1, true);
     };
 
 
     if (_avoidDuplicate)
     {
-        m_txsTable.forEach<TxsMap::ReadAccessor>(
-            m_knownLatestSealedTxHash, [&](TxsMap::ReadAccessor::Ptr accessor) {
-                const auto& tx = accessor->value();
-                handleTx(tx);
-                return (_txsList->transactionsMetaDataSize() +
-                           _sysTxsList->transactionsMetaDataSize()) < _txsLimit;
-            });
+        // only the unsealed txs are in the ready queue, the cost is O(txsLimit) instead of the
+        // pool size
+        m_readyQueue.forEach([&](Transaction::Ptr const& tx) {
+            // removed from the pool between the insert and the push of the ready queue
+            if (!m_txsTable.contains(tx->hash())) [[unlikely]]
+            {
+                m_readyQueue.erase(*tx);
+                return true;
+            }
+            handleTx(tx);
+            return (_txsList->transactionsMetaDataSize() +
+                       _sysTxsList->transactionsMetaDataSize()) < _txsLimit;
+        });
     }
     else
     {
@@ -736,7 +893,8 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
                      << LOG_KV("time", (utcTime() - recordT))
                      << LOG_KV("txsSize", _txsList->transactionsMetaDataSize())
                      << LOG_KV("sysTxsSize", _sysTxsList->transactionsMetaDataSize())
-                     << LOG_KV("pendingTxs", m_txsTable.size()) << LOG_KV("limit", _txsLimit)
+                     << LOG_KV("pendingTxs", m_txsTable.size())
+                     << LOG_KV("readyTxs", m_readyQueue.size()) << LOG_KV("limit", _txsLimit)
                      << LOG_KV("fetchTxsT", fetchTxsT) << LOG_KV("lockT", lockT)
                      << LOG_KV("invalidBefore", invalidTxsSize)
                      << LOG_KV("invalidNow", m_invalidTxs.size()) << LOG_KV("sealed", sealed)
@@ -790,7 +948,9 @@ void MemoryStorage::removeInvalidTxs(bool lock)
             if (!tx)
             {
                 txs2Remove[tx2Remove] = nullptr;
+                continue;
             }
+            m_readyQueue.erase(*tx);
         }
 
         auto txs2Notify = txs2Remove | RANGES::views::filter([](auto const& tx2Remove) {
@@ -820,6 +980,7 @@ void MemoryStorage::removeInvalidTxs(bool lock)
 void MemoryStorage::clear()
 {
     m_txsTable.clear();
+    m_readyQueue.clear();
     m_invalidTxs.clear();
     m_missedTxs.clear();
     notifyUnsealedTxsSize();
@@ -918,7 +1079,11 @@ bool MemoryStorage::batchMarkTxsWithoutLock(
         {
             tx->setBatchId(_batchId);
             tx->setBatchHash(_batchHash);
-            m_knownLatestSealedTxHash = txHash;
+            m_readyQueue.erase(*tx);
+        }
+        else
+        {
+            m_readyQueue.push(tx);
         }
 #if FISCO_DEBUG
         // TODO: remove this, now just for bug tracing
@@ -950,6 +1115,11 @@ void MemoryStorage::batchMarkAllTxs(bool _sealFlag)
         {
             tx->setBatchId(-1);
             tx->setBatchHash(HashType());
+            m_readyQueue.push(tx);
+        }
+        else
+        {
+            m_readyQueue.erase(*tx);
         }
         return true;
     });
@@ -1187,9 +1357,11 @@ void MemoryStorage::batchImportTxs(TransactionsPtr _txs)
 {
     auto recordT = utcTime();
     size_t successCount = 0;
-    for (auto const& tx : *_txs)
+    // recover the senders in parallel, then verifyAndSubmitTransaction skips the signature
+    auto signatureStatus = m_admissionQueue->checkSignatures(*_txs);
+    for (auto&& [tx, status] : RANGES::views::zip(*_txs, signatureStatus))
     {
-        if (!tx || tx->invalid())
+        if (!tx || tx->invalid() || status != TransactionStatus::None)
         {
             continue;
         }
@@ -22,6 +22,8 @@
 
 #include "bcos-task/Task.h"
 #include "bcos-txpool/TxPoolConfig.h"
+#include "bcos-txpool/txpool/storage/TxAdmissionQueue.h"
+#include "bcos-txpool/txpool/storage/TxReadyQueue.h"
 #include "bcos-txpool/txpool/utilities/Common.h"
 #include <bcos-utilities/BucketMap.h>
 #include <bcos-utilities/FixedBytes.h>
@@ -57,7 +59,7 @@ public:
     // the default txsExpirationTime is 10 minutes
     explicit MemoryStorage(TxPoolConfig::Ptr _config, size_t _notifyWorkerNum = 2,
         uint64_t _txsExpirationTime = TX_DEFAULT_EXPIRATION_TIME);
-    ~MemoryStorage() override = default;
+    ~MemoryStorage() override;
 
     // New interfaces =============
     task::Task<protocol::TransactionSubmitResult::Ptr> submitTransaction(
@@ -129,6 +131,8 @@ protected:
         protocol::Transaction::Ptr transaction, protocol::TxSubmitCallback txSubmitCallback,
         bool checkPoolLimit, bool lock);
     size_t unSealedTxsSizeWithoutLock();
+    void admitTransactions(std::vector<TxAdmissionQueue::Item>& _items,
+        std::vector<bcos::protocol::TransactionStatus> const& _signatureStatus);
     bcos::protocol::TransactionStatus txpoolStorageCheck(
         const bcos::protocol::Transaction& transaction);
 
@@ -165,6 +169,9 @@ protected:
     using HashSet = BucketSet<bcos::crypto::HashType, std::hash<bcos::crypto::HashType>>;
     HashSet m_missedTxs;
 
+    // the unsealed txs in import order, batchFetchTxs only visits these
+    TxReadyQueue m_readyQueue;
+
     std::atomic<size_t> m_sealedTxsSize = {0};
 
     std::atomic<bcos::protocol::BlockNumber> m_blockNumber = {0};
@@ -183,6 +190,10 @@ protected:
     RateCollector m_sealRateCollector;
     RateCollector m_removeRateCollector;
 
-    bcos::crypto::HashType m_knownLatestSealedTxHash;
+    // resume the submitters of the rejected txs off the admission thread
+    ThreadPool::Ptr m_admitNotifier;
+    // batch the submitted txs to verify their signatures in parallel, declared last to stop it
+    // before the other members destructed
+    std::unique_ptr<TxAdmissionQueue> m_admissionQueue;
 };
 }  // namespace bcos::txpool
\ No newline at end of file
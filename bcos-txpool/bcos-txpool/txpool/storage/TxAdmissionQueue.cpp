@@ -0,0 +1,162 @@
+/**
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief batch the submitted txs and verify their signatures in parallel
+ * @file TxAdmissionQueue.cpp
+ */
+#include "bcos-txpool/txpool/storage/TxAdmissionQueue.h"
+#include <bcos-framework/txpool/TxPoolTypeDef.h>
+#include <bcos-utilities/Common.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+TxAdmissionQueue::TxAdmissionQueue(TxValidatorInterface::Ptr _validator, Admitter _admitter,
+    std::chrono::microseconds _batchWindow, int _concurrency)
+  : m_validator(std::move(_validator)),
+    m_admitter(std::move(_admitter)),
+    m_batchWindow(_batchWindow),
+    m_arena(_concurrency)
+{}
+
+TxAdmissionQueue::~TxAdmissionQueue() noexcept
+{
+    stop();
+}
+
+void TxAdmissionQueue::start()
+{
+    std::unique_lock lock(m_mutex);
+    if (m_running)
+    {
+        return;
+    }
+    m_running = true;
+    m_thread = std::thread([this]() {
+        bcos::pthread_setThreadName("txAdmission");
+        run();
+    });
+}
+
+void TxAdmissionQueue::stop()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        if (!m_running)
+        {
+            return;
+        }
+        m_running = false;
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool TxAdmissionQueue::push(Item&& _item)
+{
+    bool notify = false;
+    {
+        std::unique_lock lock(m_mutex);
+        if (!m_running)
+        {
+            return false;
+        }
+        m_pending.emplace_back(std::move(_item));
+        // wake up the admission thread for the first tx of the window and for a full batch
+        notify = m_pending.size() == 1 || m_pending.size() >= MAX_BATCH_SIZE;
+    }
+    if (notify)
+    {
+        m_condition.notify_one();
+    }
+    return true;
+}
+
+std::vector<TransactionStatus> TxAdmissionQueue::checkSignatures(
+    std::vector<Transaction::Ptr> const& _txs)
+{
+    std::vector<TransactionStatus> signatureStatus(_txs.size(), TransactionStatus::None);
+    m_arena.execute([&]() {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _txs.size()),
+            [&](tbb::blocked_range<size_t> const& range) {
+                for (auto i = range.begin(); i != range.end(); ++i)
+                {
+                    if (_txs[i] && !_txs[i]->invalid())
+                    {
+                        signatureStatus[i] = m_validator->checkSignature(_txs[i]);
+                    }
+                }
+            });
+    });
+    return signatureStatus;
+}
+
+void TxAdmissionQueue::run()
+{
+    std::vector<Item> items;
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this]() { return !m_running || !m_pending.empty(); });
+            if (m_running)
+            {
+                // collect more txs for the batch window
+                m_condition.wait_for(lock, m_batchWindow,
+                    [this]() { return !m_running || m_pending.size() >= MAX_BATCH_SIZE; });
+            }
+            if (m_pending.empty())
+            {
+                return;
+            }
+            items.swap(m_pending);
+        }
+
+        admit(items);
+        items.clear();
+    }
+}
+
+void TxAdmissionQueue::admit(std::vector<Item>& _items)
+{
+    auto startT = utcTime();
+    std::vector<Transaction::Ptr> txs;
+    txs.reserve(_items.size());
+    for (auto const& item : _items)
+    {
+        txs.emplace_back(item.transaction);
+    }
+    auto signatureStatus = checkSignatures(txs);
+    auto verifyT = utcTime() - startT;
+
+    try
+    {
+        m_admitter(_items, signatureStatus);
+    }
+    catch (std::exception const& e)
+    {
+        TXPOOL_LOG(WARNING) << LOG_DESC("admit txs exception")
+                            << LOG_KV("errorInfo", boost::diagnostic_information(e));
+    }
+    TXPOOL_LOG(DEBUG) << METRIC << LOG_DESC("admit txs") << LOG_KV("size", _items.size())
+                      << LOG_KV("verifyT", verifyT) << LOG_KV("timecost", utcTime() - startT);
+}
@@ -0,0 +1,89 @@
+/**
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief batch the submitted txs and verify their signatures in parallel
+ * @file TxAdmissionQueue.h
+ */
+#pragma once
+
+#include "bcos-txpool/txpool/interfaces/TxValidatorInterface.h"
+#include <oneapi/tbb/task_arena.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bcos::txpool
+{
+// Accumulates the submitted txs for a short window, checks the signatures of the whole batch in
+// parallel inside a tbb arena, then hands the batch to the admitter on the admission thread, so the
+// RPC threads no longer recover the senders one by one
+class TxAdmissionQueue
+{
+public:
+    constexpr static auto DEFAULT_BATCH_WINDOW = std::chrono::microseconds(200);
+    constexpr static size_t MAX_BATCH_SIZE = 4096;
+
+    struct Item
+    {
+        bcos::protocol::Transaction::Ptr transaction;
+        bcos::protocol::TxSubmitCallback submitCallback;
+        // called with the status only if the tx is rejected, the submitCallback reports the
+        // result of an inserted tx
+        std::function<void(bcos::protocol::TransactionStatus)> onAdmitted;
+    };
+    // signatureStatus[i] is the checkSignature() result of items[i]
+    using Admitter = std::function<void(std::vector<Item>& items,
+        std::vector<bcos::protocol::TransactionStatus> const& signatureStatus)>;
+
+    TxAdmissionQueue(TxValidatorInterface::Ptr _validator, Admitter _admitter,
+        std::chrono::microseconds _batchWindow = DEFAULT_BATCH_WINDOW,
+        int _concurrency = tbb::task_arena::automatic);
+    TxAdmissionQueue(const TxAdmissionQueue&) = delete;
+    TxAdmissionQueue(TxAdmissionQueue&&) = delete;
+    TxAdmissionQueue& operator=(const TxAdmissionQueue&) = delete;
+    TxAdmissionQueue& operator=(TxAdmissionQueue&&) = delete;
+    ~TxAdmissionQueue() noexcept;
+
+    void start();
+    // the pending txs are still admitted before stop() returns
+    void stop();
+
+    // return false and leave _item untouched if the queue is not running, the caller should admit
+    // the tx by itself
+    bool push(Item&& _item);
+
+    // check the signatures in parallel inside the arena, can be called from any thread
+    std::vector<bcos::protocol::TransactionStatus> checkSignatures(
+        std::vector<bcos::protocol::Transaction::Ptr> const& _txs);
+
+private:
+    void run();
+    void admit(std::vector<Item>& _items);
+
+    TxValidatorInterface::Ptr m_validator;
+    Admitter m_admitter;
+    std::chrono::microseconds m_batchWindow;
+    tbb::task_arena m_arena;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<Item> m_pending;
+    bool m_running = false;
+    std::thread m_thread;
+};
+}  // namespace bcos::txpool
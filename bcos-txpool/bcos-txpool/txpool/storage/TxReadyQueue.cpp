@@ -0,0 +1,132 @@
+/**
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the index of the unsealed txs ordered by import time
+ * @file TxReadyQueue.cpp
+ */
+#include "bcos-txpool/txpool/storage/TxReadyQueue.h"
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+TxReadyQueue::TxReadyQueue(size_t _shardsCount)
+  : m_shardsCount(std::max<size_t>(_shardsCount, 1)),
+    m_shards(std::make_unique<Shard[]>(m_shardsCount))
+{}
+
+TxReadyQueue::Shard& TxReadyQueue::getShard(crypto::HashType const& _hash) const
+{
+    return m_shards[std::hash<crypto::HashType>{}(_hash) % m_shardsCount];
+}
+
+bool TxReadyQueue::push(Transaction::Ptr _tx)
+{
+    auto hash = _tx->hash();
+    auto& shard = getShard(hash);
+    std::unique_lock lock(shard.mutex);
+    auto [it, inserted] = shard.txs.try_emplace(Key{_tx->importTime(), hash}, std::move(_tx));
+    if (inserted)
+    {
+        ++m_size;
+    }
+    return inserted;
+}
+
+bool TxReadyQueue::erase(Transaction const& _tx)
+{
+    auto hash = _tx.hash();
+    auto& shard = getShard(hash);
+    std::unique_lock lock(shard.mutex);
+    if (shard.txs.erase(Key{_tx.importTime(), hash}) == 0)
+    {
+        return false;
+    }
+    --m_size;
+    return true;
+}
+
+void TxReadyQueue::clear()
+{
+    for (size_t i = 0; i < m_shardsCount; ++i)
+    {
+        std::map<Key, Transaction::Ptr> txs;
+        {
+            std::unique_lock lock(m_shards[i].mutex);
+            txs.swap(m_shards[i].txs);
+            m_size -= txs.size();
+        }
+    }
+}
+
+void TxReadyQueue::forEach(std::function<bool(Transaction::Ptr const&)> _handler) const
+{
+    // k-way merge over the shards, every cursor holds a chunk of its shard copied after the last
+    // visited key, so the txs erased or pushed by the handler never invalidate the traversal
+    struct Cursor
+    {
+        std::vector<std::pair<Key, Transaction::Ptr>> chunk;
+        size_t offset = 0;
+    };
+    std::vector<Cursor> cursors(m_shardsCount);
+
+    auto refill = [this, &cursors](size_t _index) {
+        auto& cursor = cursors[_index];
+        auto const& shard = m_shards[_index];
+        std::unique_lock lock(shard.mutex);
+        auto it = cursor.chunk.empty() ? shard.txs.begin() :
+                                         shard.txs.upper_bound(cursor.chunk.back().first);
+        cursor.chunk.clear();
+        cursor.offset = 0;
+        for (; it != shard.txs.end() && cursor.chunk.size() < FETCH_CHUNK_SIZE; ++it)
+        {
+            cursor.chunk.emplace_back(*it);
+        }
+        return !cursor.chunk.empty();
+    };
+
+    auto greater = [&cursors](size_t _lhs, size_t _rhs) {
+        return cursors[_lhs].chunk[cursors[_lhs].offset].first >
+               cursors[_rhs].chunk[cursors[_rhs].offset].first;
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+    for (size_t i = 0; i < m_shardsCount; ++i)
+    {
+        if (refill(i))
+        {
+            heap.push(i);
+        }
+    }
+
+    while (!heap.empty())
+    {
+        auto index = heap.top();
+        heap.pop();
+        auto& cursor = cursors[index];
+        auto const& tx = cursor.chunk[cursor.offset].second;
+        if (!_handler(tx))
+        {
+            return;
+        }
+
+        if (++cursor.offset < cursor.chunk.size() || refill(index))
+        {
+            heap.push(index);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/**
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the index of the unsealed txs ordered by import time
+ * @file TxReadyQueue.h
+ */
+#pragma once
+
+#include <bcos-framework/protocol/Transaction.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace bcos::txpool
+{
+// The unsealed txs of the pool, sharded by tx hash, every shard is ordered by import time.
+// The owner removes the sealed and dropped txs eagerly, so the sealer visits only the ready txs.
+// The import time of a tx must not change while it is in the queue
+class TxReadyQueue
+{
+public:
+    constexpr static size_t DEFAULT_SHARDS_COUNT = 16;
+    // how many txs are copied out of a shard under its lock at a time
+    constexpr static size_t FETCH_CHUNK_SIZE = 64;
+
+    explicit TxReadyQueue(size_t _shardsCount = DEFAULT_SHARDS_COUNT);
+
+    // return false if the tx is already in the queue
+    bool push(bcos::protocol::Transaction::Ptr _tx);
+    // return false if the tx is not in the queue
+    bool erase(bcos::protocol::Transaction const& _tx);
+    void clear();
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    // visit the txs in ascending import time order until _handler returns false, the handler runs
+    // without any shard lock held, so it may erase or push txs
+    void forEach(std::function<bool(bcos::protocol::Transaction::Ptr const&)> _handler) const;
+
+private:
+    using Key = std::pair<int64_t, bcos::crypto::HashType>;
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::map<Key, bcos::protocol::Transaction::Ptr> txs;
+    };
+
+    Shard& getShard(bcos::crypto::HashType const& _hash) const;
+
+    size_t m_shardsCount;
+    std::unique_ptr<Shard[]> m_shards;
+    std::atomic_size_t m_size = 0;
+};
+}  // namespace bcos::txpool
@@ -51,13 +51,10 @@ TransactionStatus TxValidator::verify(bcos::protocol::Transaction::ConstPtr _tx)
         return status;
     }
     // check signature
-    try
-    {
-        _tx->verify(*m_cryptoSuite->hashImpl(), *m_cryptoSuite->signatureImpl());
-    }
-    catch (std::exception const& e)
+    status = checkSignature(_tx);
+    if (status != TransactionStatus::None)
     {
-        return TransactionStatus::InvalidSignature;
+        return status;
     }
 
     if (isSystemTransaction(_tx))
@@ -68,6 +65,19 @@ TransactionStatus TxValidator::verify(bcos::protocol::Transaction::ConstPtr _tx)
     return TransactionStatus::None;
 }
 
+TransactionStatus TxValidator::checkSignature(bcos::protocol::Transaction::ConstPtr _tx)
+{
+    try
+    {
+        _tx->verify(*m_cryptoSuite->hashImpl(), *m_cryptoSuite->signatureImpl());
+    }
+    catch (std::exception const& e)
+    {
+        return TransactionStatus::InvalidSignature;
+    }
+    return TransactionStatus::None;
+}
+
 TransactionStatus TxValidator::submittedToChain(bcos::protocol::Transaction::ConstPtr _tx)
 {
     // compare with nonces stored on-chain
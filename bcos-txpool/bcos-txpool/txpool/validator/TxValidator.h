@@ -44,6 +44,8 @@ public:
     bcos::protocol::TransactionStatus verify(bcos::protocol::Transaction::ConstPtr _tx) override;
     bcos::protocol::TransactionStatus submittedToChain(
         bcos::protocol::Transaction::ConstPtr _tx) override;
+    bcos::protocol::TransactionStatus checkSignature(
+        bcos::protocol::Transaction::ConstPtr _tx) override;
 
 protected:
     virtual inline bool isSystemTransaction(bcos::protocol::Transaction::ConstPtr const& _tx)
@@ -0,0 +1,95 @@
+#include "bcos-tars-protocol/protocol/BlockFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/BlockHeaderFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionFactoryImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h"
+#include "bcos-txpool/TxPoolConfig.h"
+#include "bcos-txpool/txpool/storage/MemoryStorage.h"
+#include "bcos-txpool/txpool/validator/LedgerNonceChecker.h"
+#include "bcos-txpool/txpool/validator/TxPoolNonceChecker.h"
+#include "bcos-txpool/txpool/validator/TxValidator.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-protocol/TransactionSubmitResultFactoryImpl.h>
+#include <benchmark/benchmark.h>
+#include <limits>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+constexpr static int64_t BLOCK_LIMIT = 1000;
+
+struct Fixture
+{
+    Fixture()
+      : cryptoSuite(std::make_shared<crypto::CryptoSuite>(
+            std::make_shared<crypto::Keccak256>(), nullptr, nullptr)),
+        blockFactory(std::make_shared<bcostars::protocol::BlockFactoryImpl>(cryptoSuite,
+            std::make_shared<bcostars::protocol::BlockHeaderFactoryImpl>(cryptoSuite),
+            std::make_shared<bcostars::protocol::TransactionFactoryImpl>(cryptoSuite),
+            std::make_shared<bcostars::protocol::TransactionReceiptFactoryImpl>(cryptoSuite)))
+    {
+        auto txpoolNonceChecker = std::make_shared<TxPoolNonceChecker>();
+        auto validator =
+            std::make_shared<TxValidator>(txpoolNonceChecker, cryptoSuite, "group0", "chain0");
+        validator->setLedgerNonceChecker(
+            std::make_shared<LedgerNonceChecker>(nullptr, 0, BLOCK_LIMIT));
+        auto config = std::make_shared<TxPoolConfig>(validator,
+            std::make_shared<TransactionSubmitResultFactoryImpl>(), blockFactory, nullptr,
+            txpoolNonceChecker, BLOCK_LIMIT, std::numeric_limits<size_t>::max());
+        storage = std::make_shared<MemoryStorage>(config);
+    }
+
+    void prepare(size_t poolSize)
+    {
+        auto importTime = utcTime();
+        for (size_t i = 0; i < poolSize; ++i)
+        {
+            auto transaction = std::make_shared<bcostars::protocol::TransactionImpl>(
+                [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); });
+            transaction->mutableInner().data.nonce = std::to_string(i);
+            transaction->mutableInner().data.blockLimit = BLOCK_LIMIT / 2;
+            transaction->calculateHash(cryptoSuite->hashImpl()->hasher());
+            transaction->setImportTime(importTime);
+            storage->insert(std::move(transaction));
+        }
+    }
+
+    crypto::CryptoSuite::Ptr cryptoSuite;
+    BlockFactory::Ptr blockFactory;
+    std::shared_ptr<MemoryStorage> storage;
+};
+
+// Latency of sealing one block, half of the pool is already sealed by the previous proposals
+static void batchFetchTxs(benchmark::State& state)
+{
+    auto poolSize = (size_t)state.range(0);
+    auto txsLimit = (size_t)state.range(1);
+
+    Fixture fixture;
+    fixture.prepare(poolSize);
+    fixture.storage->batchFetchTxs(fixture.blockFactory->createBlock(),
+        fixture.blockFactory->createBlock(), poolSize / 2, nullptr, true);
+
+    for (auto const& it : state)
+    {
+        auto txs = fixture.blockFactory->createBlock();
+        auto sysTxs = fixture.blockFactory->createBlock();
+        fixture.storage->batchFetchTxs(txs, sysTxs, txsLimit, nullptr, true);
+
+        // Give back the fetched txs for the next round
+        state.PauseTiming();
+        crypto::HashList hashes;
+        for (size_t i = 0; i < txs->transactionsMetaDataSize(); ++i)
+        {
+            hashes.emplace_back(txs->transactionHash(i));
+        }
+        fixture.storage->batchMarkTxs(hashes, -1, crypto::HashType(), false);
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(batchFetchTxs)
+    ->ArgsProduct({{10000, 100000, 500000}, {1000}})
+    ->Unit(benchmark::kMillisecond);
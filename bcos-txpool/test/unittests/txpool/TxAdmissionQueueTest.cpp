@@ -0,0 +1,122 @@
+/**
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit test for the batched admission of the txpool
+ * @file TxAdmissionQueueTest.cpp
+ */
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include "bcos-txpool/txpool/storage/TxAdmissionQueue.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <future>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+namespace bcos::test
+{
+class FakeSignatureValidator : public TxValidatorInterface
+{
+public:
+    TransactionStatus verify(Transaction::ConstPtr) override { return TransactionStatus::None; }
+    TransactionStatus submittedToChain(Transaction::ConstPtr) override
+    {
+        return TransactionStatus::None;
+    }
+    TransactionStatus checkSignature(Transaction::ConstPtr _tx) override
+    {
+        ++m_checked;
+        return _tx->nonce() == "bad" ? TransactionStatus::InvalidSignature :
+                                       TransactionStatus::None;
+    }
+
+    std::atomic_size_t m_checked = 0;
+};
+
+static Transaction::Ptr fakeAdmissionTransaction(std::string const& _nonce)
+{
+    auto transaction = std::make_shared<bcostars::protocol::TransactionImpl>(
+        [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); });
+    transaction->mutableInner().data.nonce = _nonce;
+    transaction->calculateHash(crypto::Keccak256().hasher());
+    return transaction;
+}
+
+BOOST_FIXTURE_TEST_SUITE(TxAdmissionQueueTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(batchAdmit)
+{
+    auto validator = std::make_shared<FakeSignatureValidator>();
+    std::atomic_size_t batches = 0;
+    std::atomic_size_t admitted = 0;
+    TxAdmissionQueue queue(
+        validator,
+        [&](std::vector<TxAdmissionQueue::Item>& items,
+            std::vector<TransactionStatus> const& signatureStatus) {
+            ++batches;
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                if (signatureStatus[i] == TransactionStatus::None)
+                {
+                    ++admitted;
+                }
+                items[i].onAdmitted(signatureStatus[i]);
+            }
+        },
+        std::chrono::milliseconds(20));
+
+    // not running, the caller admits the tx by itself
+    TxAdmissionQueue::Item item{.transaction = fakeAdmissionTransaction("0"),
+        .submitCallback = nullptr,
+        .onAdmitted = [](TransactionStatus) {}};
+    BOOST_CHECK(!queue.push(std::move(item)));
+    BOOST_CHECK(item.transaction);
+
+    queue.start();
+    constexpr static size_t count = 100;
+    std::vector<std::promise<TransactionStatus>> results(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        BOOST_CHECK(queue.push({.transaction = fakeAdmissionTransaction(
+                                    i % 10 == 0 ? std::string("bad") : std::to_string(i)),
+            .submitCallback = nullptr,
+            .onAdmitted = [&results, i](TransactionStatus status) {
+                results[i].set_value(status);
+            }}));
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto status = results[i].get_future().get();
+        BOOST_CHECK_EQUAL(status == TransactionStatus::InvalidSignature, i % 10 == 0);
+    }
+    BOOST_CHECK_EQUAL(validator->m_checked, count);
+    BOOST_CHECK_EQUAL(admitted, count - count / 10);
+    // all pushed inside one window
+    BOOST_CHECK_LT(batches, count);
+
+    // the pending txs are admitted before stop() returns
+    std::atomic_bool done = false;
+    BOOST_CHECK(queue.push({.transaction = fakeAdmissionTransaction("last"),
+        .submitCallback = nullptr,
+        .onAdmitted = [&done](TransactionStatus) { done = true; }}));
+    queue.stop();
+    BOOST_CHECK(done);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -75,6 +75,8 @@ public:
     FakeMemoryStorage(TxPoolConfig::Ptr _config, size_t _notifyWorkerNum = 2)
       : MemoryStorage(_config, _notifyWorkerNum)
     {}
+    using MemoryStorage::admitTransactions;
+    size_t readyTxsSize() const { return m_readyQueue.size(); }
 };
 
 class TxPoolFixture
@@ -32,6 +32,7 @@
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/test/unit_test.hpp>
 #include <exception>
+#include <future>
 using namespace bcos;
 using namespace bcos::txpool;
 using namespace bcos::protocol;
@@ -601,6 +602,51 @@ BOOST_AUTO_TEST_CASE(testSMTxPoolInitAndSubmitTransaction)
     txPoolInitAndSubmitTransactionTest(true, cryptoSuite);
 }
 
+BOOST_AUTO_TEST_CASE(admitDuplicatedTransactions)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto keyPair = signatureImpl->generateKeyPair();
+    int64_t blockLimit = 10;
+    auto faker = std::make_shared<TxPoolFixture>(keyPair->publicKey(), cryptoSuite,
+        "group_test_for_txpool", "chain_test_for_txpool", blockLimit,
+        std::make_shared<FakeGateWay>());
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+    auto txpoolConfig = faker->txpool()->txpoolConfig();
+    auto storage = std::make_shared<FakeMemoryStorage>(txpoolConfig);
+
+    // the same tx twice in one admission batch, decoded into two objects
+    auto tx = fakeTransaction(cryptoSuite, std::to_string(utcTime() + 3000000),
+        faker->ledger()->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId());
+    bcos::bytes encodedData;
+    tx->encode(encodedData);
+    auto duplicatedTx = txpoolConfig->txFactory()->createTransaction(ref(encodedData), true);
+    BOOST_CHECK_EQUAL(duplicatedTx->hash(), tx->hash());
+
+    std::promise<TransactionStatus> duplicatedResult;
+    std::vector<TxAdmissionQueue::Item> items;
+    items.emplace_back(TxAdmissionQueue::Item{.transaction = tx,
+        .submitCallback = [](Error::Ptr, TransactionSubmitResult::Ptr) {},
+        .onAdmitted = [](TransactionStatus) {}});
+    items.emplace_back(TxAdmissionQueue::Item{.transaction = duplicatedTx,
+        .submitCallback = [](Error::Ptr, TransactionSubmitResult::Ptr) {},
+        .onAdmitted = [&duplicatedResult](
+                          TransactionStatus status) { duplicatedResult.set_value(status); }});
+    storage->admitTransactions(items, {TransactionStatus::None, TransactionStatus::None});
+
+    // the later copy is rejected, only the first one is in the pool and ready to seal
+    BOOST_CHECK_EQUAL(duplicatedResult.get_future().get(), TransactionStatus::AlreadyInTxPool);
+    BOOST_CHECK_EQUAL(storage->size(), 1);
+    BOOST_CHECK_EQUAL(storage->readyTxsSize(), 1);
+    HashList missedTxs;
+    auto fetched = storage->fetchTxs(missedTxs, HashList{tx->hash()});
+    BOOST_CHECK_EQUAL(fetched->size(), 1);
+    BOOST_CHECK_EQUAL((*fetched)[0].get(), tx.get());
+    storage->clear();
+}
+
 BOOST_AUTO_TEST_CASE(fillWithSubmit)
 {
     // auto hashImpl = std::make_shared<SM3>();
@@ -0,0 +1,118 @@
+/**
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit test for the ready queue of the txpool
+ * @file TxReadyQueueTest.cpp
+ */
+#include "bcos-tars-protocol/protocol/TransactionImpl.h"
+#include "bcos-txpool/txpool/storage/TxReadyQueue.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+
+namespace bcos::test
+{
+static Transaction::Ptr fakeReadyTransaction(int64_t _importTime, std::string const& _nonce)
+{
+    auto transaction = std::make_shared<bcostars::protocol::TransactionImpl>(
+        [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); });
+    transaction->mutableInner().data.nonce = _nonce;
+    transaction->calculateHash(crypto::Keccak256().hasher());
+    transaction->setImportTime(_importTime);
+    return transaction;
+}
+
+BOOST_FIXTURE_TEST_SUITE(TxReadyQueueTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(importOrder)
+{
+    TxReadyQueue queue(4);
+    std::vector<Transaction::Ptr> txs;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        // several txs share the same import time
+        txs.emplace_back(fakeReadyTransaction(i / 3, std::to_string(i)));
+    }
+    auto shuffled = txs;
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(0));
+    for (auto const& tx : shuffled)
+    {
+        BOOST_CHECK(queue.push(tx));
+    }
+    BOOST_CHECK(!queue.push(txs[0]));
+    BOOST_CHECK_EQUAL(queue.size(), txs.size());
+
+    int64_t lastImportTime = -1;
+    size_t count = 0;
+    queue.forEach([&](Transaction::Ptr const& tx) {
+        BOOST_CHECK_GE(tx->importTime(), lastImportTime);
+        lastImportTime = tx->importTime();
+        ++count;
+        return true;
+    });
+    BOOST_CHECK_EQUAL(count, txs.size());
+
+    // stop early
+    count = 0;
+    queue.forEach([&](Transaction::Ptr const&) { return ++count < 10; });
+    BOOST_CHECK_EQUAL(count, 10);
+}
+
+BOOST_AUTO_TEST_CASE(eraseWhileVisiting)
+{
+    TxReadyQueue queue(4);
+    std::vector<Transaction::Ptr> txs;
+    for (auto i = 0; i < 500; ++i)
+    {
+        txs.emplace_back(fakeReadyTransaction(i, std::to_string(i)));
+        queue.push(txs.back());
+    }
+
+    // seal the first 100 txs like batchFetchTxs does
+    size_t count = 0;
+    queue.forEach([&](Transaction::Ptr const& tx) {
+        BOOST_CHECK(tx->hash() == txs[count]->hash());
+        BOOST_CHECK(queue.erase(*tx));
+        return ++count < 100;
+    });
+    BOOST_CHECK_EQUAL(queue.size(), 400);
+    BOOST_CHECK(!queue.erase(*txs[0]));
+
+    // the next visit starts from the first unsealed tx, pushed txs are visited in order too
+    queue.push(txs[0]);
+    std::vector<Transaction::Ptr> visited;
+    queue.forEach([&](Transaction::Ptr const& tx) {
+        visited.emplace_back(tx);
+        return true;
+    });
+    BOOST_REQUIRE_EQUAL(visited.size(), 401);
+    BOOST_CHECK(visited[0]->hash() == txs[0]->hash());
+    BOOST_CHECK(visited[1]->hash() == txs[100]->hash());
+
+    queue.clear();
+    BOOST_CHECK(queue.empty());
+    count = 0;
+    queue.forEach([&](Transaction::Ptr const&) { return ++count > 0; });
+    BOOST_CHECK_EQUAL(count, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
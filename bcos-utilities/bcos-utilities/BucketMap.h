@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Ranges.h"
 #include <tbb/concurrent_vector.h>
+#include <algorithm>
 #include <map>
 #include <queue>
 #include <range/v3/view/group_by.hpp>
@@ -304,7 +305,8 @@ public:
         forEach<WriteAccessor>(kvs, [onInsert = std::move(onInsert)](decltype(kvs.front()) kv,
                                         typename Bucket<KeyType, ValueType>::Ptr bucket,
                                         typename WriteAccessor::Ptr accessor) {
-            bucket->insert(accessor, kv);
+            auto inserted = bucket->insert(accessor, kv);
+            onInsert(inserted, kv.first, accessor);
             return true;
         });
     }
@@ -314,6 +316,15 @@ public:
         batchInsert(kvs, [](bool, const KeyType&, typename WriteAccessor::Ptr) {});
     }
 
+    // The batch operations lock a bucket once for each run of the keys in the same bucket, sort
+    // the keys by bucket first to lock every bucket only once
+    void sortByBucket(auto& keys)
+    {
+        std::stable_sort(keys.begin(), keys.end(), [this](const auto& lhs, const auto& rhs) {
+            return getBucketIndex(lhs) < getBucketIndex(rhs);
+        });
+    }
+
     void batchRemove(
         const auto& keys, std::function<void(bool, const KeyType&, const ValueType&)> onRemove)
     {
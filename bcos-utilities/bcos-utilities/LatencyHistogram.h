@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief lock free latency histogram with power of two buckets
+ * @file LatencyHistogram.h
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+namespace bcos
+{
+
+// Bucket i counts the latencies in [2^(i-1), 2^i) microseconds, bucket 0 counts 0. Percentiles
+// are the upper bounds of the buckets, i.e. accurate to a factor of 2
+class LatencyHistogram
+{
+public:
+    constexpr static size_t BUCKETS_COUNT = 40;
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram(LatencyHistogram&&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(LatencyHistogram&&) = delete;
+    ~LatencyHistogram() noexcept = default;
+
+    void record(uint64_t micros)
+    {
+        m_buckets[getBucket(micros)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(micros, std::memory_order_relaxed);
+        auto max = m_max.load(std::memory_order_relaxed);
+        while (micros > max && !m_max.compare_exchange_weak(max, micros))
+        {
+        }
+    }
+
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+    uint64_t mean() const
+    {
+        auto count = this->count();
+        return count == 0 ? 0 : m_sum.load(std::memory_order_relaxed) / count;
+    }
+
+    // percent in [0, 100]
+    uint64_t percentile(double percent) const
+    {
+        auto count = this->count();
+        if (count == 0)
+        {
+            return 0;
+        }
+        auto rank = std::max(static_cast<uint64_t>(percent / 100 * static_cast<double>(count)),
+            static_cast<uint64_t>(1));
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKETS_COUNT; ++bucket)
+        {
+            seen += m_buckets[bucket].load(std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                return std::min(getUpperBound(bucket), max());
+            }
+        }
+        return max();
+    }
+
+    void reset()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic_uint64_t, BUCKETS_COUNT> m_buckets{};
+    std::atomic_uint64_t m_count{0};
+    std::atomic_uint64_t m_sum{0};
+    std::atomic_uint64_t m_max{0};
+
+    static size_t getBucket(uint64_t micros)
+    {
+        return std::min(static_cast<size_t>(std::bit_width(micros)), BUCKETS_COUNT - 1);
+    }
+    static uint64_t getUpperBound(size_t bucket)
+    {
+        return bucket == 0 ? 0 : (static_cast<uint64_t>(1) << bucket) - 1;
+    }
+};
+
+}  // namespace bcos
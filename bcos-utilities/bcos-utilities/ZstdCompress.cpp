@@ -21,25 +21,51 @@
  * @date 2022-09-22
  */
 #include "ZstdCompress.h"
+#include "Exceptions.h"
+#include "zdict.h"
+#include <numeric>
 
 namespace bcos
 {
-bool ZstdCompress::compress(bytesConstRef inputData, bytes& compressedData, int compressionLevel)
+namespace
+{
+struct CompressContextDeleter
+{
+    void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+};
+struct DecompressContextDeleter
+{
+    void operator()(ZSTD_DCtx* context) const { ZSTD_freeDCtx(context); }
+};
+
+ZSTD_CCtx* compressContext()
+{
+    thread_local std::unique_ptr<ZSTD_CCtx, CompressContextDeleter> context(ZSTD_createCCtx());
+    return context.get();
+}
+
+ZSTD_DCtx* decompressContext()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, DecompressContextDeleter> context(
+        ZSTD_createDCtx());
+    return context.get();
+}
+
+// compressFrame(dst, dstCapacity) returns the compressed size or the zstd error code
+bool compressWith(bytesConstRef inputData, bytes& compressedData, auto&& compressFrame)
 {
     // auto start_t = utcTimeUs();
     size_t const cBuffSize = ZSTD_compressBound(inputData.size());
     compressedData.resize(cBuffSize);
-    auto compressedDataPtr = const_cast<void*>(static_cast<const void*>(&compressedData[0]));
-    auto inputDataPtr = static_cast<const void*>(inputData.data());
-    size_t const compressedSize = ZSTD_compress(
-        compressedDataPtr, cBuffSize, inputDataPtr, inputData.size(), compressionLevel);
+    size_t const compressedSize = compressFrame(compressedData.data(), cBuffSize);
     auto code = ZSTD_isError(compressedSize);
     if (code)
     {
         // if code == 1, means compress failed
         BCOS_LOG(ERROR) << LOG_BADGE("ZstdCompress")
                         << LOG_DESC("compress failed, error code check failed")
-                        << LOG_KV("code", code);
+                        << LOG_KV("code", code)
+                        << LOG_KV("error", ZSTD_getErrorName(compressedSize));
         return false;
     }
     compressedData.resize(compressedSize);
@@ -53,7 +79,8 @@ bool ZstdCompress::compress(bytesConstRef inputData, bytes& compressedData, int
     return true;
 }
 
-bool ZstdCompress::uncompress(bytesConstRef compressedData, bytes& uncompressedData)
+// decompressFrame(dst, dstCapacity) returns the uncompressed size or the zstd error code
+bool uncompressWith(bytesConstRef compressedData, bytes& uncompressedData, auto&& decompressFrame)
 {
     // auto start_t = utcTimeUs();
     size_t const cBuffSize = ZSTD_getFrameContentSize(compressedData.data(), compressedData.size());
@@ -67,17 +94,15 @@ bool ZstdCompress::uncompress(bytesConstRef compressedData, bytes& uncompressedD
     }
 
     uncompressedData.resize(cBuffSize);
-    auto uncompressedDataPtr = const_cast<void*>(static_cast<const void*>(&uncompressedData[0]));
-    auto compressedDataPtr = static_cast<const void*>(compressedData.data());
-    size_t const uncompressSize =
-        ZSTD_decompress(uncompressedDataPtr, cBuffSize, compressedDataPtr, compressedData.size());
+    size_t const uncompressSize = decompressFrame(uncompressedData.data(), cBuffSize);
     auto code = ZSTD_isError(uncompressSize);
     if (code)
     {
         // if code == 1, means uncompress failed
         BCOS_LOG(ERROR) << LOG_BADGE("ZstdUncompress")
                         << LOG_DESC("uncompress failed, error code check failed")
-                        << LOG_KV("code", code);
+                        << LOG_KV("code", code)
+                        << LOG_KV("error", ZSTD_getErrorName(uncompressSize));
         return false;
     }
     uncompressedData.resize(uncompressSize);
@@ -91,4 +116,119 @@ bool ZstdCompress::uncompress(bytesConstRef compressedData, bytes& uncompressedD
 
     return true;
 }
+}  // namespace
+
+ZstdDictionary::ZstdDictionary(bytes content)
+  : m_content(std::move(content)),
+    m_id(ZSTD_getDictID_fromDict(m_content.data(), m_content.size()))
+{
+    if (m_id == 0)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("ZstdDictionary: invalid zstd dictionary"));
+    }
+    m_decompressDictionary = ZSTD_createDDict(m_content.data(), m_content.size());
+    if (m_decompressDictionary == nullptr)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidParameter() << errinfo_comment("ZstdDictionary: load dictionary failed"));
+    }
+}
+
+ZstdDictionary::~ZstdDictionary() noexcept
+{
+    ZSTD_freeDDict(m_decompressDictionary);
+    for (auto& [level, dictionary] : m_compressDictionaries)
+    {
+        ZSTD_freeCDict(dictionary);
+    }
+}
+
+const ZSTD_CDict* ZstdDictionary::compressDictionary(int compressionLevel) const
+{
+    std::lock_guard lock(m_mutex);
+    for (auto const& [level, dictionary] : m_compressDictionaries)
+    {
+        if (level == compressionLevel)
+        {
+            return dictionary;
+        }
+    }
+    auto* dictionary = ZSTD_createCDict(m_content.data(), m_content.size(), compressionLevel);
+    if (dictionary != nullptr)
+    {
+        m_compressDictionaries.emplace_back(compressionLevel, dictionary);
+    }
+    return dictionary;
+}
+
+bytes ZstdDictionary::train(std::vector<bytes> const& samples, size_t capacity)
+{
+    bytes samplesBuffer;
+    std::vector<size_t> samplesSizes;
+    samplesSizes.reserve(samples.size());
+    samplesBuffer.reserve(std::accumulate(samples.begin(), samples.end(), size_t(0),
+        [](size_t size, bytes const& sample) { return size + sample.size(); }));
+    for (auto const& sample : samples)
+    {
+        samplesBuffer.insert(samplesBuffer.end(), sample.begin(), sample.end());
+        samplesSizes.push_back(sample.size());
+    }
+    bytes content(capacity);
+    auto size = ZDICT_trainFromBuffer(content.data(), content.size(), samplesBuffer.data(),
+        samplesSizes.data(), static_cast<unsigned>(samplesSizes.size()));
+    if (ZDICT_isError(size))
+    {
+        BCOS_LOG(WARNING) << LOG_BADGE("ZstdDictionary") << LOG_DESC("train dictionary failed")
+                          << LOG_KV("samples", samples.size())
+                          << LOG_KV("error", ZDICT_getErrorName(size));
+        return {};
+    }
+    content.resize(size);
+    return content;
+}
+
+bool ZstdCompress::compress(bytesConstRef inputData, bytes& compressedData, int compressionLevel)
+{
+    return compressWith(inputData, compressedData, [&](void* dst, size_t dstCapacity) {
+        return ZSTD_compressCCtx(compressContext(), dst, dstCapacity, inputData.data(),
+            inputData.size(), compressionLevel);
+    });
+}
+
+bool ZstdCompress::uncompress(bytesConstRef compressedData, bytes& uncompressedData)
+{
+    return uncompressWith(compressedData, uncompressedData, [&](void* dst, size_t dstCapacity) {
+        return ZSTD_decompressDCtx(
+            decompressContext(), dst, dstCapacity, compressedData.data(), compressedData.size());
+    });
+}
+
+bool ZstdCompress::compress(bytesConstRef inputData, bytes& compressedData, int compressionLevel,
+    ZstdDictionary const& dictionary)
+{
+    const auto* compressDictionary = dictionary.compressDictionary(compressionLevel);
+    if (compressDictionary == nullptr)
+    {
+        return false;
+    }
+    return compressWith(inputData, compressedData, [&](void* dst, size_t dstCapacity) {
+        return ZSTD_compress_usingCDict(compressContext(), dst, dstCapacity, inputData.data(),
+            inputData.size(), compressDictionary);
+    });
+}
+
+bool ZstdCompress::uncompress(
+    bytesConstRef compressedData, bytes& uncompressedData, ZstdDictionary const& dictionary)
+{
+    return uncompressWith(compressedData, uncompressedData, [&](void* dst, size_t dstCapacity) {
+        return ZSTD_decompress_usingDDict(decompressContext(), dst, dstCapacity,
+            compressedData.data(), compressedData.size(), dictionary.decompressDictionary());
+    });
+}
+
+uint32_t ZstdCompress::dictionaryID(bytesConstRef compressedData)
+{
+    return ZSTD_getDictID_fromFrame(compressedData.data(), compressedData.size());
+}
 }  // namespace bcos
@@ -23,15 +23,60 @@
 #pragma once
 #include "Common.h"
 #include "zstd.h"
+#include <mutex>
+#include <vector>
 
 namespace bcos
 {
 
+// zstd dictionary, e.g. trained from the recorded messages. The id is written in the frames
+// compressed with it, the peers decompress them with the dictionary of the same id
+class ZstdDictionary
+{
+public:
+    using Ptr = std::shared_ptr<ZstdDictionary>;
+    using ConstPtr = std::shared_ptr<const ZstdDictionary>;
+
+    // throws InvalidParameter if the content is not a zstd dictionary with non-zero id
+    explicit ZstdDictionary(bytes content);
+    ZstdDictionary(const ZstdDictionary&) = delete;
+    ZstdDictionary(ZstdDictionary&&) = delete;
+    ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+    ZstdDictionary& operator=(ZstdDictionary&&) = delete;
+    ~ZstdDictionary() noexcept;
+
+    uint32_t id() const { return m_id; }
+    bytes const& content() const { return m_content; }
+
+    // digested once for each level
+    const ZSTD_CDict* compressDictionary(int compressionLevel) const;
+    const ZSTD_DDict* decompressDictionary() const { return m_decompressDictionary; }
+
+    // the dictionary content trained from the samples, empty if failed
+    static bytes train(std::vector<bytes> const& samples, size_t capacity);
+
+private:
+    bytes m_content;
+    uint32_t m_id = 0;
+    ZSTD_DDict* m_decompressDictionary = nullptr;
+    mutable std::mutex m_mutex;
+    mutable std::vector<std::pair<int, ZSTD_CDict*>> m_compressDictionaries;
+};
+
+// The contexts are reused by the calls of the same thread
 class ZstdCompress
 {
 public:
     static bool compress(bytesConstRef inputData, bytes& compressedData, int compressionLevel);
     static bool uncompress(bytesConstRef compressedData, bytes& uncompressedData);
+
+    static bool compress(bytesConstRef inputData, bytes& compressedData, int compressionLevel,
+        ZstdDictionary const& dictionary);
+    static bool uncompress(
+        bytesConstRef compressedData, bytes& uncompressedData, ZstdDictionary const& dictionary);
+
+    // id of the dictionary the data compressed with, 0 if without dictionary
+    static uint32_t dictionaryID(bytesConstRef compressedData);
 };
 
 }  // namespace bcos
@@ -23,6 +23,7 @@
 #include <tbb/parallel_for.h>
 #include <boost/test/unit_test.hpp>
 #include <chrono>
+#include <set>
 #include <thread>
 
 using namespace bcos;
@@ -313,6 +314,45 @@ BOOST_AUTO_TEST_CASE(parallelTest2)
     std::cout << bucketMap.size() << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(batchInsertTest)
+{
+    using BKMap = bcos::BucketMap<int, int, std::hash<int>>;
+    using WriteAccessor = BKMap::WriteAccessor;
+
+    BKMap bucketMap(10);
+    std::vector<std::pair<int, int>> kvs;
+    for (int i = 0; i < 100; ++i)
+    {
+        kvs.emplace_back(i, i);
+    }
+    bucketMap.sortByBucket(kvs);
+    for (size_t i = 1; i < kvs.size(); ++i)
+    {
+        BOOST_CHECK_LE(kvs[i - 1].first % 10, kvs[i].first % 10);
+    }
+    std::set<int> inserted;
+    bucketMap.batchInsert(kvs, [&inserted](bool _inserted, const int& key, WriteAccessor::Ptr) {
+        BOOST_CHECK(_inserted);
+        inserted.insert(key);
+    });
+    BOOST_CHECK_EQUAL(inserted.size(), 100);
+    BOOST_CHECK_EQUAL(bucketMap.size(), 100);
+
+    // The keys already in the map are reported as not inserted
+    kvs.emplace_back(100, 100);
+    size_t insertedCount = 0;
+    bucketMap.batchInsert(
+        kvs, [&insertedCount](bool _inserted, const int& key, WriteAccessor::Ptr) {
+            if (_inserted)
+            {
+                BOOST_CHECK_EQUAL(key, 100);
+                ++insertedCount;
+            }
+        });
+    BOOST_CHECK_EQUAL(insertedCount, 1);
+    BOOST_CHECK_EQUAL(bucketMap.size(), 101);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
\ No newline at end of file
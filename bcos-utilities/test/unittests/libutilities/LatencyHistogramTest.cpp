@@ -0,0 +1,74 @@
+/**
+ *  Copyright (C) 2023 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file LatencyHistogramTest.cpp
+ */
+
+#include "bcos-utilities/LatencyHistogram.h"
+#include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <tbb/parallel_for.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace bcos;
+
+namespace bcos::test
+{
+BOOST_FIXTURE_TEST_SUITE(LatencyHistogramTest, TestPromptFixture)
+
+BOOST_AUTO_TEST_CASE(percentile)
+{
+    LatencyHistogram histogram;
+    BOOST_CHECK_EQUAL(histogram.count(), 0);
+    BOOST_CHECK_EQUAL(histogram.percentile(99), 0);
+
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        histogram.record(i);
+    }
+    BOOST_CHECK_EQUAL(histogram.count(), 100);
+    BOOST_CHECK_EQUAL(histogram.max(), 100);
+    BOOST_CHECK_EQUAL(histogram.mean(), 50);
+    // 50 is in [32, 64)
+    BOOST_CHECK_EQUAL(histogram.percentile(50), 63);
+    // Bounded by the max
+    BOOST_CHECK_EQUAL(histogram.percentile(99), 100);
+    BOOST_CHECK_EQUAL(histogram.percentile(1), 1);
+
+    histogram.record(0);
+    histogram.record(UINT64_MAX);
+    BOOST_CHECK_EQUAL(histogram.count(), 102);
+    BOOST_CHECK_EQUAL(histogram.max(), UINT64_MAX);
+
+    histogram.reset();
+    BOOST_CHECK_EQUAL(histogram.count(), 0);
+    BOOST_CHECK_EQUAL(histogram.max(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(concurrentRecord)
+{
+    LatencyHistogram histogram;
+    tbb::parallel_for(tbb::blocked_range<uint64_t>(0, 10000), [&](auto const& range) {
+        for (auto i = range.begin(); i != range.end(); ++i)
+        {
+            histogram.record(i);
+        }
+    });
+    BOOST_CHECK_EQUAL(histogram.count(), 10000);
+    BOOST_CHECK_EQUAL(histogram.max(), 9999);
+    BOOST_CHECK_EQUAL(histogram.percentile(100), 9999);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace bcos::test
@@ -16,8 +16,10 @@
  * @brief Unit tests for the ZstdCompress
  * @file ZstdCompressTest.cpp
  */
+#include "bcos-utilities/Exceptions.h"
 #include "bcos-utilities/ZstdCompress.h"
 #include "bcos-utilities/testutils/TestPromptFixture.h"
+#include <tbb/parallel_for.h>
 #include <boost/test/unit_test.hpp>
 #include <iostream>
 #include <string>
@@ -48,6 +50,70 @@ BOOST_AUTO_TEST_CASE(testZstdCompress)
     BOOST_CHECK(!retUncompressFail);
 }
 
+// small messages sharing the field names and the common prefixes
+static bytes buildSample(size_t index)
+{
+    auto sample = "{\"type\":\"txsSync\",\"groupID\":\"group0\",\"nodeID\":\"" +
+                  std::to_string(index % 7) + "a8f0c4b7e2d1\",\"number\":" +
+                  std::to_string(100000 + index) + ",\"hash\":\"0x" +
+                  std::to_string(index * 7919) + "\",\"status\":\"committed\"}";
+    return {sample.begin(), sample.end()};
+}
+
+BOOST_AUTO_TEST_CASE(testZstdDictionary)
+{
+    std::vector<bytes> samples;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        samples.emplace_back(buildSample(i));
+    }
+    auto content = ZstdDictionary::train(samples, 4096);
+    BOOST_REQUIRE(!content.empty());
+    ZstdDictionary dictionary(content);
+    BOOST_CHECK_NE(dictionary.id(), 0);
+    BOOST_CHECK(dictionary.compressDictionary(1) == dictionary.compressDictionary(1));
+
+    auto message = buildSample(12345);
+    bytes compressed;
+    bytes compressedWithDictionary;
+    bytes uncompressed;
+    BOOST_CHECK(ZstdCompress::compress(ref(message), compressed, 1));
+    BOOST_CHECK(ZstdCompress::compress(ref(message), compressedWithDictionary, 1, dictionary));
+    BOOST_CHECK_LT(compressedWithDictionary.size(), compressed.size());
+    BOOST_CHECK_EQUAL(ZstdCompress::dictionaryID(ref(compressed)), 0);
+    BOOST_CHECK_EQUAL(ZstdCompress::dictionaryID(ref(compressedWithDictionary)), dictionary.id());
+
+    BOOST_CHECK(ZstdCompress::uncompress(ref(compressedWithDictionary), uncompressed, dictionary));
+    BOOST_CHECK(uncompressed == message);
+    // the frames without dictionary are still decoded with the dictionary
+    BOOST_CHECK(ZstdCompress::uncompress(ref(compressed), uncompressed, dictionary));
+    BOOST_CHECK(uncompressed == message);
+    // the dictionary is required
+    BOOST_CHECK(!ZstdCompress::uncompress(ref(compressedWithDictionary), uncompressed));
+
+    BOOST_CHECK_THROW(ZstdDictionary(bytes(1024, 'a')), InvalidParameter);
+}
+
+BOOST_AUTO_TEST_CASE(testZstdCompressConcurrent)
+{
+    std::atomic_size_t failed = 0;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, 1000), [&](auto const& range) {
+        for (auto i = range.begin(); i != range.end(); ++i)
+        {
+            bytes payload(1000 + i, static_cast<byte>(i));
+            bytes compressed;
+            bytes uncompressed;
+            if (!ZstdCompress::compress(ref(payload), compressed, (int)(i % 5) + 1) ||
+                !ZstdCompress::uncompress(ref(compressed), uncompressed) ||
+                uncompressed != payload)
+            {
+                ++failed;
+            }
+        }
+    });
+    BOOST_CHECK_EQUAL(failed, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
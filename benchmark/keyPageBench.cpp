@@ -0,0 +1,113 @@
+#include <bcos-table/src/KeyPageStorage.h>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <tuple>
+
+using namespace bcos::storage;
+
+struct Result
+{
+    size_t encodedSize = 0;
+    int64_t encodeMS = 0;
+    int64_t readMS = 0;
+    int64_t modifyMS = 0;
+};
+
+std::string pageKeyOf(size_t index)
+{
+    return "key" + boost::lexical_cast<std::string>(100000 + index);
+}
+
+int64_t elapsedMS(std::chrono::high_resolution_clock::time_point since)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - since)
+        .count();
+}
+
+// Encode the page, load it and read one entry, load it and modify one entry, the modify decodes
+// all the entries of the page in both formats
+Result testFormat(KeyPageStorage::Page const& page, size_t entries, PageFormat format, int loop)
+{
+    Result result;
+    std::string encoded;
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (auto i = 0; i < loop; ++i)
+    {
+        encoded = page.encode(format);
+    }
+    result.encodeMS = elapsedMS(timePoint);
+    result.encodedSize = encoded.size();
+
+    auto pageKey = pageKeyOf(entries - 1);
+    size_t found = 0;
+    timePoint = std::chrono::high_resolution_clock::now();
+    for (auto i = 0; i < loop; ++i)
+    {
+        KeyPageStorage::Page loaded(encoded, pageKey);
+        if (loaded.getEntry(pageKeyOf(i % entries)))
+        {
+            ++found;
+        }
+    }
+    result.readMS = elapsedMS(timePoint);
+
+    timePoint = std::chrono::high_resolution_clock::now();
+    for (auto i = 0; i < loop; ++i)
+    {
+        KeyPageStorage::Page loaded(encoded, pageKey);
+        Entry entry;
+        entry.set("modified");
+        loaded.setEntry(pageKeyOf(i % entries), std::move(entry));
+    }
+    result.modifyMS = elapsedMS(timePoint);
+
+    if (found != (size_t)loop)
+    {
+        std::cerr << "Missing entries: " << loop - found << std::endl;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description options("KeyPage format benchmark");
+
+    // clang-format off
+    options.add_options()
+        ("entries,e", boost::program_options::value<int>()->default_value(200), "Entries of the page")
+        ("value,v", boost::program_options::value<int>()->default_value(64), "Value size of the entries")
+        ("loop,l", boost::program_options::value<int>()->default_value(10000), "Loop count of each test")
+        ;
+    // clang-format on
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+        boost::program_options::parse_command_line(argc, argv, options), vm);
+
+    auto entries = (size_t)std::max(vm["entries"].as<int>(), 1);
+    auto valueSize = (size_t)vm["value"].as<int>();
+    auto loop = vm["loop"].as<int>();
+
+    KeyPageStorage::Page page;
+    for (size_t i = 0; i < entries; ++i)
+    {
+        Entry entry;
+        entry.set(std::string(valueSize, (char)('a' + i % 26)));
+        page.setEntry(pageKeyOf(i), std::move(entry));
+    }
+
+    std::cout << "Page of " << entries << " entries, value size " << valueSize << ", loop " << loop
+              << std::endl;
+    for (auto [format, name] : {std::tuple{PageFormat::BOOST_ARCHIVE, "boost archive"},
+             std::tuple{PageFormat::BINARY_V1, "binary v1"}})
+    {
+        auto result = testFormat(page, entries, format, loop);
+        std::cout << "[" << name << "] size: " << result.encodedSize
+                  << " encode: " << result.encodeMS << "ms load and read: " << result.readMS
+                  << "ms load and modify: " << result.modifyMS << "ms" << std::endl;
+    }
+}
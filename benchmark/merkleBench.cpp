@@ -1,6 +1,7 @@
 #include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
 #include <bcos-crypto/hash/SM3.h>
 #include <bcos-crypto/hasher/OpenSSLHasher.h>
+#include <bcos-crypto/merkle/IncrementalMerkle.h>
 #include <bcos-crypto/merkle/Merkle.h>
 #include <bcos-protocol/ParallelMerkleProof.h>
 #include <bcos-utilities/FixedBytes.h>
@@ -66,13 +67,61 @@ void testNewMerkle(const std::vector<bcos::bytes>& datas)
               << std::endl;
 }
 
+void testIncrementalMerkle(const std::vector<bcos::bytes>& datas)
+{
+    constexpr static size_t proofCount = 10000;
+    bcos::crypto::merkle::IncrementalMerkle<Hasher, 16> merkle(Hasher{});
+
+    // Append one by one, each append only rehashes the path to the root
+    auto timePoint = std::chrono::high_resolution_clock::now();
+    for (auto const& data : datas)
+    {
+        merkle.append(data);
+    }
+    auto duration = std::chrono::high_resolution_clock::now() - timePoint;
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    std::cout << "Append[incremental]: " << datas.size() << " hashes " << ms << "ms "
+              << (double)datas.size() * 1000 / (double)std::max<decltype(ms)>(ms, 1) << "/s"
+              << std::endl;
+
+    // Proofs from the stored levels, compared with proofs from a generated merkle
+    auto proofs = std::min(proofCount, datas.size());
+    timePoint = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < proofs; ++i)
+    {
+        std::vector<bcos::bytes> proof;
+        merkle.generateMerkleProof(i * datas.size() / proofs, proof);
+    }
+    duration = std::chrono::high_resolution_clock::now() - timePoint;
+    ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    std::cout << "Proof[incremental]: " << proofs << " proofs " << ms << "ms" << std::endl;
+
+    bcos::crypto::merkle::Merkle<Hasher, 16> oldMerkle(Hasher{});
+    std::vector<bcos::bytes> out;
+    oldMerkle.generateMerkle(datas, out);
+    timePoint = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < proofs; ++i)
+    {
+        std::vector<bcos::bytes> proof;
+        oldMerkle.generateMerkleProof(datas, out, i * datas.size() / proofs, proof);
+    }
+    duration = std::chrono::high_resolution_clock::now() - timePoint;
+    ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    std::cout << "Proof[new]: " << proofs << " proofs " << ms << "ms" << std::endl;
+
+    std::string rootString;
+    boost::algorithm::hex_lower((char*)merkle.root().data(),
+        (char*)(merkle.root().data() + merkle.root().size()), std::back_inserter(rootString));
+    std::cout << "Root[incremental]: " << rootString << std::endl;
+}
+
 int main(int argc, char* argv[])
 {
     boost::program_options::options_description options("Merkle benchmark");
 
     // clang-format off
     options.add_options()
-        ("type,t", boost::program_options::value<int>()->default_value(0), "0 for old merkle, 1 for new merkle")
+        ("type,t", boost::program_options::value<int>()->default_value(0), "0 for old merkle, 1 for new merkle, 2 for incremental merkle")
         ("prepare,p", boost::program_options::value<int>()->default_value(0), "Prepare test data, count of hashes")
         ("filename,f", boost::program_options::value<std::string>()->default_value("merkle_test.data"), "Test data file name")
         ;
@@ -116,13 +165,17 @@ int main(int argc, char* argv[])
     }
 
     auto type = vm["type"].as<int>();
-    if (type)
-    {
-        testNewMerkle(inputDatas);
-    }
-    else
+    switch (type)
     {
+    case 0:
         testOldMerkle(inputDatas);
+        break;
+    case 2:
+        testIncrementalMerkle(inputDatas);
+        break;
+    default:
+        testNewMerkle(inputDatas);
+        break;
     }
     fileInput.close();
 }
\ No newline at end of file
@@ -5,13 +5,16 @@
 #include "bcos-framework/protocol/TransactionReceiptFactory.h"
 #include "bcos-framework/txpool/TxPoolInterface.h"
 #include "bcos-storage/bcos-storage/StateKVResolver.h"
+#include <bcos-framework/ledger/LedgerTypeDef.h>
 #include <bcos-framework/protocol/TransactionSubmitResultFactory.h>
 #include <bcos-framework/storage2/MemoryStorage.h>
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
 #include <bcos-ledger/src/libledger/LedgerImpl2.h>
 #include <bcos-storage/RocksDBStorage2.h>
 #include <bcos-storage/StateKVResolver.h>
+#include <bcos-tool/NodeConfig.h>
 #include <bcos-transaction-executor/TransactionExecutorImpl.h>
+#include <bcos-transaction-executor/vm/VMFactory.h>
 #include <bcos-transaction-scheduler/BaselineScheduler.h>
 #include <bcos-transaction-scheduler/SchedulerParallelImpl.h>
 #include <bcos-transaction-scheduler/SchedulerSerialImpl.h>
@@ -23,6 +26,9 @@ template <bcos::crypto::hasher::Hasher Hasher, bool enableParallel>
 class BaselineSchedulerInitializer
 {
 private:
+    // The keys of the most recently used code analysis kept across restarts
+    constexpr static size_t WARMUP_CODES_COUNT = 1024;
+
     using MutableStorage = storage2::memory_storage::MemoryStorage<transaction_executor::StateKey,
         transaction_executor::StateValue,
         storage2::memory_storage::Attribute(
@@ -36,6 +42,7 @@ private:
     std::shared_ptr<protocol::BlockFactory> m_blockFactory;
     std::shared_ptr<txpool::TxPoolInterface> m_txpool;
     std::shared_ptr<protocol::TransactionSubmitResultFactory> m_transactionSubmitResultFactory;
+    std::string m_codeAnalysisKeysPath;
 
     transaction_executor::TableNamePool m_tableNamePool;
     CacheStorage m_cacheStorage;
@@ -56,18 +63,68 @@ private:
 
 public:
     BaselineSchedulerInitializer(::rocksdb::DB& rocksDB,
+        storage::RocksDBColumnFamilies const* columnFamilies,
         std::shared_ptr<protocol::BlockFactory> blockFactory,
         std::shared_ptr<txpool::TxPoolInterface> txpool,
-        std::shared_ptr<protocol::TransactionSubmitResultFactory> transactionSubmitResultFactory)
+        std::shared_ptr<protocol::TransactionSubmitResultFactory> transactionSubmitResultFactory,
+        tool::NodeConfig::BaselineSchedulerConfig const& config, std::string codeAnalysisKeysPath)
       : m_blockFactory(std::move(blockFactory)),
         m_txpool(std::move(txpool)),
         m_transactionSubmitResultFactory(std::move(transactionSubmitResultFactory)),
+        m_codeAnalysisKeysPath(std::move(codeAnalysisKeysPath)),
         m_rocksDBStorage(rocksDB, storage2::rocksdb::StateKeyResolver{m_tableNamePool},
-            storage2::rocksdb::StateValueResolver{}),
+            storage2::rocksdb::StateValueResolver{}, columnFamilies),
         m_ledger(m_rocksDBStorage, *m_blockFactory, m_tableNamePool),
         m_multiLayerStorage(m_rocksDBStorage, m_cacheStorage),
         m_scheduler(m_multiLayerStorage, *m_blockFactory->receiptFactory(), m_tableNamePool)
-    {}
+    {
+        m_multiLayerStorage.setCompactionThreshold(config.compactionThreshold);
+        m_scheduler.setPrefetch(config.prefetch);
+        if constexpr (enableParallel)
+        {
+            m_scheduler.setAdaptive(config.adaptive);
+        }
+        warmupCodeAnalysis();
+    }
+    BaselineSchedulerInitializer(const BaselineSchedulerInitializer&) = delete;
+    BaselineSchedulerInitializer(BaselineSchedulerInitializer&&) = delete;
+    BaselineSchedulerInitializer& operator=(const BaselineSchedulerInitializer&) = delete;
+    BaselineSchedulerInitializer& operator=(BaselineSchedulerInitializer&&) = delete;
+    ~BaselineSchedulerInitializer() noexcept
+    {
+        using AnalysisCache = transaction_executor::VMFactory::AnalysisCache;
+        if (!AnalysisCache::saveKeys(m_codeAnalysisKeysPath,
+                AnalysisCache::instance().recentKeys(WARMUP_CODES_COUNT)))
+        {
+            BCOS_LOG(WARNING) << LOG_DESC("Save code analysis keys failed")
+                              << LOG_KV("path", m_codeAnalysisKeysPath);
+        }
+    }
+
+    // Analyze the codes used before the last shutdown, the codes stored before 3.1 in the account
+    // tables are skipped
+    void warmupCodeAnalysis()
+    {
+        using AnalysisCache = transaction_executor::VMFactory::AnalysisCache;
+        auto startT = utcTime();
+        auto keys = AnalysisCache::loadKeys(m_codeAnalysisKeysPath);
+        auto codeTable =
+            storage2::string_pool::makeStringID(m_tableNamePool, ledger::SYS_CODE_BINARY);
+        transaction_executor::VMFactory::warmup(
+            keys, [&](crypto::HashType const& codeHash) -> std::optional<std::string> {
+                auto entry = task::syncWait(storage2::readOne(m_rocksDBStorage,
+                    transaction_executor::StateKey{codeTable,
+                        std::string_view((const char*)codeHash.data(), codeHash.size())}));
+                if (!entry)
+                {
+                    return std::nullopt;
+                }
+                return std::string(entry->get());
+            });
+        BCOS_LOG(INFO) << LOG_DESC("Code analysis warmup") << LOG_KV("keys", keys.size())
+                       << LOG_KV("size", AnalysisCache::instance().stats().size)
+                       << LOG_KV("timecost", utcTime() - startT);
+    }
 
     auto buildScheduler()
     {
@@ -158,6 +158,9 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
     bcos::storage::TransactionalStorageInterface::Ptr schedulerStorage = nullptr;
     bcos::storage::TransactionalStorageInterface::Ptr consensusStorage = nullptr;
     bcos::storage::TransactionalStorageInterface::Ptr airExecutorStorage = nullptr;
+    bcos::storage::KeyPageStorage::setPageFormat(m_nodeConfig->keyPageBinaryFormat() ?
+                                                     bcos::storage::PageFormat::BINARY_V1 :
+                                                     bcos::storage::PageFormat::BOOST_ARCHIVE);
 
     if (boost::iequals(m_nodeConfig->storageType(), "RocksDB"))
     {
@@ -167,6 +170,10 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         option.writeBufferSize = m_nodeConfig->writeBufferSize();
         option.minWriteBufferNumberToMerge = m_nodeConfig->minWriteBufferNumberToMerge();
         option.blockCacheSize = m_nodeConfig->blockCacheSize();
+        option.enableColumnFamilies = m_nodeConfig->enableColumnFamilies();
+        option.columnFamilyOption.stateBlockCacheSize = m_nodeConfig->stateBlockCacheSize();
+        option.columnFamilyOption.codeBlockCacheSize = m_nodeConfig->codeBlockCacheSize();
+        option.columnFamilyOption.ledgerBlockCacheSize = m_nodeConfig->ledgerBlockCacheSize();
 
         // m_protocolInitializer->dataEncryption() will return nullptr when storage_security = false
         storage =
@@ -240,6 +247,8 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         auto hasher = m_protocolInitializer->cryptoSuite()->hashImpl()->hasher();
         bcos::transaction_executor::GlobalHashImpl::g_hashImpl =
             m_protocolInitializer->cryptoSuite()->hashImpl();
+        bcos::transaction_executor::VMFactory::setPromoteThreshold(
+            m_nodeConfig->vmPromoteThreshold());
         using Hasher = std::remove_cvref_t<decltype(hasher)>;
         auto existsRocksDB = std::dynamic_pointer_cast<storage::RocksDBStorage>(storage);
 
@@ -253,15 +262,19 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
         {
             baselineSchedulerInitializer =
                 std::make_shared<transaction_scheduler::BaselineSchedulerInitializer<Hasher, true>>(
-                    existsRocksDB->rocksDB(), m_protocolInitializer->blockFactory(),
-                    m_txpoolInitializer->txpool(), transactionSubmitResultFactory);
+                    existsRocksDB->rocksDB(), existsRocksDB->columnFamilies(),
+                    m_protocolInitializer->blockFactory(), m_txpoolInitializer->txpool(),
+                    transactionSubmitResultFactory, baselineSchedulerConfig,
+                    storagePath + c_fileSeparator + c_codeAnalysisKeysFileName);
         }
         else
         {
             baselineSchedulerInitializer = std::make_shared<
                 transaction_scheduler::BaselineSchedulerInitializer<Hasher, false>>(
-                existsRocksDB->rocksDB(), m_protocolInitializer->blockFactory(),
-                m_txpoolInitializer->txpool(), transactionSubmitResultFactory);
+                existsRocksDB->rocksDB(), existsRocksDB->columnFamilies(),
+                m_protocolInitializer->blockFactory(), m_txpoolInitializer->txpool(),
+                transactionSubmitResultFactory, baselineSchedulerConfig,
+                storagePath + c_fileSeparator + c_codeAnalysisKeysFileName);
         }
         std::visit(
             [&, this](auto& initializer) {
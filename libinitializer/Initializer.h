@@ -100,6 +100,7 @@ private:
     std::shared_ptr<bcos::scheduler::SchedulerInterface> m_scheduler;
     std::weak_ptr<bcos::executor::SwitchExecutorManager> m_switchExecutorManager;
     std::string const c_consensusStorageDBName = "consensus_log";
+    std::string const c_codeAnalysisKeysFileName = "code_analysis_keys";
     std::string const c_fileSeparator = "/";
     std::shared_ptr<bcos::archive::ArchiveService> m_archiveService = nullptr;
 
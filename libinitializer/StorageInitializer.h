@@ -23,6 +23,7 @@
  * @date 2021-10-14
  */
 #pragma once
+#include "bcos-storage/bcos-storage/RocksDBColumnFamilies.h"
 #include "bcos-storage/bcos-storage/RocksDBStorage.h"
 #include "bcos-storage/bcos-storage/TiKVStorage.h"
 #include "boost/filesystem.hpp"
@@ -42,11 +43,17 @@ struct RocksDBOption
     size_t writeBufferSize = 64 << 20;  // 64MB
     int minWriteBufferNumberToMerge = 1;
     size_t blockCacheSize = 128 << 20;  // 128MB
+    // Put the state, code and ledger tables into their own column families, for new db only, a db
+    // with data but without column families refuses to open until migrated by the storage tool. A
+    // db with the column families is always opened with them
+    bool enableColumnFamilies = false;
+    storage::ColumnFamilyOption columnFamilyOption;
 };
 
 class StorageInitializer
 {
 public:
+    // The column families is nullptr if not enabled, the deleter of the db destroys its handles
     static auto createRocksDB(
         const std::string& _path, RocksDBOption& rocksDBOption, bool _enableDBStatistics = false)
     {
@@ -95,26 +102,29 @@ public:
             throw std::runtime_error("available disk space is less than 1GB");
         }
 
-        // open DB
-        rocksdb::Status status = rocksdb::DB::Open(options, _path, &db);
+        // open DB, with the column families if the db has them
+        storage::RocksDBOpenOption openOption;
+        openOption.createColumnFamilies = rocksDBOption.enableColumnFamilies;
+        openOption.tableOptions = table_options;
+        openOption.columnFamilyOption = rocksDBOption.columnFamilyOption;
+        auto [status, uniqueDB, columnFamilies] = storage::openRocksDB(options, _path, openOption);
         if (!status.ok())
         {
             BCOS_LOG(INFO) << LOG_DESC("open rocksDB failed") << LOG_KV("error", status.ToString());
             throw std::runtime_error("open rocksDB failed, err:" + status.ToString());
         }
-        return std::unique_ptr<rocksdb::DB, std::function<void(rocksdb::DB*)>>(
-            db, [](rocksdb::DB* db) {
-                CancelAllBackgroundWork(db, true);
-                db->Close();
-                delete db;
-            });
+        BCOS_LOG(INFO) << LOG_DESC("open rocksDB")
+                       << LOG_KV("columnFamilies", columnFamilies != nullptr);
+        return std::make_tuple(std::move(uniqueDB), std::move(columnFamilies));
     }
     static bcos::storage::TransactionalStorageInterface::Ptr build(const std::string& _storagePath,
         RocksDBOption& rocksDBOption, const bcos::security::DataEncryptInterface::Ptr& _dataEncrypt,
         [[maybe_unused]] size_t keyPageSize = 0, bool _enableDBStatistics = false)
     {
-        auto unique_db = createRocksDB(_storagePath, rocksDBOption, _enableDBStatistics);
-        return std::make_shared<bcos::storage::RocksDBStorage>(std::move(unique_db), _dataEncrypt);
+        auto [unique_db, columnFamilies] =
+            createRocksDB(_storagePath, rocksDBOption, _enableDBStatistics);
+        return std::make_shared<bcos::storage::RocksDBStorage>(
+            std::move(unique_db), _dataEncrypt, std::move(columnFamilies));
     }
 
 #ifdef WITH_TIKV
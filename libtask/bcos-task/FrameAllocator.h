@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace bcos::task
+{
+
+// Thread local free lists of coroutine frames, bucketed by size class. A frame may be freed on
+// another thread than the one allocated it, it simply goes to the free list of the freeing thread
+class FrameAllocator
+{
+public:
+    constexpr static size_t SIZE_CLASS = 64;
+    constexpr static size_t SIZE_CLASS_COUNT = 16;  // Frames larger than 1KB go to the heap
+    constexpr static size_t MAX_FREE_FRAMES = 256;  // Per size class and thread
+
+    struct Stats
+    {
+        size_t frames = 0;       // All allocated frames
+        size_t allocations = 0;  // Frames allocated from the heap
+    };
+
+    static void* allocate(size_t size)
+    {
+        auto& stats = localStats();
+        ++stats.frames;
+        auto sizeClass = getSizeClass(size);
+        if (sizeClass < SIZE_CLASS_COUNT && s_poolAlive)
+        {
+            auto& pool = localPool();
+            if (auto* frame = pool.m_freeFrames[sizeClass])
+            {
+                pool.m_freeFrames[sizeClass] = frame->m_next;
+                --pool.m_freeCounts[sizeClass];
+                return frame;
+            }
+            ++stats.allocations;
+            return ::operator new((sizeClass + 1) * SIZE_CLASS);
+        }
+
+        ++stats.allocations;
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* ptr, size_t size) noexcept
+    {
+        auto sizeClass = getSizeClass(size);
+        if (sizeClass < SIZE_CLASS_COUNT && s_poolAlive)
+        {
+            auto& pool = localPool();
+            if (pool.m_freeCounts[sizeClass] < MAX_FREE_FRAMES)
+            {
+                pool.m_freeFrames[sizeClass] = new (ptr) FreeFrame{pool.m_freeFrames[sizeClass]};
+                ++pool.m_freeCounts[sizeClass];
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+    // Counters of the current thread
+    static Stats const& stats() { return localStats(); }
+
+private:
+    struct FreeFrame
+    {
+        FreeFrame* m_next = nullptr;
+    };
+    struct Pool
+    {
+        Pool() = default;
+        Pool(const Pool&) = delete;
+        Pool(Pool&&) = delete;
+        Pool& operator=(const Pool&) = delete;
+        Pool& operator=(Pool&&) = delete;
+        ~Pool() noexcept
+        {
+            // Frames freed after the thread's pool destroyed go to the heap directly
+            s_poolAlive = false;
+            for (auto* frame : m_freeFrames)
+            {
+                while (frame)
+                {
+                    auto* next = frame->m_next;
+                    ::operator delete(frame);
+                    frame = next;
+                }
+            }
+        }
+
+        std::array<FreeFrame*, SIZE_CLASS_COUNT> m_freeFrames{};
+        std::array<size_t, SIZE_CLASS_COUNT> m_freeCounts{};
+    };
+    static_assert(sizeof(FreeFrame) <= SIZE_CLASS);
+
+    static inline thread_local constinit bool s_poolAlive = true;
+
+    static size_t getSizeClass(size_t size) { return (size - 1) / SIZE_CLASS; }
+    static Pool& localPool()
+    {
+        thread_local Pool pool;
+        return pool;
+    }
+    static Stats& localStats()
+    {
+        thread_local constinit Stats stats;
+        return stats;
+    }
+};
+
+// Specialize to std::false_type to allocate the frames of Task<Value> with the global operator new
+template <class Value>
+struct UseFrameAllocator : std::true_type
+{
+};
+
+template <bool enable>
+struct FrameAllocation
+{
+};
+
+template <>
+struct FrameAllocation<true>
+{
+    static void* operator new(size_t size) { return FrameAllocator::allocate(size); }
+    static void operator delete(void* ptr, size_t size) noexcept
+    {
+        FrameAllocator::deallocate(ptr, size);
+    }
+};
+
+}  // namespace bcos::task
@@ -3,15 +3,18 @@
 #include "Task.h"
 #include "Trait.h"
 #include <oneapi/tbb/task.h>
+#include <oneapi/tbb/task_arena.h>
+#include <atomic>
 #include <exception>
-#include <optional>
 #include <type_traits>
 #include <variant>
 
 namespace bcos::task::tbb
 {
 
-// Better using inside tbb task
+// Wait a task on a tbb thread without blocking it. The task runs inline first, if it completes
+// synchronously there is no suspension at all; otherwise the calling tbb task is suspended, its
+// thread goes on with other tbb work, and it is resumed by whoever completes the task
 auto syncWait(auto&& task) -> AwaitableReturnType<std::remove_cvref_t<decltype(task)>>
     requires std::is_rvalue_reference_v<decltype(task)>
 {
@@ -21,28 +24,50 @@ auto syncWait(auto&& task) -> AwaitableReturnType<std::remove_cvref_t<decltype(t
         std::variant<std::monostate, ReturnType, std::exception_ptr>>
         value;
 
-    oneapi::tbb::task::suspend([&](oneapi::tbb::task::suspend_point tag) {
-        auto waitTask = [](Task&& task, decltype(value)& value,
-                            oneapi::tbb::task::suspend_point tag) -> task::Task<void> {
-            try
+    enum class State
+    {
+        RUNNING,
+        SUSPENDED,
+        DONE
+    };
+    std::atomic<State> state = State::RUNNING;
+    oneapi::tbb::task::suspend_point suspendPoint{};
+
+    auto waitTask = [](Task&& task, decltype(value)& value, std::atomic<State>& state,
+                        oneapi::tbb::task::suspend_point& suspendPoint) -> task::Task<void> {
+        try
+        {
+            if constexpr (std::is_void_v<typename Task::ReturnType>)
+            {
+                co_await task;
+            }
+            else
             {
-                if constexpr (std::is_void_v<typename Task::ReturnType>)
-                {
-                    co_await task;
-                }
-                else
-                {
-                    value.template emplace<ReturnType>(co_await task);
-                }
+                value.template emplace<ReturnType>(co_await task);
             }
-            catch (...)
+        }
+        catch (...)
+        {
+            value.template emplace<std::exception_ptr>(std::current_exception());
+        }
+        if (state.exchange(State::DONE, std::memory_order_acq_rel) == State::SUSPENDED)
+        {
+            oneapi::tbb::task::resume(suspendPoint);
+        }
+    }(std::forward<Task>(task), value, state, suspendPoint);
+    waitTask.start();
+
+    if (state.load(std::memory_order_acquire) != State::DONE)
+    {
+        oneapi::tbb::task::suspend([&](oneapi::tbb::task::suspend_point tag) {
+            suspendPoint = tag;
+            if (state.exchange(State::SUSPENDED, std::memory_order_acq_rel) == State::DONE)
             {
-                value.template emplace<std::exception_ptr>(std::current_exception());
+                // Completed while suspending
+                oneapi::tbb::task::resume(tag);
             }
-            oneapi::tbb::task::resume(tag);
-        }(std::forward<Task>(task), value, tag);
-        waitTask.start();
-    });
+        });
+    }
 
     if (std::holds_alternative<std::exception_ptr>(value))
     {
@@ -55,4 +80,18 @@ auto syncWait(auto&& task) -> AwaitableReturnType<std::remove_cvref_t<decltype(t
     }
 }
 
-}  // namespace bcos::task::tbb
\ No newline at end of file
+// co_await it to continue the coroutine as a task of the arena, e.g. to hop from an io thread back
+// to the tbb workers
+struct ScheduleOn
+{
+    oneapi::tbb::task_arena& m_arena;
+
+    constexpr bool await_ready() const noexcept { return false; }
+    void await_suspend(CO_STD::coroutine_handle<> handle)
+    {
+        m_arena.enqueue([handle]() { handle.resume(); });
+    }
+    constexpr void await_resume() const noexcept {}
+};
+
+}  // namespace bcos::task::tbb
@@ -1,5 +1,6 @@
 #pragma once
 #include "Coroutine.h"
+#include "FrameAllocator.h"
 #include <bcos-concepts/Exception.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/throw_exception.hpp>
@@ -82,7 +83,7 @@ public:
     Awaitable operator co_await() { return Awaitable(*static_cast<Task*>(this)); }
 
     template <class PromiseImpl>
-    struct PromiseBase
+    struct PromiseBase : public FrameAllocation<UseFrameAllocator<Value>::value>
     {
         constexpr CO_STD::suspend_always initial_suspend() const noexcept { return {}; }
         constexpr auto final_suspend() noexcept
@@ -0,0 +1,69 @@
+#include <bcos-task/TBBWait.h>
+#include <bcos-task/Task.h>
+#include <bcos-task/Wait.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace bcos::task;
+
+BOOST_AUTO_TEST_SUITE(TBBWaitTest)
+
+Task<int> syncLevel()
+{
+    co_return 100;
+}
+
+Task<int> threadLevel()
+{
+    struct Awaitable
+    {
+        constexpr bool await_ready() const { return false; }
+        void await_suspend(CO_STD::coroutine_handle<> handle)
+        {
+            std::thread([handle]() mutable {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                handle.resume();
+            }).detach();
+        }
+        constexpr int await_resume() const { return 100; }
+    };
+    co_return co_await Awaitable{};
+}
+
+BOOST_AUTO_TEST_CASE(syncWait)
+{
+    // Completed synchronously, no suspension
+    BOOST_CHECK_EQUAL(bcos::task::tbb::syncWait(syncLevel()), 100);
+
+    // Completed on other threads, the waiting tbb tasks are suspended and resumed
+    std::atomic_int total = 0;
+    oneapi::tbb::parallel_for(0, 16, [&total](int) {
+        total += bcos::task::tbb::syncWait(threadLevel());
+        total += bcos::task::tbb::syncWait(syncLevel());
+    });
+    BOOST_CHECK_EQUAL(total, 16 * 200);
+
+    BOOST_CHECK_THROW(bcos::task::tbb::syncWait([]() -> Task<int> {
+        co_await threadLevel();
+        BOOST_THROW_EXCEPTION(std::runtime_error("error"));
+    }()),
+        std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(scheduleOn)
+{
+    oneapi::tbb::task_arena arena;
+    auto threadID =
+        bcos::task::syncWait([](oneapi::tbb::task_arena& arena) -> Task<std::thread::id> {
+            co_await bcos::task::tbb::ScheduleOn{arena};
+            co_return std::this_thread::get_id();
+        }(arena));
+    BOOST_CHECK_NE(threadID, std::this_thread::get_id());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
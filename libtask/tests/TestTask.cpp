@@ -1,4 +1,5 @@
 #include "bcos-utilities/Overloaded.h"
+#include <bcos-task/FrameAllocator.h>
 #include <bcos-task/Task.h>
 #include <bcos-task/Wait.h>
 #include <tbb/task_group.h>
@@ -13,6 +14,15 @@ struct TaskFixture
     tbb::task_group taskGroup;
 };
 
+struct UnpooledValue
+{
+    int m_value = 0;
+};
+template <>
+struct bcos::task::UseFrameAllocator<UnpooledValue> : std::false_type
+{
+};
+
 BOOST_FIXTURE_TEST_SUITE(TaskTest, TaskFixture)
 
 Task<void> nothingTask()
@@ -158,17 +168,29 @@ BOOST_AUTO_TEST_CASE(referenceTask)
     BOOST_CHECK_EQUAL(std::addressof(result2), std::addressof(topNumber));
 }
 
-BOOST_AUTO_TEST_CASE(tbbScheduler)
+Task<UnpooledValue> unpooledTask()
+{
+    co_return UnpooledValue{.m_value = 1};
+}
+
+BOOST_AUTO_TEST_CASE(frameAllocator)
 {
-    // TBBScheduler tbbScheduler;
-
-    // bcos::task::syncWait(
-    //     []() -> Task<void> {
-    //         auto num = co_await level2();
-    //         co_await level3();
-    //         co_return;
-    //     }(),
-    //     &tbbScheduler);
+    // Warm up the free lists of this thread
+    BOOST_CHECK_EQUAL(bcos::task::syncWait(level2()), 10000);
+
+    auto stats = FrameAllocator::stats();
+    BOOST_CHECK_EQUAL(bcos::task::syncWait(level2()), 10000);
+    // level2, level3 and the wait task, all reused from the free lists
+    BOOST_CHECK_EQUAL(FrameAllocator::stats().frames - stats.frames, 3);
+    BOOST_CHECK_EQUAL(FrameAllocator::stats().allocations, stats.allocations);
+
+    // Frames resumed and freed on another thread
+    BOOST_CHECK_EQUAL(bcos::task::syncWait(asyncLevel1(taskGroup)), 200);
+    taskGroup.wait();
+
+    stats = FrameAllocator::stats();
+    BOOST_CHECK_EQUAL(bcos::task::syncWait(unpooledTask()).m_value, 1);
+    BOOST_CHECK_EQUAL(FrameAllocator::stats().frames - stats.frames, 1);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
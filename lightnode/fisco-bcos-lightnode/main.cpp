@@ -45,16 +45,15 @@ static auto newStorage(const std::string& path)
     options.compression = rocksdb::kZSTD;
     options.max_open_files = 512;
 
-    // open DB
-    rocksdb::DB* rocksdb = nullptr;
-    rocksdb::Status status = rocksdb::DB::Open(options, path, &rocksdb);
+    // open DB, with the column families if the db has them
+    auto [status, rocksdb, columnFamilies] = bcos::storage::openRocksDB(options, path);
     if (!status.ok())
     {
         BCOS_LOG(INFO) << LOG_DESC("open rocksDB failed") << LOG_KV("error", status.ToString());
         BOOST_THROW_EXCEPTION(std::runtime_error("open rocksDB failed, err:" + status.ToString()));
     }
     return std::make_shared<bcos::storage::RocksDBStorage>(
-        std::unique_ptr<rocksdb::DB>(rocksdb), nullptr);
+        std::move(rocksdb), nullptr, std::move(columnFamilies));
 }
 
 static auto startSyncerThread(bcos::concepts::ledger::Ledger auto fromLedger,
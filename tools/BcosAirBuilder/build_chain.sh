@@ -1244,6 +1244,9 @@ generate_config_ini() {
     ; enable_rip_protocol=false
     ; enable compression for p2p message, default: true
     ; enable_compression=false
+    ; zstd dictionary for the small p2p messages, e.g. trained by zstd --train from the
+    ; recorded payloads, only used with the peers loaded the same dictionary
+    ; compress_dictionary_path=
 
 [certificate_blacklist]
     ; crl.0 should be nodeid, nodeid's length is 512
@@ -1359,6 +1362,9 @@ generate_common_ini() {
     ; distributed rate limiter local cache percent, work with enable_distributed_ratelimit_cache, default: 20
     ; distributed_ratelimit_cache_percent=20
 
+    ; lock free sharded token bucket for the local rate limiters instead of the time window, default: false
+    ; enable_sharded_ratelimit=false
+
     ; the module that does not limit bandwidth
     ; list of all modules: raft,pbft,amop,block_sync,txs_sync,light_node,cons_txs_sync
     ;
@@ -1441,6 +1447,9 @@ generate_sm_config_ini() {
     ; enable_rip_protocol=false
     ; enable compression for p2p message, default: true
     ; enable_compression=false
+    ; zstd dictionary for the small p2p messages, e.g. trained by zstd --train from the
+    ; recorded payloads, only used with the peers loaded the same dictionary
+    ; compress_dictionary_path=
 
 [certificate_blacklist]
     ; crl.0 should be nodeid, nodeid's length is 128
@@ -122,13 +122,16 @@ po::variables_map initCommandLine(int argc, const char* argv[])
     return varMap;
 }
 
-DB* createSecondaryRocksDB(const std::string& path, const std::string& secondaryPath)
+std::tuple<RocksDBPtr, RocksDBColumnFamilies::Ptr> createSecondaryRocksDB(
+    const std::string& path, const std::string& secondaryPath)
 {
     Options options;
     options.create_if_missing = false;
     options.max_open_files = -1;
-    DB* db_secondary = nullptr;
-    Status status = DB::OpenAsSecondary(options, path, secondaryPath, &db_secondary);
+    RocksDBOpenOption openOption;
+    openOption.mode = RocksDBOpenMode::SECONDARY;
+    openOption.secondaryPath = secondaryPath;
+    auto [status, db_secondary, columnFamilies] = openRocksDB(options, path, openOption);
     if (!status.ok())
     {
         std::cout << "open rocksDB failed: " << status.ToString() << std::endl;
@@ -140,7 +143,7 @@ DB* createSecondaryRocksDB(const std::string& path, const std::string& secondary
         std::cout << "TryCatchUpWithPrimary failed: " << status.ToString() << std::endl;
         exit(1);
     }
-    return db_secondary;
+    return {std::move(db_secondary), std::move(columnFamilies)};
 }
 
 TransactionalStorageInterface::Ptr createBackendStorage(
@@ -168,9 +171,10 @@ TransactionalStorageInterface::Ptr createBackendStorage(
         }
         else
         {
-            auto* rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+            auto [rocksdb, columnFamilies] =
+                createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
             storage = std::make_shared<RocksDBStorage>(
-                std::unique_ptr<rocksdb::DB>(rocksdb), dataEncryption);
+                std::move(rocksdb), dataEncryption, std::move(columnFamilies));
         }
     }
     else if (boost::iequals(nodeConfig->storageType(), "TiKV"))
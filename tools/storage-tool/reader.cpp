@@ -102,12 +102,16 @@ int main(int argc, const char* argv[])
     cout << "tableName    : " << tableName << endl;
     // auto factory = make_shared<RocksDBAdapterFactory>(storagePath);
 
-    rocksdb::DB* db;
     rocksdb::Options options;
     options.IncreaseParallelism();
     options.OptimizeLevelStyleCompaction();
     options.create_if_missing = false;
-    rocksdb::Status s = rocksdb::DB::Open(options, storagePath, &db);
+    auto [s, db, columnFamilies] = openRocksDB(options, storagePath);
+    if (!s.ok())
+    {
+        cout << "open rocksDB failed: " << s.ToString() << endl;
+        return 1;
+    }
 
     std::string configPath("./config.ini");
     if (params.count("config"))
@@ -144,8 +148,8 @@ int main(int argc, const char* argv[])
     bcos::security::DataEncryptInterface::Ptr dataEncryption = nullptr;
     dataEncryption = std::make_shared<bcos::security::DataEncryption>(nodeConfig);
 
-    auto adapter =
-        std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), dataEncryption);
+    auto adapter = std::make_shared<RocksDBStorage>(
+        std::move(db), dataEncryption, std::move(columnFamilies));
 
     if (iterate)
     {
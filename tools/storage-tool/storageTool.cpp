@@ -77,6 +77,9 @@ po::variables_map initCommandLine(int argc, const char* argv[])
     main_options.add_options()("help,h", "help of storage tool")(
         "statistic,s", "statistic the data usage of the storage")(
         "stateSize,S", "statistic the data usage of the contracts state")(
+        "migrate_column_families",
+        "move the data of a RocksDB created without column families to the column families, "
+        "stop the node first")(
         "read,r", po::value<vector<string>>()->multitoken(), "[TableName] [Key]")("write,w",
         po::value<std::vector<std::string>>()->multitoken(),
         "[TableName] [Key] [Value]")("iterate,i", po::value<std::string>(), "[TableName]")("hex,H",
@@ -176,14 +179,16 @@ void writeKeys(std::ostream& output, const std::vector<std::string>& keys, bool
     output << (hex ? toHex(keys.back()) : keys.back()) << "]" << endl;
 }
 
-DB* createSecondaryRocksDB(
+std::tuple<RocksDBPtr, RocksDBColumnFamilies::Ptr> createSecondaryRocksDB(
     const std::string& path, const std::string& secondaryPath = "./rocksdb_secondary/")
 {
     Options options;
     options.create_if_missing = false;
     options.max_open_files = -1;
-    DB* db_secondary = nullptr;
-    Status status = DB::OpenAsSecondary(options, path, secondaryPath, &db_secondary);
+    RocksDBOpenOption openOption;
+    openOption.mode = RocksDBOpenMode::SECONDARY;
+    openOption.secondaryPath = secondaryPath;
+    auto [status, db_secondary, columnFamilies] = openRocksDB(options, path, openOption);
     if (!status.ok())
     {
         std::cout << "open rocksDB failed: " << status.ToString() << std::endl;
@@ -195,14 +200,24 @@ DB* createSecondaryRocksDB(
         std::cout << "TryCatchUpWithPrimary failed: " << status.ToString() << std::endl;
         exit(1);
     }
-    return db_secondary;
+    return {std::move(db_secondary), std::move(columnFamilies)};
 }
 
-void getTableSize(DB* db, const string_view& table)
+ColumnFamilyHandle* tableColumnFamilyHandle(
+    DB* db, RocksDBColumnFamilies const* columnFamilies, const string_view& table)
+{
+    return columnFamilies ? columnFamilies->tableHandle(table) : db->DefaultColumnFamily();
+}
+
+void getTableSize(DB* db, RocksDBColumnFamilies const* columnFamilies, const string_view& table)
 {
     std::string tableName(table);
     double size = 0;
-    rocksdb::Iterator* it = db->NewIterator(rocksdb::ReadOptions());
+    // the scan of a table name crosses the table prefixes of the state column family
+    rocksdb::ReadOptions readOptions;
+    readOptions.total_order_seek = true;
+    rocksdb::Iterator* it =
+        db->NewIterator(readOptions, tableColumnFamilyHandle(db, columnFamilies, table));
     it->Seek(tableName);
     while (it->Valid())
     {
@@ -266,9 +281,10 @@ TransactionalStorageInterface::Ptr createBackendStorage(
         }
         else
         {
-            auto* rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+            auto [rocksdb, columnFamilies] =
+                createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
             storage = std::make_shared<RocksDBStorage>(
-                std::unique_ptr<rocksdb::DB>(rocksdb), dataEncryption);
+                std::move(rocksdb), dataEncryption, std::move(columnFamilies));
         }
     }
     else if (boost::iequals(nodeConfig->storageType(), "TiKV"))
@@ -469,6 +485,31 @@ int main(int argc, const char* argv[])
     auto keyPageIgnoreTables = getKeyPageIgnoreTables(nodeConfig->compatibilityVersion());
     std::string secondaryPath = "./rocksdb_secondary/";
     std::string remoteSecondaryPath = "./rocksdb_secondary/";
+    if (params.count("migrate_column_families"))
+    {
+        if (!boost::iequals(nodeConfig->storageType(), "RocksDB"))
+        {
+            cerr << "only RocksDB has column families" << endl;
+            return 1;
+        }
+        Options options;
+        options.create_if_missing = false;
+        options.compression = rocksdb::kZSTD;
+        options.bottommost_compression = rocksdb::kZSTD;
+        RocksDBOpenOption openOption;
+        openOption.columnFamilyOption.stateBlockCacheSize = nodeConfig->stateBlockCacheSize();
+        openOption.columnFamilyOption.codeBlockCacheSize = nodeConfig->codeBlockCacheSize();
+        openOption.columnFamilyOption.ledgerBlockCacheSize = nodeConfig->ledgerBlockCacheSize();
+        auto status = migrateToColumnFamilies(options, nodeConfig->storagePath(), openOption);
+        if (!status.ok())
+        {
+            cerr << "migrate column families failed: " << status.ToString() << endl;
+            return 1;
+        }
+        cout << "migrate column families success, set storage.enable_column_families=true"
+             << endl;
+        return 0;
+    }
     if (params.count("read"))
     {  // read
         auto readParameters = params["read"].as<vector<string>>();
@@ -668,8 +709,12 @@ int main(int argc, const char* argv[])
             if (boost::iequals(nodeConfig->storageType(), "RocksDB"))
             {
                 // rocksdb
-                auto* rocksdb = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-                rocksdb::Iterator* it = rocksdb->NewIterator(rocksdb::ReadOptions());
+                auto [rocksdb, columnFamilies] =
+                    createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                rocksdb::ReadOptions readOptions;
+                readOptions.total_order_seek = true;
+                rocksdb::Iterator* it = rocksdb->NewIterator(readOptions,
+                    tableColumnFamilyHandle(rocksdb.get(), columnFamilies.get(), tableName));
                 it->Seek(tableName);
                 while (it->Valid())
                 {
@@ -740,27 +785,31 @@ int main(int argc, const char* argv[])
         {
             if (params.count("statistic") || params.count("s"))
             {  // statistics
-                auto* db = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-                getTableSize(db, storage::StorageInterface::SYS_TABLES);
-                getTableSize(db, ledger::SYS_CONSENSUS);
-                getTableSize(db, ledger::SYS_CONFIG);
-                getTableSize(db, ledger::SYS_CURRENT_STATE);
-                getTableSize(db, ledger::SYS_HASH_2_NUMBER);
-                getTableSize(db, ledger::SYS_NUMBER_2_HASH);
-                getTableSize(db, ledger::SYS_BLOCK_NUMBER_2_NONCES);
-                getTableSize(db, ledger::SYS_NUMBER_2_BLOCK_HEADER);
-                getTableSize(db, ledger::SYS_NUMBER_2_TXS);
+                auto [rocksdb, columnFamilies] =
+                    createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                auto* db = rocksdb.get();
+                auto* handles = columnFamilies.get();
+                getTableSize(db, handles, storage::StorageInterface::SYS_TABLES);
+                getTableSize(db, handles, ledger::SYS_CONSENSUS);
+                getTableSize(db, handles, ledger::SYS_CONFIG);
+                getTableSize(db, handles, ledger::SYS_CURRENT_STATE);
+                getTableSize(db, handles, ledger::SYS_HASH_2_NUMBER);
+                getTableSize(db, handles, ledger::SYS_NUMBER_2_HASH);
+                getTableSize(db, handles, ledger::SYS_BLOCK_NUMBER_2_NONCES);
+                getTableSize(db, handles, ledger::SYS_NUMBER_2_BLOCK_HEADER);
+                getTableSize(db, handles, ledger::SYS_NUMBER_2_TXS);
                 // calculate transactions data size
-                getTableSize(db, ledger::SYS_HASH_2_TX);
+                getTableSize(db, handles, ledger::SYS_HASH_2_TX);
                 // calculate receipts data size
-                getTableSize(db, ledger::SYS_HASH_2_RECEIPT);
-                getTableSize(db, ledger::SYS_CODE_BINARY);
-                getTableSize(db, ledger::SYS_CONTRACT_ABI);
+                getTableSize(db, handles, ledger::SYS_HASH_2_RECEIPT);
+                getTableSize(db, handles, ledger::SYS_CODE_BINARY);
+                getTableSize(db, handles, ledger::SYS_CONTRACT_ABI);
             }
             if (params.count("stateSize") || params.count("S"))
             {  // calculate contract data size
-                auto* db = createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
-                getTableSize(db, storage::FS_APPS);
+                auto [rocksdb, columnFamilies] =
+                    createSecondaryRocksDB(nodeConfig->storagePath(), secondaryPath);
+                getTableSize(rocksdb.get(), columnFamilies.get(), storage::FS_APPS);
             }
         }
         else if (boost::iequals(nodeConfig->storageType(), "TiKV"))
@@ -786,9 +835,10 @@ int main(int argc, const char* argv[])
         {
             auto remoteDBPath = compareParameters[1];
             std::cout << "remoteDBPath:" << remoteDBPath << std::endl;
-            auto* rocksdb = createSecondaryRocksDB(remoteDBPath, remoteSecondaryPath);
-            remoteStorage =
-                std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(rocksdb), nullptr);
+            auto [rocksdb, columnFamilies] =
+                createSecondaryRocksDB(remoteDBPath, remoteSecondaryPath);
+            remoteStorage = std::make_shared<RocksDBStorage>(
+                std::move(rocksdb), nullptr, std::move(columnFamilies));
         }
         else if (boost::iequals(DBtype, "TiKV"))
         {
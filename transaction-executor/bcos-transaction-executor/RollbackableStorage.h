@@ -2,33 +2,146 @@
 
 #include "bcos-task/Trait.h"
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
-#include <boost/container/small_vector.hpp>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
 
 namespace bcos::transaction_executor
 {
 
+// Undo log of the storage writes of a transaction. Only the first old value of a key since the
+// latest savepoint is recorded, later writes to the same key skip the pre-read of the old value
 template <StateStorage Storage>
 class Rollbackable
 {
 private:
     constexpr static size_t MOSTLY_STEPS = 7;
+    constexpr static size_t ARENA_INITIAL_SIZE = 4096;
+    constexpr static size_t MIN_SLOTS = 16;
     struct Record
     {
         StateKey key;
         std::optional<StateValue> oldValue;
     };
-    boost::container::small_vector<Record, MOSTLY_STEPS> m_records;
+
+    // The records and the slots are allocated from the arena, released at once with the
+    // transaction. The initial buffer is inline, only the transactions writing more keys than it
+    // holds allocate from the heap
+    alignas(std::max_align_t) std::array<std::byte, ARENA_INITIAL_SIZE> m_arenaBuffer;
+    std::pmr::monotonic_buffer_resource m_arena{m_arenaBuffer.data(), m_arenaBuffer.size()};
+    std::pmr::vector<Record> m_records{&m_arena};
+    // Open addressing set of the recorded keys, index of the record + 1, 0 for empty slot
+    std::pmr::vector<size_t> m_slots{&m_arena};
+    size_t m_usedSlots = 0;
+    // Records before it belong to an older savepoint, can't be reused for dedup
+    size_t m_savepointRecords = 0;
     Storage& m_storage;
 
+    size_t findRecord(StateKey const& key, size_t hash) const
+    {
+        if (m_slots.empty())
+        {
+            return 0;
+        }
+        auto mask = m_slots.size() - 1;
+        for (auto pos = hash & mask; m_slots[pos] != 0; pos = (pos + 1) & mask)
+        {
+            // Slots of the records already rollbacked are stale, check the record itself
+            auto index = m_slots[pos] - 1;
+            if (index < m_records.size() && m_records[index].key == key)
+            {
+                return m_slots[pos];
+            }
+        }
+        return 0;
+    }
+    bool captured(StateKey const& key) const
+    {
+        auto index = findRecord(key, std::hash<StateKey>{}(key));
+        return index > m_savepointRecords;
+    }
+
+    void insertSlot(size_t index)
+    {
+        auto mask = m_slots.size() - 1;
+        auto const& key = m_records[index - 1].key;
+        auto pos = std::hash<StateKey>{}(key) & mask;
+        for (; m_slots[pos] != 0; pos = (pos + 1) & mask)
+        {
+            auto slotIndex = m_slots[pos] - 1;
+            if (slotIndex < m_records.size() && m_records[slotIndex].key == key)
+            {
+                m_slots[pos] = index;
+                return;
+            }
+        }
+        m_slots[pos] = index;
+        ++m_usedSlots;
+    }
+    // Called after the record emplaced
+    void addSlot()
+    {
+        if ((m_usedSlots + 1) * 2 > m_slots.size())
+        {
+            // Rehash the records of the current savepoint only, stale slots are dropped
+            m_slots.assign(std::max(m_slots.size() * 2, MIN_SLOTS), 0);
+            m_usedSlots = 0;
+            for (auto index = m_savepointRecords; index < m_records.size(); ++index)
+            {
+                insertSlot(index + 1);
+            }
+            return;
+        }
+        insertSlot(m_records.size());
+    }
+
+    task::Task<void> storeOldValues(RANGES::input_range auto const& keys)
+    {
+        if (RANGES::all_of(keys, [this](StateKey const& key) { return captured(key); }))
+        {
+            co_return;
+        }
+
+        auto storageIt = co_await m_storage.read(keys);
+        auto keyIt = RANGES::begin(keys);
+        while (co_await storageIt.next())
+        {
+            StateKey const& key = *(keyIt++);
+            if (captured(key))
+            {
+                continue;
+            }
+            auto& record = m_records.emplace_back(Record{.key = key, .oldValue = {}});
+            if (co_await storageIt.hasValue())
+            {
+                // Update exists value, store the old value
+                record.oldValue.emplace(co_await storageIt.value());
+            }
+            addSlot();
+        }
+    }
+
 public:
     using Savepoint = int64_t;
     using Key = typename Storage::Key;
     using Value = typename Storage::Value;
 
-    Rollbackable(Storage& storage) : m_storage(storage) {}
+    Rollbackable(Storage& storage) : m_storage(storage) { m_records.reserve(MOSTLY_STEPS); }
+    Rollbackable(const Rollbackable&) = delete;
+    Rollbackable(Rollbackable&&) = delete;
+    Rollbackable& operator=(const Rollbackable&) = delete;
+    Rollbackable& operator=(Rollbackable&&) = delete;
+    ~Rollbackable() noexcept = default;
 
     Storage& storage() { return m_storage; }
     Savepoint current() const { return static_cast<int64_t>(m_records.size()); }
+    // A savepoint to rollback to, the writes after it record the old values again
+    Savepoint savepoint()
+    {
+        m_savepointRecords = m_records.size();
+        return current();
+    }
     task::Task<void> rollback(Savepoint savepoint)
     {
         for (auto index = static_cast<int64_t>(m_records.size()); index > savepoint; --index)
@@ -46,6 +159,7 @@ public:
             }
             m_records.pop_back();
         }
+        m_savepointRecords = std::min(m_savepointRecords, static_cast<size_t>(savepoint));
         co_return;
     }
 
@@ -60,19 +174,7 @@ public:
             std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values)))>>
     {
         // Store values to history
-        {
-            auto storageIt = co_await m_storage.read(keys);
-            auto keyIt = RANGES::begin(keys);
-            while (co_await storageIt.next())
-            {
-                auto& record = m_records.emplace_back(Record{.key = *(keyIt++), .oldValue = {}});
-                if (co_await storageIt.hasValue())
-                {
-                    // Update exists value, store the old value
-                    record.oldValue.emplace(co_await storageIt.value());
-                }
-            }
-        }
+        co_await storeOldValues(keys);
 
         co_return co_await m_storage.write(
             std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values));
@@ -82,23 +184,10 @@ public:
         -> task::Task<task::AwaitableReturnType<decltype(m_storage.remove(keys))>>
     {
         // Store values to history
-        {
-            auto storageIt = co_await m_storage.read(keys);
-            auto keyIt = RANGES::begin(keys);
-            while (co_await storageIt.next())
-            {
-                auto& record = m_records.emplace_back();
-                record.key = *(keyIt++);
-                if (co_await storageIt.hasValue())
-                {
-                    // Update exists value, store the old value
-                    record.oldValue.emplace(co_await storageIt.value());
-                }
-            }
-        }
+        co_await storeOldValues(keys);
 
         co_return co_await m_storage.remove(keys);
     }
 };
 
-}  // namespace bcos::transaction_executor
\ No newline at end of file
+}  // namespace bcos::transaction_executor
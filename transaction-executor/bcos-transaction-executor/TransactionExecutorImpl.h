@@ -30,7 +30,7 @@ template <StateStorage Storage>
 class TransactionExecutorImpl
 {
 private:
-    evmc_address unhexAddress(std::string_view view)
+    static evmc_address unhexAddress(std::string_view view)
     {
         if (view.empty())
         {
@@ -53,7 +53,7 @@ private:
         return address;
     }
 
-    VMFactory vmFactory;
+    VMFactory m_vmFactory;
     Storage& m_storage;
     protocol::TransactionReceiptFactory& m_receiptFactory;
     TableNamePool& m_tableNamePool;
@@ -64,6 +64,38 @@ public:
       : m_storage(storage), m_receiptFactory(receiptFactory), m_tableNamePool(tableNamePool)
     {}
 
+    VMFactory& vmFactory() { return m_vmFactory; }
+
+    // The first key the transaction reads, for the scheduler to prefetch it before execution
+    static std::optional<StateKey> prefetchKey(TableNamePool& tableNamePool,
+        protocol::IsBlockHeader auto const& blockHeader,
+        protocol::IsTransaction auto const& transaction)
+    {
+        if (transaction.to().empty())
+        {
+            return {};
+        }
+        auto tableNameID = getContractTableNameID(tableNamePool, unhexAddress(transaction.to()));
+        if (blockHeader.version() >= (uint32_t)bcos::protocol::BlockVersion::V3_1_VERSION)
+        {
+            return StateKey{tableNameID, ACCOUNT_CODE_HASH};
+        }
+        return StateKey{tableNameID, ACCOUNT_CODE};
+    }
+
+    // The key read next with the value of a prefetched key, the code of a code hash
+    static std::optional<StateKey> prefetchFollowKey(
+        TableNamePool& tableNamePool, StateKey const& key, StateValue const& value)
+    {
+        if (std::get<1>(key).toStringView() == ACCOUNT_CODE_HASH)
+        {
+            return StateKey{
+                storage2::string_pool::makeStringID(tableNamePool, ledger::SYS_CODE_BINARY),
+                value.get()};
+        }
+        return {};
+    }
+
     task::Task<protocol::TransactionReceipt::Ptr> execute(
         protocol::IsBlockHeader auto const& blockHeader,
         protocol::IsTransaction auto const& transaction, int contextID)
@@ -95,7 +127,7 @@ public:
                 transaction.sender().begin(), transaction.sender().end(), evmcMessage.sender.bytes);
 
             int64_t seq = 0;
-            HostContext hostContext(vmFactory, rollbackableStorage, m_tableNamePool, blockHeader,
+            HostContext hostContext(m_vmFactory, rollbackableStorage, m_tableNamePool, blockHeader,
                 evmcMessage, evmcMessage.sender, contextID, seq);
             auto evmcResult = co_await hostContext.execute();
             auto finallyAction = gsl::finally([&]() { releaseResult(evmcResult); });
@@ -64,6 +64,18 @@ inline evmc_bytes32 evm_hash_fn(const uint8_t* data, size_t size)
         GlobalHashImpl::g_hashImpl->hash(bytesConstRef(data, size)));
 }
 
+inline TableNameID getContractTableNameID(
+    TableNamePool& tableNamePool, const evmc_address& address)
+{
+    std::array<char, USER_APPS_PREFIX.size() + sizeof(address)> tableName;
+    std::uninitialized_copy_n(USER_APPS_PREFIX.data(), USER_APPS_PREFIX.size(), tableName.data());
+    std::uninitialized_copy_n(
+        (const char*)address.bytes, sizeof(address), tableName.data() + USER_APPS_PREFIX.size());
+
+    return storage2::string_pool::makeStringID(
+        tableNamePool, std::string_view(tableName.data(), tableName.size()));
+}
+
 template <StateStorage Storage, protocol::IsBlockHeader BlockHeader>
 class HostContext : public evmc_host_context
 {
@@ -85,14 +97,7 @@ private:
 
     TableNameID getTableNameID(const evmc_address& address)
     {
-        std::array<char, USER_APPS_PREFIX.size() + sizeof(address)> tableName;
-        std::uninitialized_copy_n(
-            USER_APPS_PREFIX.data(), USER_APPS_PREFIX.size(), tableName.data());
-        std::uninitialized_copy_n((const char*)address.bytes, sizeof(address),
-            tableName.data() + USER_APPS_PREFIX.size());
-
-        return storage2::string_pool::makeStringID(
-            m_tableNamePool, std::string_view(tableName.data(), tableName.size()));
+        return getContractTableNameID(m_tableNamePool, address);
     }
 
     TableNameID getMyContractTable(
@@ -401,7 +406,7 @@ public:
         auto mode = toRevision(vmSchedule());
         auto vmInstance = m_vmFactory.create(VMKind::evmone, createCodeHash, createCode, mode);
 
-        auto savepoint = m_rollbackableStorage.current();
+        auto savepoint = m_rollbackableStorage.savepoint();
         auto result = vmInstance.execute(
             interface, this, mode, &m_message, m_message.input_data, m_message.input_size);
         if (result.status_code != 0)
@@ -434,7 +439,7 @@ public:
         {
             auto codeHash = co_await codeHashAt(m_message.code_address);
             auto vmInstance = m_vmFactory.create(VMKind::evmone, codeHash, code, mode);
-            auto savepoint = m_rollbackableStorage.current();
+            auto savepoint = m_rollbackableStorage.savepoint();
             auto result = vmInstance.execute(
                 interface, this, mode, &m_message, (const uint8_t*)code.data(), code.size());
             if (result.status_code != 0)
@@ -447,7 +452,7 @@ public:
         else
         {
             auto vmInstance = VMFactory::create();
-            auto savepoint = m_rollbackableStorage.current();
+            auto savepoint = m_rollbackableStorage.savepoint();
             auto result = vmInstance.execute(
                 interface, this, mode, &m_message, (const uint8_t*)code.data(), code.size());
             if (result.status_code != 0)
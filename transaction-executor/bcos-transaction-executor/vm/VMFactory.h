@@ -21,10 +21,12 @@
 
 #pragma once
 #include "VMInstance.h"
-#include "bcos-framework/storage2/MemoryStorage.h"
+#include <bcos-framework/executor/CodeAnalysisCache.h>
 #include <evmone/evmone.h>
 #include <boost/throw_exception.hpp>
+#include <atomic>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -40,15 +42,45 @@ enum class VMKind
 struct UnknownVMError : public bcos::Error {};
 // clang-format on
 
+// Baseline analysis of cold code, with the count of executions before promotion
+struct BaselineCodeAnalysis
+{
+    explicit BaselineCodeAnalysis(evmone::baseline::CodeAnalysis analysis)
+      : m_analysis(std::move(analysis))
+    {}
+
+    evmone::baseline::CodeAnalysis m_analysis;
+    mutable std::atomic_size_t m_executions = 0;
+};
+
 class VMFactory
 {
+public:
+    using AnalysisCache = executor::CodeAnalysisCache<evmone::advanced::AdvancedCodeAnalysis>;
+    using BaselineAnalysisCache = executor::CodeAnalysisCache<BaselineCodeAnalysis>;
+
+    struct TieredStats
+    {
+        size_t baselineExecutions = 0;
+        size_t advancedExecutions = 0;
+        size_t promotions = 0;
+    };
+
 private:
-    storage2::memory_storage::MemoryStorage<crypto::HashType,
-        std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const>,
-        storage2::memory_storage::Attribute(
-            storage2::memory_storage::CONCURRENT | storage2::memory_storage::MRU),
-        std::hash<crypto::HashType>>
-        m_evmoneCodeAnalysisCache;
+    AnalysisCache& m_evmoneCodeAnalysisCache = AnalysisCache::instance();
+    BaselineAnalysisCache& m_baselineCodeAnalysisCache = BaselineAnalysisCache::instance();
+    inline static std::atomic_size_t s_promoteThreshold = 0;
+    std::atomic_size_t m_baselineExecutions = 0;
+    std::atomic_size_t m_advancedExecutions = 0;
+    std::atomic_size_t m_promotions = 0;
+
+    static std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const> advancedAnalyze(
+        evmc_revision mode, std::string_view code)
+    {
+        return std::make_shared<evmone::advanced::AdvancedCodeAnalysis const>(
+            evmone::advanced::analyze(
+                mode, evmone::bytes_view((const uint8_t*)code.data(), code.size())));
+    }
 
 public:
     /// Creates a VM instance of the global kind.
@@ -73,29 +105,74 @@ public:
         {
         case VMKind::evmone:
         {
-            std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const> codeAnalysis;
-            auto it = m_evmoneCodeAnalysisCache.read(storage2::singleView(codeHash)).toValue();
-            it.next().toValue();
-            if (it.hasValue().toValue())
+            executor::CodeAnalysisKey key{.codeHash = codeHash, .revision = mode};
+            auto promoteThreshold = s_promoteThreshold.load(std::memory_order_relaxed);
+            if (promoteThreshold == 0)
             {
-                codeAnalysis = it.value().toValue();
-                it.release();
+                ++m_advancedExecutions;
+                return VMInstance{m_evmoneCodeAnalysisCache.getOrAnalyze(
+                    key, [&]() { return advancedAnalyze(mode, code); })};
             }
-            else
+
+            // Tiered mode, cold code runs on the baseline interpreter until it has been executed
+            // promoteThreshold times, then is promoted to the advanced analysis
+            if (auto codeAnalysis = m_evmoneCodeAnalysisCache.get(key))
+            {
+                ++m_advancedExecutions;
+                return VMInstance{std::move(codeAnalysis)};
+            }
+            auto baselineAnalysis = m_baselineCodeAnalysisCache.getOrAnalyze(key, [&]() {
+                return std::make_shared<BaselineCodeAnalysis const>(evmone::baseline::analyze(
+                    mode, evmone::bytes_view((const uint8_t*)code.data(), code.size())));
+            });
+            if (++baselineAnalysis->m_executions < promoteThreshold)
             {
-                it.release();
-                codeAnalysis = std::make_shared<evmone::advanced::AdvancedCodeAnalysis>(
-                    evmone::advanced::analyze(
-                        mode, evmone::bytes_view((const uint8_t*)code.data(), code.size())));
-                m_evmoneCodeAnalysisCache.write(
-                    storage2::singleView(codeHash), storage2::singleView(std::as_const(codeAnalysis)));
+                ++m_baselineExecutions;
+                return VMInstance{std::shared_ptr<evmone::baseline::CodeAnalysis const>(
+                    baselineAnalysis, std::addressof(baselineAnalysis->m_analysis))};
             }
 
+            ++m_promotions;
+            ++m_advancedExecutions;
+            auto codeAnalysis = advancedAnalyze(mode, code);
+            m_evmoneCodeAnalysisCache.put(key, codeAnalysis);
+            // The baseline analysis is not used after promotion, the running instances keep it
+            m_baselineCodeAnalysisCache.remove(key);
             return VMInstance{std::move(codeAnalysis)};
         }
         default:
             BOOST_THROW_EXCEPTION(UnknownVMError{});
         }
     }
+
+    /// Run code with the baseline interpreter until it has been executed threshold times, 0 (the
+    /// default) always uses the advanced analysis. Process wide, the executors are created per
+    /// block and the execution counts are kept in the shared baseline analysis
+    static void setPromoteThreshold(size_t threshold) { s_promoteThreshold = threshold; }
+    static size_t promoteThreshold() { return s_promoteThreshold; }
+
+    /// Analyze the codes of the keys saved from AnalysisCache::recentKeys() at the last shutdown
+    /// before executing, codeLoader(codeHash) returns std::nullopt if the code is not found
+    static void warmup(std::vector<AnalysisCache::Key> const& keys, auto&& codeLoader)
+    {
+        AnalysisCache::instance().warmup(keys,
+            [&](AnalysisCache::Key const& key)
+                -> std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const> {
+                std::optional<std::string> code = codeLoader(key.codeHash);
+                if (!code || code->empty())
+                {
+                    return nullptr;
+                }
+                return advancedAnalyze((evmc_revision)key.revision, *code);
+            });
+    }
+
+    AnalysisCache::Stats stats() const { return m_evmoneCodeAnalysisCache.stats(); }
+    TieredStats tieredStats() const
+    {
+        return {.baselineExecutions = m_baselineExecutions,
+            .advancedExecutions = m_advancedExecutions,
+            .promotions = m_promotions};
+    }
 };
 }  // namespace bcos::transaction_executor
\ No newline at end of file
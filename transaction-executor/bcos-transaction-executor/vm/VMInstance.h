@@ -28,6 +28,8 @@
 #include <evmc/evmc.h>
 #include <evmone/advanced_analysis.hpp>
 #include <evmone/advanced_execution.hpp>
+#include <evmone/baseline.hpp>
+#include <evmone/vm.hpp>
 #include <variant>
 
 namespace bcos::transaction_executor
@@ -87,6 +89,11 @@ public:
                     auto state = evmone::advanced::AdvancedExecutionState(
                         *msg, rev, *host, context, std::basic_string_view<uint8_t>(code, codeSize));
                     return evmone::advanced::execute(state, *instance);
+                },
+                [&](std::shared_ptr<evmone::baseline::CodeAnalysis const> const& instance) {
+                    auto state = evmone::ExecutionState(
+                        *msg, rev, *host, context, std::basic_string_view<uint8_t>(code, codeSize));
+                    return evmone::baseline::execute(baselineVM(), state, *instance);
                 }},
             m_instance);
     }
@@ -94,7 +101,15 @@ public:
     void enableDebugOutput() {}
 
 private:
-    std::variant<evmc_vm*, std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const>>
+    // The baseline interpreter only reads the options of the vm
+    static evmone::VM& baselineVM()
+    {
+        thread_local evmone::VM vm;
+        return vm;
+    }
+
+    std::variant<evmc_vm*, std::shared_ptr<evmone::advanced::AdvancedCodeAnalysis const>,
+        std::shared_ptr<evmone::baseline::CodeAnalysis const>>
         m_instance;
 };
 
@@ -9,6 +9,7 @@
 #include <bcos-framework/storage2/MemoryStorage.h>
 #include <bcos-tars-protocol/protocol/TransactionFactoryImpl.h>
 #include <bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h>
+#include <bcos-task/FrameAllocator.h>
 #include <bcos-task/Wait.h>
 #include <benchmark/benchmark.h>
 
@@ -62,6 +63,22 @@ struct Fixture
     bcostars::protocol::BlockHeaderImpl blockHeader;
 };
 
+// Coroutine frames per transaction, and how many of them still come from the heap with the frame
+// allocator, without it every frame is a heap allocation
+struct FrameCounter
+{
+    task::FrameAllocator::Stats m_begin = task::FrameAllocator::stats();
+
+    void report(benchmark::State& state) const
+    {
+        auto const& stats = task::FrameAllocator::stats();
+        state.counters["frames"] = benchmark::Counter(
+            (double)(stats.frames - m_begin.frames), benchmark::Counter::kAvgIterations);
+        state.counters["frameAllocs"] = benchmark::Counter(
+            (double)(stats.allocations - m_begin.allocations), benchmark::Counter::kAvgIterations);
+    }
+};
+
 static void create(benchmark::State& state)
 {
     Fixture fixture;
@@ -74,11 +91,13 @@ static void create(benchmark::State& state)
     task::syncWait([&fixture](benchmark::State& state,
                        decltype(transaction)& transaction) -> task::Task<void> {
         int contextID = 0;
+        FrameCounter counter;
         for (auto const& it : state)
         {
             [[maybe_unused]] auto receipt =
                 co_await fixture.executor.execute(fixture.blockHeader, transaction, ++contextID);
         }
+        counter.report(state);
     }(state, transaction));
 }
 
@@ -95,6 +114,7 @@ static void call_setInt(benchmark::State& state)
 
     task::syncWait([&](benchmark::State& state) -> task::Task<void> {
         int contextID = 0;
+        FrameCounter counter;
         for (auto const& it : state)
         {
             auto input = abiCodec.abiIn("setInt(int256)", bcos::s256(contextID));
@@ -103,6 +123,7 @@ static void call_setInt(benchmark::State& state)
             [[maybe_unused]] auto receipt =
                 co_await fixture.executor.execute(fixture.blockHeader, transaction, ++contextID);
         }
+        counter.report(state);
     }(state));
 }
 
@@ -119,6 +140,7 @@ static void call_setString(benchmark::State& state)
 
     task::syncWait([&](benchmark::State& state) -> task::Task<void> {
         int contextID = 0;
+        FrameCounter counter;
         for (auto const& it : state)
         {
             auto input = abiCodec.abiIn(
@@ -128,6 +150,7 @@ static void call_setString(benchmark::State& state)
             [[maybe_unused]] auto receipt =
                 co_await fixture.executor.execute(fixture.blockHeader, transaction, ++contextID);
         }
+        counter.report(state);
     }(state));
 }
 
@@ -146,11 +169,13 @@ static void call_delegateCall(benchmark::State& state)
 
     task::syncWait([&](benchmark::State& state) -> task::Task<void> {
         int contextID = 0;
+        FrameCounter counter;
         for (auto const& it : state)
         {
             [[maybe_unused]] auto receipt =
                 co_await fixture.executor.execute(fixture.blockHeader, transaction1, ++contextID);
         }
+        counter.report(state);
     }(state));
 }
 
@@ -169,12 +194,86 @@ static void call_deployAndCall(benchmark::State& state)
 
     task::syncWait([&](benchmark::State& state) -> task::Task<void> {
         int contextID = 0;
+        FrameCounter counter;
         for (auto const& it : state)
         {
             [[maybe_unused]] auto receipt =
                 co_await fixture.executor.execute(fixture.blockHeader, transaction1, ++contextID);
         }
+        counter.report(state);
+    }(state));
+}
+
+static void reportTieredStats(benchmark::State& state, VMFactory const& vmFactory)
+{
+    auto stats = vmFactory.tieredStats();
+    state.counters["baseline"] =
+        benchmark::Counter((double)stats.baselineExecutions, benchmark::Counter::kAvgIterations);
+    state.counters["advanced"] =
+        benchmark::Counter((double)stats.advancedExecutions, benchmark::Counter::kAvgIterations);
+    state.counters["promotions"] =
+        benchmark::Counter((double)stats.promotions, benchmark::Counter::kAvgIterations);
+}
+
+// Calls of a contract whose code is not analyzed yet, e.g. the first call after deploy
+static void tiered_coldCall(benchmark::State& state)
+{
+    Fixture fixture;
+    std::string contractAddress = fixture.deployContract();
+    VMFactory::setPromoteThreshold(state.range(0));
+
+    bcostars::protocol::TransactionImpl transaction(
+        [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); });
+    bcos::codec::abi::ContractABICodec abiCodec(
+        bcos::transaction_executor::GlobalHashImpl::g_hashImpl);
+    auto input = abiCodec.abiIn("getInt()");
+    transaction.mutableInner().data.input.assign(input.begin(), input.end());
+    transaction.mutableInner().data.to = contractAddress;
+
+    task::syncWait([&](benchmark::State& state) -> task::Task<void> {
+        int contextID = 0;
+        for (auto const& it : state)
+        {
+            state.PauseTiming();
+            VMFactory::AnalysisCache::instance().clear();
+            VMFactory::BaselineAnalysisCache::instance().clear();
+            state.ResumeTiming();
+
+            [[maybe_unused]] auto receipt =
+                co_await fixture.executor.execute(fixture.blockHeader, transaction, ++contextID);
+        }
+        reportTieredStats(state, fixture.executor.vmFactory());
+    }(state));
+    VMFactory::setPromoteThreshold(0);
+}
+
+// Repeated calls of the same contract, promoted after the threshold
+static void tiered_hotCall(benchmark::State& state)
+{
+    Fixture fixture;
+    std::string contractAddress = fixture.deployContract();
+    VMFactory::AnalysisCache::instance().clear();
+    VMFactory::BaselineAnalysisCache::instance().clear();
+    VMFactory::setPromoteThreshold(state.range(0));
+
+    bcostars::protocol::TransactionImpl transaction(
+        [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); });
+    bcos::codec::abi::ContractABICodec abiCodec(
+        bcos::transaction_executor::GlobalHashImpl::g_hashImpl);
+
+    task::syncWait([&](benchmark::State& state) -> task::Task<void> {
+        int contextID = 0;
+        for (auto const& it : state)
+        {
+            auto input = abiCodec.abiIn("setInt(int256)", bcos::s256(contextID));
+            transaction.mutableInner().data.input.assign(input.begin(), input.end());
+            transaction.mutableInner().data.to = contractAddress;
+            [[maybe_unused]] auto receipt =
+                co_await fixture.executor.execute(fixture.blockHeader, transaction, ++contextID);
+        }
+        reportTieredStats(state, fixture.executor.vmFactory());
     }(state));
+    VMFactory::setPromoteThreshold(0);
 }
 
 BENCHMARK(create);
@@ -182,5 +281,7 @@ BENCHMARK(call_setInt);
 BENCHMARK(call_setString);
 BENCHMARK(call_delegateCall);
 BENCHMARK(call_deployAndCall);
+BENCHMARK(tiered_coldCall)->Arg(0)->Arg(10);
+BENCHMARK(tiered_hotCall)->Arg(0)->Arg(10)->Arg(100);
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -26,7 +26,7 @@ BOOST_AUTO_TEST_CASE(addRollback)
         static_assert(storage2::ReadableStorage<decltype(rollbackableStorage)>, "No match type!");
 
         auto tableID = makeStringID(pool, "table1");
-        auto point = rollbackableStorage.current();
+        auto point = rollbackableStorage.savepoint();
         storage::Entry entry;
         entry.set("OK!");
         co_await rollbackableStorage.write(
@@ -76,7 +76,7 @@ BOOST_AUTO_TEST_CASE(removeRollback)
         Rollbackable rollbackableStorage(memoryStorage);
 
         auto tableID = makeStringID(pool, "table1");
-        auto point = rollbackableStorage.current();
+        auto point = rollbackableStorage.savepoint();
         storage::Entry entry;
         entry.set("OK!");
         co_await rollbackableStorage.write(
@@ -118,6 +118,53 @@ BOOST_AUTO_TEST_CASE(removeRollback)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(repeatedWrite)
+{
+    task::syncWait([]() -> task::Task<void> {
+        string_pool::FixedStringPool pool;
+        memory_storage::MemoryStorage<StateKey, StateValue, memory_storage::ORDERED> memoryStorage;
+        Rollbackable rollbackableStorage(memoryStorage);
+
+        auto tableID = makeStringID(pool, "table1");
+        auto readValue = [&]() -> task::Task<std::optional<std::string>> {
+            auto it = co_await rollbackableStorage.read(singleView(StateKey{tableID, "Key1"}));
+            co_await it.next();
+            if (co_await it.hasValue())
+            {
+                co_return std::string((co_await it.value()).get());
+            }
+            co_return std::nullopt;
+        };
+        auto writeValue = [&](std::string value) -> task::Task<void> {
+            storage::Entry entry;
+            entry.set(std::move(value));
+            co_await rollbackableStorage.write(
+                singleView(StateKey{tableID, "Key1"}), singleView(std::move(entry)));
+        };
+
+        // Only the first old value of the key is recorded
+        auto point = rollbackableStorage.savepoint();
+        for (auto i = 0; i < 100; ++i)
+        {
+            co_await writeValue(boost::lexical_cast<std::string>(i));
+        }
+        BOOST_CHECK_EQUAL(rollbackableStorage.current(), point + 1);
+
+        // Rollback to a nested savepoint restores the value at the savepoint
+        auto nestedPoint = rollbackableStorage.savepoint();
+        co_await writeValue("nested1");
+        co_await writeValue("nested2");
+        BOOST_CHECK_EQUAL(rollbackableStorage.current(), nestedPoint + 1);
+        BOOST_CHECK_EQUAL(*(co_await readValue()), "nested2");
+        co_await rollbackableStorage.rollback(nestedPoint);
+        BOOST_CHECK_EQUAL(*(co_await readValue()), "99");
+
+        co_await writeValue("after");
+        co_await rollbackableStorage.rollback(point);
+        BOOST_CHECK(!(co_await readValue()));
+    }());
+}
+
 BOOST_AUTO_TEST_CASE(equal)
 {
     task::syncWait([]() -> task::Task<void> {
@@ -1,18 +1,23 @@
 #pragma once
+#include "bcos-framework/storage2/BloomFilter.h"
 #include "bcos-framework/storage2/Storage.h"
 #include "bcos-task/Trait.h"
 #include "bcos-task/Wait.h"
 #include <bcos-concepts/Basic.h>
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
 #include <bcos-task/AwaitableValue.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/parallel_invoke.h>
 #include <oneapi/tbb/task_group.h>
 #include <boost/container/small_vector.hpp>
 #include <boost/throw_exception.hpp>
+#include <atomic>
 #include <iterator>
 #include <stdexcept>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace bcos::transaction_scheduler
 {
@@ -39,11 +44,31 @@ private:
     using ValueType = std::remove_cvref_t<typename MutableStorageType::Value>;
     static_assert(std::same_as<typename MutableStorageType::Key, typename BackendStorage::Key>);
     static_assert(std::same_as<typename MutableStorageType::Value, typename BackendStorage::Value>);
+    static_assert(MutableStorageType::hasLogicalDeletion(),
+        "The layers must keep the removed keys to hide the older values, include the compacted");
+
+    // A read layer, may hold the compacted data of several adjacent blocks
+    struct ImmutableLayer
+    {
+        std::shared_ptr<MutableStorageType> storage;
+        storage2::BloomFilter bloomFilter;
+    };
+
+    // Hashes of the keys written into the mutable storage, the bloom filter of the read layer is
+    // built from them without another pass over the storage
+    using KeyHashes = std::vector<size_t>;
 
     std::shared_ptr<MutableStorageType> m_mutableStorage;
-    std::deque<std::shared_ptr<MutableStorageType>> m_immutableStorages;
+    std::shared_ptr<KeyHashes> m_mutableKeyHashes;
+    std::deque<std::shared_ptr<ImmutableLayer>> m_immutableStorages;
+    std::deque<size_t> m_immutableBlocks;  // Blocks count of each read layer
+    std::deque<std::shared_ptr<MutableStorageType>> m_commitStorages;  // One for each block
     std::mutex m_listMutex;
     std::mutex m_mergeMutex;
+    std::mutex m_compactionMutex;
+    std::atomic_bool m_compacting = false;
+    size_t m_compactionThreshold = 0;
+    tbb::task_group m_compactionTaskGroup;
 
     BackendStorage& m_backendStorage;
     [[no_unique_address]] std::conditional_t<withCacheStorage,
@@ -52,6 +77,56 @@ private:
 
     std::mutex m_mutableMutex;
 
+    struct CacheCounters
+    {
+        std::atomic_size_t hits = 0;
+        std::atomic_size_t misses = 0;
+        std::atomic_size_t prefetchKeys = 0;
+        std::atomic_size_t prefetchLoads = 0;
+    };
+    CacheCounters m_cacheCounters;
+
+    static std::shared_ptr<ImmutableLayer> makeLayer(
+        std::shared_ptr<MutableStorageType> storage, KeyHashes const& keyHashes)
+    {
+        storage2::BloomFilter bloomFilter(keyHashes.size());
+        for (auto hash : keyHashes)
+        {
+            bloomFilter.add(hash);
+        }
+        return std::make_shared<ImmutableLayer>(
+            ImmutableLayer{.storage = std::move(storage), .bloomFilter = std::move(bloomFilter)});
+    }
+
+    static task::Task<void> copyLayer(
+        MutableStorageType& from, MutableStorageType& to, KeyHashes& keyHashes)
+    {
+        auto it = co_await from.seek(storage2::STORAGE_BEGIN);
+        while (co_await it.next())
+        {
+            auto&& key = co_await it.key();
+            keyHashes.emplace_back(std::hash<KeyType>{}(key));
+            if (co_await it.hasValue())
+            {
+                co_await storage2::writeOne(to, key, co_await it.value());
+            }
+            else
+            {
+                co_await storage2::removeOne(to, key);
+            }
+        }
+    }
+
+    static task::Task<std::shared_ptr<ImmutableLayer>> compactLayers(
+        MutableStorageType& newer, MutableStorageType& older)
+    {
+        auto storage = std::make_shared<MutableStorageType>();
+        KeyHashes keyHashes;
+        co_await copyLayer(older, *storage, keyHashes);
+        co_await copyLayer(newer, *storage, keyHashes);
+        co_return makeLayer(std::move(storage), keyHashes);
+    }
+
 public:
     using MutableStorage = MutableStorageType;
 
@@ -61,12 +136,14 @@ public:
 
     private:
         std::shared_ptr<MutableStorageType> m_mutableStorage;
-        std::deque<std::shared_ptr<MutableStorageType>> m_immutableStorages;
+        std::shared_ptr<KeyHashes> m_mutableKeyHashes;
+        std::deque<std::shared_ptr<ImmutableLayer>> m_immutableStorages;
         BackendStorage& m_backendStorage;
         [[no_unique_address]] std::conditional_t<withCacheStorage,
             std::add_lvalue_reference_t<CachedStorage>, std::monostate>
             m_cacheStorage;
         std::unique_lock<std::mutex> m_mutableLock;
+        CacheCounters* m_cacheCounters = nullptr;
 
         View(BackendStorage& backendStorage)
             requires(!withCacheStorage)
@@ -75,9 +152,12 @@ public:
         View(BackendStorage& backendStorage,
             std::conditional_t<withCacheStorage, std::add_lvalue_reference_t<CachedStorage>,
                 std::monostate>
-                cacheStorage)
+                cacheStorage,
+            CacheCounters& cacheCounters)
             requires(withCacheStorage)
-          : m_backendStorage(backendStorage), m_cacheStorage(cacheStorage)
+          : m_backendStorage(backendStorage),
+            m_cacheStorage(cacheStorage),
+            m_cacheCounters(std::addressof(cacheCounters))
         {}
 
         template <RANGES::input_range Keys, RANGES::input_range Values>
@@ -160,6 +240,7 @@ public:
             }
 
             m_mutableStorage = std::make_shared<MutableStorageType>(args...);
+            m_mutableKeyHashes = std::make_shared<KeyHashes>();
         }
 
         task::Task<ReadIterator> read(RANGES::input_range auto const& keys)
@@ -185,22 +266,55 @@ public:
 
             if (!RANGES::empty(m_immutableStorages))
             {
+                if (!started)
+                {
+                    started = true;
+                    for (auto&& [key, value] : RANGES::views::zip(myKeys, myValues))
+                    {
+                        missing.emplace_back(std::addressof(key), std::addressof(value));
+                    }
+                }
+
+                auto keyHashes = missing | RANGES::views::transform([](auto& tuple) {
+                    return std::hash<KeyType>{}(*std::get<0>(tuple));
+                }) | RANGES::to<boost::container::small_vector<size_t, 1>>();
                 for (auto& immutableStorage : m_immutableStorages)
                 {
-                    if (!started)
+                    // Only read the keys may exists in the layer
+                    decltype(missing) candidates;
+                    decltype(missing) rest;
+                    decltype(keyHashes) restHashes;
+                    for (auto&& [tuple, hash] : RANGES::views::zip(missing, keyHashes))
                     {
-                        started = true;
-                        missing = co_await readStorage(myKeys, myValues, *immutableStorage);
+                        if (immutableStorage->bloomFilter.mayContain(hash))
+                        {
+                            candidates.emplace_back(tuple);
+                        }
+                        else
+                        {
+                            rest.emplace_back(tuple);
+                            restHashes.emplace_back(hash);
+                        }
                     }
-                    else
+                    if (RANGES::empty(candidates))
                     {
-                        auto keysView = missing | RANGES::views::transform([
-                        ](auto& tuple) -> auto const& { return *std::get<0>(tuple); });
-                        auto valuesView = missing | RANGES::views::transform([
-                        ](auto& tuple) -> auto& { return *std::get<1>(tuple); });
-                        missing = co_await readStorage(keysView, valuesView, *immutableStorage);
+                        continue;
                     }
 
+                    auto keysView = candidates | RANGES::views::transform([
+                    ](auto& tuple) -> auto const& { return *std::get<0>(tuple); });
+                    auto valuesView = candidates | RANGES::views::transform([
+                    ](auto& tuple) -> auto& { return *std::get<1>(tuple); });
+                    auto candidateMissing =
+                        co_await readStorage(keysView, valuesView, *immutableStorage->storage);
+                    for (auto& tuple : candidateMissing)
+                    {
+                        rest.emplace_back(tuple);
+                        restHashes.emplace_back(std::hash<KeyType>{}(*std::get<0>(tuple)));
+                    }
+                    missing.swap(rest);
+                    keyHashes.swap(restHashes);
+
                     if (RANGES::empty(missing))
                     {
                         co_return iterator;
@@ -210,8 +324,10 @@ public:
 
             if constexpr (withCacheStorage)
             {
+                auto requestCount = started ? RANGES::size(missing) : RANGES::size(myKeys);
                 if (!started)
                 {
+                    started = true;
                     missing = co_await readStorage(myKeys, myValues, m_cacheStorage);
                 }
                 else
@@ -222,6 +338,8 @@ public:
                     ](auto& tuple) -> auto& { return *std::get<1>(tuple); });
                     missing = co_await readStorage(keysView, valuesView, m_cacheStorage);
                 }
+                m_cacheCounters->hits += requestCount - RANGES::size(missing);
+                m_cacheCounters->misses += RANGES::size(missing);
 
                 if (RANGES::empty(missing))
                 {
@@ -264,6 +382,10 @@ public:
                 BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
             }
 
+            for (auto const& key : keys)
+            {
+                m_mutableKeyHashes->emplace_back(std::hash<KeyType>{}(key));
+            }
             co_await m_mutableStorage->write(
                 std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values));
             co_return;
@@ -276,10 +398,36 @@ public:
                 BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
             }
 
+            for (auto const& key : keys)
+            {
+                m_mutableKeyHashes->emplace_back(std::hash<KeyType>{}(key));
+            }
             co_await m_mutableStorage->remove(keys);
             co_return;
         }
 
+        // Move the writes of another mutable storage in, with the hashes of its keys, the writes
+        // into the mutable storage must pass this view to be seen by the bloom filter
+        task::Task<void> mergeMutable(MutableStorageType& from, KeyHashes const& keyHashes)
+        {
+            if (!m_mutableStorage)
+            {
+                BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
+            }
+
+            m_mutableKeyHashes->insert(
+                m_mutableKeyHashes->end(), keyHashes.begin(), keyHashes.end());
+            if (m_mutableStorage->empty())
+            {
+                m_mutableStorage->swap(from);
+            }
+            else
+            {
+                co_await storage2::merge(from, *m_mutableStorage);
+            }
+        }
+
+        // Read only, see mergeMutable()
         MutableStorageType& mutableStorage()
         {
             if (!m_mutableStorage)
@@ -288,6 +436,14 @@ public:
             }
             return *m_mutableStorage;
         }
+        KeyHashes const& mutableKeyHashes() const
+        {
+            if (!m_mutableKeyHashes)
+            {
+                BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
+            }
+            return *m_mutableKeyHashes;
+        }
         BackendStorage& backendStorage() { return m_backendStorage; }
     };
 
@@ -310,14 +466,14 @@ public:
     MultiLayerStorage(MultiLayerStorage&&) noexcept = delete;
     MultiLayerStorage& operator=(const MultiLayerStorage&) = delete;
     MultiLayerStorage& operator=(MultiLayerStorage&&) noexcept = delete;
-    ~MultiLayerStorage() noexcept = default;
+    ~MultiLayerStorage() noexcept { m_compactionTaskGroup.wait(); }
 
     View fork(bool withMutable)
     {
         std::unique_lock lock(m_listMutex);
         if constexpr (withCacheStorage)
         {
-            View view(m_backendStorage, m_cacheStorage);
+            View view(m_backendStorage, m_cacheStorage, m_cacheCounters);
             if (withMutable)
             {
                 view.m_mutableLock = {m_mutableMutex, std::try_to_lock};
@@ -326,6 +482,7 @@ public:
                     BOOST_THROW_EXCEPTION(DuplicateMutableViewError{});
                 }
                 view.m_mutableStorage = m_mutableStorage;
+                view.m_mutableKeyHashes = m_mutableKeyHashes;
             }
             view.m_immutableStorages = m_immutableStorages;
 
@@ -342,6 +499,7 @@ public:
                     BOOST_THROW_EXCEPTION(DuplicateMutableViewError{});
                 }
                 view.m_mutableStorage = m_mutableStorage;
+                view.m_mutableKeyHashes = m_mutableKeyHashes;
             }
             view.m_immutableStorages = m_immutableStorages;
 
@@ -359,6 +517,7 @@ public:
         }
 
         m_mutableStorage = std::make_shared<MutableStorageType>(args...);
+        m_mutableKeyHashes = std::make_shared<KeyHashes>();
     }
 
     void pushMutableToImmutableFront()
@@ -367,20 +526,36 @@ public:
         {
             BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
         }
+        auto layer = makeLayer(m_mutableStorage, *m_mutableKeyHashes);
+
         std::unique_lock lock(m_listMutex);
-        m_immutableStorages.push_front(std::move(m_mutableStorage));
+        m_commitStorages.push_front(m_mutableStorage);
+        m_immutableStorages.push_front(std::move(layer));
+        m_immutableBlocks.push_front(1);
         m_mutableStorage.reset();
+        m_mutableKeyHashes.reset();
+        auto layerCount = m_immutableStorages.size();
+        lock.unlock();
+
+        if (m_compactionThreshold > 0 && layerCount > m_compactionThreshold &&
+            !m_compacting.exchange(true))
+        {
+            m_compactionTaskGroup.run([this]() {
+                task::syncWait(compactImmutables());
+                m_compacting = false;
+            });
+        }
     }
 
     task::Task<void> mergeAndPopImmutableBack()
     {
         std::unique_lock mergeLock(m_mergeMutex);
         std::unique_lock immutablesLock(m_listMutex);
-        if (m_immutableStorages.empty())
+        if (m_commitStorages.empty())
         {
             BOOST_THROW_EXCEPTION(NotExistsImmutableStorageError{});
         }
-        auto immutableStorage = m_immutableStorages.back();
+        auto immutableStorage = m_commitStorages.back();
         immutablesLock.unlock();
 
         if constexpr (withCacheStorage)
@@ -395,7 +570,127 @@ public:
         }
 
         immutablesLock.lock();
-        m_immutableStorages.pop_back();
+        m_commitStorages.pop_back();
+        // The read layer may hold other blocks not committed yet
+        if (--m_immutableBlocks.back() == 0)
+        {
+            m_immutableBlocks.pop_back();
+            m_immutableStorages.pop_back();
+        }
+    }
+
+    // Merge each pair of adjacent read layers into a new layer in parallel, readers never see a
+    // half merged layer, the committing path still merges the original layers block by block
+    task::Task<void> compactImmutables()
+    {
+        std::unique_lock compactionLock(m_compactionMutex);
+        std::unique_lock lock(m_listMutex);
+        auto layers = m_immutableStorages;
+        lock.unlock();
+
+        auto pairCount = layers.size() / 2;
+        if (pairCount == 0)
+        {
+            co_return;
+        }
+
+        std::vector<std::shared_ptr<ImmutableLayer>> compactedLayers(pairCount);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0LU, pairCount),
+            [&](tbb::blocked_range<size_t> const& range) {
+                for (auto i = range.begin(); i != range.end(); ++i)
+                {
+                    compactedLayers[i] = task::syncWait(
+                        compactLayers(*layers[i * 2]->storage, *layers[i * 2 + 1]->storage));
+                }
+            });
+
+        lock.lock();
+        for (size_t i = 0; i < pairCount; ++i)
+        {
+            auto const& newer = layers[i * 2];
+            auto const& older = layers[i * 2 + 1];
+            auto it = RANGES::find(m_immutableStorages, newer);
+            if (it == m_immutableStorages.end() || (it + 1) == m_immutableStorages.end() ||
+                *(it + 1) != older)
+            {
+                // Committed while compacting
+                continue;
+            }
+
+            auto index = it - m_immutableStorages.begin();
+            m_immutableBlocks[index] += m_immutableBlocks[index + 1];
+            m_immutableBlocks.erase(m_immutableBlocks.begin() + index + 1);
+            m_immutableStorages.erase(it + 1);
+            m_immutableStorages[index] = std::move(compactedLayers[i]);
+        }
+    }
+
+    // Load the keys missing in the cache layer from the backend with one read. Keys may exist in
+    // the read layers are skipped, the backend holds an older value of them
+    task::Task<void> prefetch(RANGES::input_range auto const& keys)
+        requires(withCacheStorage)
+    {
+        std::unique_lock lock(m_listMutex);
+        auto immutableStorages = m_immutableStorages;
+        lock.unlock();
+
+        std::vector<KeyType> candidateKeys;
+        for (auto const& key : keys)
+        {
+            auto hash = std::hash<KeyType>{}(key);
+            if (RANGES::none_of(immutableStorages,
+                    [&](auto const& layer) { return layer->bloomFilter.mayContain(hash); }))
+            {
+                candidateKeys.emplace_back(key);
+            }
+        }
+        m_cacheCounters.prefetchKeys += candidateKeys.size();
+
+        std::vector<std::optional<ValueType>> values(candidateKeys.size());
+        auto missing = co_await View::readStorage(candidateKeys, values, m_cacheStorage);
+        if (RANGES::empty(missing))
+        {
+            co_return;
+        }
+
+        auto keysView = missing | RANGES::views::transform([
+        ](auto& tuple) -> auto const& { return *std::get<0>(tuple); });
+        auto valuesView = missing | RANGES::views::transform([
+        ](auto& tuple) -> auto& { return *std::get<1>(tuple); });
+        co_await View::readStorage(keysView, valuesView, m_backendStorage);
+        for (auto&& [key, value] : RANGES::views::zip(keysView, valuesView))
+        {
+            if (value)
+            {
+                ++m_cacheCounters.prefetchLoads;
+                co_await storage2::writeOne(m_cacheStorage, key, *value);
+            }
+        }
+    }
+
+    struct CacheStats
+    {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t prefetchKeys = 0;   // Keys requested by prefetch
+        size_t prefetchLoads = 0;  // Values loaded into the cache by prefetch
+    };
+    CacheStats cacheStats() const
+    {
+        return {.hits = m_cacheCounters.hits,
+            .misses = m_cacheCounters.misses,
+            .prefetchKeys = m_cacheCounters.prefetchKeys,
+            .prefetchLoads = m_cacheCounters.prefetchLoads};
+    }
+    constexpr static bool hasCacheStorage() { return withCacheStorage; }
+
+    // Compact the read layers in background when there are more than `threshold` layers, 0 to
+    // disable
+    void setCompactionThreshold(size_t threshold) { m_compactionThreshold = threshold; }
+    size_t immutableLayerCount()
+    {
+        std::unique_lock lock(m_listMutex);
+        return m_immutableStorages.size();
     }
 
     MutableStorageType& mutableStorage()
@@ -406,6 +701,14 @@ public:
         }
         return *m_mutableStorage;
     }
+    KeyHashes const& mutableKeyHashes() const
+    {
+        if (!m_mutableKeyHashes)
+        {
+            BOOST_THROW_EXCEPTION(NotExistsMutableStorageError{});
+        }
+        return *m_mutableKeyHashes;
+    }
     BackendStorage& backendStorage() { return m_backendStorage; }
 };
 }  // namespace bcos::transaction_scheduler
\ No newline at end of file
@@ -1,24 +1,30 @@
 #pragma once
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
 #include <bcos-task/Trait.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace bcos::transaction_scheduler
 {
 
-template <transaction_executor::StateStorage Storage>
-class ReadWriteSetStorage
+template <class KeyType>
+class MapReadWriteSet
 {
 private:
-    Storage& m_storage;
     struct ReadWriteFlag
     {
         bool read = false;
         bool write = false;
     };
-    std::map<typename Storage::Key, ReadWriteFlag, std::less<>> m_readWriteSet;
-    void putSet(bool write, auto const& key)
+    std::map<KeyType, ReadWriteFlag, std::less<>> m_readWriteSet;
+
+public:
+    void put(bool write, auto const& key)
     {
         auto it = m_readWriteSet.lower_bound(key);
         if (it == m_readWriteSet.end() || it->first != key)
@@ -36,26 +42,24 @@ private:
         }
     }
 
-public:
-    using Key = typename Storage::Key;
-    using Value = typename Storage::Value;
-    ReadWriteSetStorage(Storage& storage) : m_storage(storage) {}
-
     // RAW means read after write
-    bool hasRAWIntersection(const ReadWriteSetStorage& rhs)
+    bool hasRAWIntersection(const MapReadWriteSet& rhs) const { return rawKey(rhs) != nullptr; }
+
+    // The first key written here and read by rhs, nullptr if none
+    KeyType const* rawKey(const MapReadWriteSet& rhs) const
     {
         auto const& lhsSet = m_readWriteSet;
         auto const& rhsSet = rhs.m_readWriteSet;
 
         if (RANGES::empty(lhsSet) || RANGES::empty(rhsSet))
         {
-            return false;
+            return nullptr;
         }
 
         if ((RANGES::back(lhsSet).first < RANGES::front(rhsSet).first) ||
             (RANGES::front(lhsSet).first > RANGES::back(rhsSet).first))
         {
-            return false;
+            return nullptr;
         }
 
         auto lhsRange = lhsSet |
@@ -81,13 +85,133 @@ public:
             {
                 if (!(*rBegin < *lBegin))
                 {
-                    return true;
+                    return std::addressof(*lBegin);
                 }
                 RANGES::advance(rBegin, 1);
             }
         }
 
-        return false;
+        return nullptr;
+    }
+};
+
+// Append only vectors, sorted and deduplicated once at the first intersection, with a 64 bits
+// fingerprint of the key hashes to skip the merge walk for disjoint sets
+template <class KeyType>
+class VectorReadWriteSet
+{
+private:
+    mutable std::vector<KeyType> m_reads;
+    mutable std::vector<KeyType> m_writes;
+    uint64_t m_readFingerprint = 0;
+    uint64_t m_writeFingerprint = 0;
+    mutable std::once_flag m_sorted;
+
+    static uint64_t fingerprint(auto const& key)
+    {
+        constexpr static auto FINGERPRINT_BITS = 64;
+        return uint64_t(1) << (std::hash<KeyType>{}(key) % FINGERPRINT_BITS);
+    }
+
+    void sortOnce() const
+    {
+        std::call_once(m_sorted, [this]() {
+            for (auto* keys : {std::addressof(m_reads), std::addressof(m_writes)})
+            {
+                std::sort(keys->begin(), keys->end());
+                keys->erase(std::unique(keys->begin(), keys->end()), keys->end());
+            }
+        });
+    }
+
+public:
+    VectorReadWriteSet() = default;
+    VectorReadWriteSet(const VectorReadWriteSet&) = delete;
+    VectorReadWriteSet(VectorReadWriteSet&&) = delete;
+    VectorReadWriteSet& operator=(const VectorReadWriteSet&) = delete;
+    VectorReadWriteSet& operator=(VectorReadWriteSet&&) = delete;
+    ~VectorReadWriteSet() noexcept = default;
+
+    void put(bool write, auto const& key)
+    {
+        if (write)
+        {
+            m_writes.emplace_back(key);
+            m_writeFingerprint |= fingerprint(key);
+        }
+        else
+        {
+            m_reads.emplace_back(key);
+            m_readFingerprint |= fingerprint(key);
+        }
+    }
+
+    // Must not be called before all put() finished, the sets are sorted in place here
+    bool hasRAWIntersection(const VectorReadWriteSet& rhs) const { return rawKey(rhs) != nullptr; }
+
+    // The first key written here and read by rhs, nullptr if none
+    KeyType const* rawKey(const VectorReadWriteSet& rhs) const
+    {
+        if ((m_writeFingerprint & rhs.m_readFingerprint) == 0)
+        {
+            return nullptr;
+        }
+
+        sortOnce();
+        rhs.sortOnce();
+
+        auto lBegin = m_writes.begin();
+        auto lEnd = m_writes.end();
+        auto rBegin = rhs.m_reads.begin();
+        auto rEnd = rhs.m_reads.end();
+        if (*(lEnd - 1) < *rBegin || *(rEnd - 1) < *lBegin)
+        {
+            return nullptr;
+        }
+
+        // O(lhsSet.size() + rhsSet.size())
+        while (lBegin != lEnd && rBegin != rEnd)
+        {
+            if (*lBegin < *rBegin)
+            {
+                ++lBegin;
+            }
+            else
+            {
+                if (!(*rBegin < *lBegin))
+                {
+                    return std::addressof(*lBegin);
+                }
+                ++rBegin;
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+template <transaction_executor::StateStorage Storage,
+    class ReadWriteSet = MapReadWriteSet<typename Storage::Key>>
+class ReadWriteSetStorage
+{
+private:
+    Storage& m_storage;
+    ReadWriteSet m_readWriteSet;
+
+public:
+    using Key = typename Storage::Key;
+    using Value = typename Storage::Value;
+    ReadWriteSetStorage(Storage& storage) : m_storage(storage) {}
+
+    // RAW means read after write
+    bool hasRAWIntersection(const ReadWriteSetStorage& rhs)
+    {
+        return m_readWriteSet.hasRAWIntersection(rhs.m_readWriteSet);
+    }
+    // The first key written here and read by rhs, nullptr if none
+    auto const* rawKey(const ReadWriteSetStorage& rhs)
+    {
+        return m_readWriteSet.rawKey(rhs.m_readWriteSet);
     }
 
     auto read(RANGES::input_range auto const& keys)
@@ -95,7 +219,7 @@ public:
     {
         for (auto&& key : keys)
         {
-            putSet(false, key);
+            m_readWriteSet.put(false, key);
         }
         co_return co_await m_storage.read(keys);
     }
@@ -106,7 +230,7 @@ public:
     {
         for (auto&& key : keys)
         {
-            putSet(true, std::forward<decltype(key)>(key));
+            m_readWriteSet.put(true, key);
         }
         co_return co_await m_storage.write(
             std::forward<decltype(keys)>(keys), std::forward<decltype(values)>(values));
@@ -117,10 +241,10 @@ public:
     {
         for (auto&& key : keys)
         {
-            putSet(true, std::forward<decltype(key)>(key));
+            m_readWriteSet.put(true, key);
         }
         co_return co_await m_storage.remove(keys);
     }
 };
 
-}  // namespace bcos::transaction_scheduler
\ No newline at end of file
+}  // namespace bcos::transaction_scheduler
@@ -1,5 +1,6 @@
 #pragma once
 #include "MultiLayerStorage.h"
+#include "bcos-framework/Common.h"
 #include "bcos-framework/protocol/Transaction.h"
 #include <bcos-framework/protocol/Block.h>
 #include <bcos-framework/protocol/BlockHeader.h>
@@ -7,20 +8,143 @@
 #include <bcos-framework/storage2/MemoryStorage.h>
 #include <bcos-framework/transaction-executor/TransactionExecutor.h>
 #include <bcos-framework/transaction-scheduler/TransactionScheduler.h>
+#include <bcos-task/TBBWait.h>
 #include <bcos-task/Task.h>
+#include <bcos-utilities/BoostLog.h>
+#include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/combinable.h>
+#include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/parallel_pipeline.h>
+#include <span>
 
 namespace bcos::transaction_scheduler
 {
 
+#define SCHEDULER_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("SCHEDULER")
+
+// The executor tells which keys a transaction reads first, and which key is read next with the
+// value of such a key
+template <class ExecutorType, class BlockHeader, class Transaction>
+concept HasPrefetchKey = requires(transaction_executor::TableNamePool& tableNamePool,
+    BlockHeader const& blockHeader, Transaction const& transaction,
+    transaction_executor::StateKey const& key, transaction_executor::StateValue const& value) {
+    {
+        ExecutorType::prefetchKey(tableNamePool, blockHeader, transaction)
+    } -> std::same_as<std::optional<transaction_executor::StateKey>>;
+    {
+        ExecutorType::prefetchFollowKey(tableNamePool, key, value)
+    } -> std::same_as<std::optional<transaction_executor::StateKey>>;
+};
+
 template <class MultiLayerStorage, template <typename> class Executor>
 class SchedulerBaseImpl
 {
+public:
+    struct PrefetchMetrics
+    {
+        size_t keys = 0;         // Keys requested by prefetch
+        size_t loads = 0;        // Values loaded into the cache from the backend
+        size_t cacheHits = 0;    // Cache hits of the block execution
+        size_t cacheMisses = 0;  // Cache misses of the block execution
+    };
+
 private:
+    constexpr static size_t PREFETCH_CHUNK_SIZE = 256;
+    using ViewExecutor = Executor<decltype(std::declval<MultiLayerStorage&>().fork(true))>;
+
     MultiLayerStorage& m_multiLayerStorage;
     protocol::TransactionReceiptFactory& m_receiptFactory;
     transaction_executor::TableNamePool& m_tableNamePool;
+    bool m_prefetch = false;
+    PrefetchMetrics m_lastPrefetchMetrics;
+    size_t m_cacheHitsBase = 0;
+    size_t m_cacheMissesBase = 0;
+
+    void prefetchChunks(std::vector<transaction_executor::StateKey>& keys)
+    {
+        RANGES::sort(keys);
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        // One multi key read of each chunk, chunks are loaded in parallel
+        tbb::parallel_for(tbb::blocked_range<size_t>(0LU, keys.size(), PREFETCH_CHUNK_SIZE),
+            [&](tbb::blocked_range<size_t> const& range) {
+                task::tbb::syncWait(m_multiLayerStorage.prefetch(
+                    std::span(keys.data() + range.begin(), range.size())));
+            });
+    }
+
+    void updateCacheMetrics()
+    {
+        auto stats = m_multiLayerStorage.cacheStats();
+        m_lastPrefetchMetrics.cacheHits = stats.hits - m_cacheHitsBase;
+        m_lastPrefetchMetrics.cacheMisses = stats.misses - m_cacheMissesBase;
+
+        auto total = m_lastPrefetchMetrics.cacheHits + m_lastPrefetchMetrics.cacheMisses;
+        auto ratio = total == 0 ? 1.0 : (double)m_lastPrefetchMetrics.cacheHits / (double)total;
+        SCHEDULER_LOG(DEBUG) << METRIC << "Block cache hit ratio"
+                             << LOG_KV("hits", m_lastPrefetchMetrics.cacheHits)
+                             << LOG_KV("misses", m_lastPrefetchMetrics.cacheMisses)
+                             << LOG_KV("ratio", ratio);
+    }
+
+protected:
+    // Warm the cache layer with the keys the block reads first, e.g. the code hash and the code of
+    // the called contracts, before the block is executed
+    task::Task<void> prefetch(protocol::IsBlockHeader auto const& blockHeader,
+        RANGES::input_range auto const& transactions)
+    {
+        using Transaction = std::remove_cvref_t<RANGES::range_reference_t<decltype(transactions)>>;
+        if constexpr (MultiLayerStorage::hasCacheStorage() &&
+                      HasPrefetchKey<ViewExecutor, std::remove_cvref_t<decltype(blockHeader)>,
+                          Transaction>)
+        {
+            if (!m_prefetch)
+            {
+                co_return;
+            }
+
+            auto stats = m_multiLayerStorage.cacheStats();
+            std::vector<transaction_executor::StateKey> keys;
+            for (auto const& transaction : transactions)
+            {
+                if (auto key = ViewExecutor::prefetchKey(m_tableNamePool, blockHeader, transaction))
+                {
+                    keys.emplace_back(std::move(*key));
+                }
+            }
+            prefetchChunks(keys);
+
+            std::vector<transaction_executor::StateKey> followKeys;
+            {
+                auto view = m_multiLayerStorage.fork(false);
+                auto it = co_await view.read(keys);
+                auto keyIt = keys.begin();
+                while (co_await it.next())
+                {
+                    if (co_await it.hasValue())
+                    {
+                        if (auto key = ViewExecutor::prefetchFollowKey(
+                                m_tableNamePool, *keyIt, co_await it.value()))
+                        {
+                            followKeys.emplace_back(std::move(*key));
+                        }
+                    }
+                    ++keyIt;
+                }
+            }
+            prefetchChunks(followKeys);
+
+            // Execution cache hits are counted from here
+            auto prefetchStats = m_multiLayerStorage.cacheStats();
+            m_lastPrefetchMetrics = {.keys = prefetchStats.prefetchKeys - stats.prefetchKeys,
+                .loads = prefetchStats.prefetchLoads - stats.prefetchLoads};
+            m_cacheHitsBase = prefetchStats.hits;
+            m_cacheMissesBase = prefetchStats.misses;
+            SCHEDULER_LOG(DEBUG) << METRIC << "Prefetch finished"
+                                 << LOG_KV("keys", m_lastPrefetchMetrics.keys)
+                                 << LOG_KV("loads", m_lastPrefetchMetrics.loads);
+        }
+        co_return;
+    }
 
 public:
     SchedulerBaseImpl(MultiLayerStorage& multiLayerStorage,
@@ -73,6 +197,11 @@ public:
         taskGroup.wait();
         m_multiLayerStorage.pushMutableToImmutableFront();
 
+        if (MultiLayerStorage::hasCacheStorage() && m_prefetch)
+        {
+            updateCacheMetrics();
+        }
+
         co_return combinableHash.combine(
             [](const bcos::h256& lhs, const bcos::h256& rhs) -> bcos::h256 { return lhs ^ rhs; });
     }
@@ -88,6 +217,12 @@ public:
         co_return co_await executor.execute(blockHeader, transaction, 0);
     }
 
+    // Prefetch the first keys of the block into the cache layer before execution, needs the
+    // storage with a cache layer and the executor with prefetchKey
+    void setPrefetch(bool prefetch) { m_prefetch = prefetch; }
+    // The cache hits are available after finish()
+    PrefetchMetrics const& lastPrefetchMetrics() const& { return m_lastPrefetchMetrics; }
+
     MultiLayerStorage& multiLayerStorage() & { return m_multiLayerStorage; }
     decltype(m_receiptFactory)& receiptFactory() & { return m_receiptFactory; }
     transaction_executor::TableNamePool& tableNamePool() & { return m_tableNamePool; }
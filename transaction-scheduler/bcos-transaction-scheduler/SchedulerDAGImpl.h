@@ -0,0 +1,204 @@
+#pragma once
+
+#include "MultiLayerStorage.h"
+#include "SchedulerBaseImpl.h"
+#include "bcos-framework/Common.h"
+#include "bcos-framework/protocol/Transaction.h"
+#include "bcos-framework/protocol/TransactionReceiptFactory.h"
+#include "bcos-framework/storage2/Storage.h"
+#include <bcos-task/TBBWait.h>
+#include <bcos-task/Wait.h>
+#include <oneapi/tbb/blocked_range.h>
+#include <oneapi/tbb/concurrent_vector.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_group.h>
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::transaction_scheduler
+{
+
+#define DAG_SCHEDULER_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("DAG_SCHEDULER")
+
+// Declared conflict keys of a transaction, std::nullopt means unknown, the transaction conflicts
+// with all other transactions
+using ConflictKeys = std::optional<std::vector<std::string>>;
+using ConflictResolver = std::function<ConflictKeys(protocol::Transaction const&)>;
+
+// Build the dependency DAG of a block from the declared conflict keys, and execute the
+// transactions level by level, every level holds the transactions whose dependencies are all in
+// the previous levels. No speculation and no rollback, the declared keys must cover every state
+// key the transaction reads or writes, the transactions of a level never see the writes of each
+// other. The node does not build this scheduler, the resolver of the conflict keys is set by the
+// caller, without a resolver every transaction is unknown and the block executes serially.
+template <class MultiLayerStorage, template <typename> class Executor>
+class SchedulerDAGImpl : public SchedulerBaseImpl<MultiLayerStorage, Executor>
+{
+private:
+    using LocalStorage =
+        transaction_scheduler::MultiLayerStorage<typename MultiLayerStorage::MutableStorage, void,
+            decltype(std::declval<MultiLayerStorage>().fork(true))>;
+    using SchedulerBaseImpl<MultiLayerStorage, Executor>::multiLayerStorage;
+    using SchedulerBaseImpl<MultiLayerStorage, Executor>::prefetch;
+    constexpr static size_t MIN_PARALLEL_LEVEL_SIZE = 4;
+
+    struct RangeStorage
+    {
+        RangeStorage(auto& storage) : m_localStorage(storage), m_localStorageView(forkAndMutable())
+        {}
+
+        LocalStorage m_localStorage;
+        decltype(std::declval<LocalStorage>().fork(true)) m_localStorageView;
+
+        auto forkAndMutable()
+        {
+            m_localStorage.newMutable();
+            return m_localStorage.fork(true);
+        }
+    };
+
+    std::unique_ptr<tbb::task_group> m_asyncTaskGroup;
+    ConflictResolver m_conflictResolver;
+    size_t m_minParallelLevelSize = MIN_PARALLEL_LEVEL_SIZE;
+    size_t m_lastLevelCount = 0;
+
+    // Longest path level of each transaction in the DAG
+    std::vector<std::vector<size_t>> buildLevels(RANGES::random_access_range auto const& transactions)
+    {
+        std::vector<std::vector<size_t>> levels;
+        std::unordered_map<std::string, size_t> keyLevels;
+        size_t floorLevel = 0;  // Level after the last unknown transaction
+
+        for (auto&& [index, transaction] :
+            RANGES::views::zip(RANGES::views::iota(0LU), transactions))
+        {
+            ConflictKeys conflictKeys;
+            if (m_conflictResolver)
+            {
+                conflictKeys = m_conflictResolver(*transaction);
+            }
+
+            size_t level = floorLevel;
+            if (!conflictKeys)
+            {
+                level = std::max(floorLevel, levels.size());
+                floorLevel = level + 1;
+            }
+            else
+            {
+                for (auto const& key : *conflictKeys)
+                {
+                    if (auto it = keyLevels.find(key); it != keyLevels.end())
+                    {
+                        level = std::max(level, it->second + 1);
+                    }
+                }
+                for (auto const& key : *conflictKeys)
+                {
+                    keyLevels.insert_or_assign(key, level);
+                }
+            }
+
+            if (level >= levels.size())
+            {
+                levels.resize(level + 1);
+            }
+            levels[level].emplace_back(index);
+        }
+
+        return levels;
+    }
+
+    task::Task<void> serialExecute(protocol::IsBlockHeader auto const& blockHeader,
+        RANGES::random_access_range auto const& transactions, std::vector<size_t> const& indexes,
+        std::vector<protocol::TransactionReceipt::Ptr>& receipts, auto& storage)
+    {
+        Executor<std::remove_cvref_t<decltype(storage)>> executor(
+            storage, receiptFactory(), tableNamePool());
+        for (auto index : indexes)
+        {
+            receipts[index] =
+                co_await executor.execute(blockHeader, *(transactions[index]), (int)index);
+        }
+    }
+
+public:
+    using SchedulerBaseImpl<MultiLayerStorage, Executor>::receiptFactory;
+    using SchedulerBaseImpl<MultiLayerStorage, Executor>::tableNamePool;
+
+    SchedulerDAGImpl(MultiLayerStorage& multiLayerStorage,
+        protocol::TransactionReceiptFactory& receiptFactory,
+        transaction_executor::TableNamePool& tableNamePool)
+      : SchedulerBaseImpl<MultiLayerStorage, Executor>(
+            multiLayerStorage, receiptFactory, tableNamePool),
+        m_asyncTaskGroup(std::make_unique<tbb::task_group>())
+    {}
+
+    ~SchedulerDAGImpl() noexcept { m_asyncTaskGroup->wait(); }
+
+    task::Task<std::vector<protocol::TransactionReceipt::Ptr>> execute(
+        protocol::IsBlockHeader auto const& blockHeader,
+        RANGES::input_range auto const& transactions)
+    {
+        co_await prefetch(blockHeader, transactions);
+        auto storageView = multiLayerStorage().fork(true);
+        auto transactionPtrs =
+            transactions | RANGES::views::addressof |
+            RANGES::to<std::vector<std::add_pointer_t<
+                std::remove_reference_t<RANGES::range_reference_t<decltype(transactions)>>>>>();
+        std::vector<protocol::TransactionReceipt::Ptr> receipts(transactionPtrs.size());
+
+        auto levels = buildLevels(transactionPtrs);
+        m_lastLevelCount = levels.size();
+        DAG_SCHEDULER_LOG(DEBUG) << METRIC << "DAG levels: " << levels.size()
+                                 << " transactions: " << transactionPtrs.size();
+
+        for (auto const& level : levels)
+        {
+            if (level.size() < m_minParallelLevelSize)
+            {
+                co_await serialExecute(blockHeader, transactionPtrs, level, receipts, storageView);
+                continue;
+            }
+
+            // Transactions in the same level touch different keys, each range executes on its own
+            // local storage above the block view, and merged in any order afterwards
+            tbb::concurrent_vector<std::unique_ptr<RangeStorage>> rangeStorages;
+            tbb::parallel_for(tbb::blocked_range<size_t>(0LU, level.size()),
+                [&](tbb::blocked_range<size_t> const& range) {
+                    auto& rangeStorage =
+                        **rangeStorages.emplace_back(std::make_unique<RangeStorage>(storageView));
+                    Executor<decltype(rangeStorage.m_localStorageView)> executor(
+                        rangeStorage.m_localStorageView, receiptFactory(), tableNamePool());
+                    for (auto i = range.begin(); i != range.end(); ++i)
+                    {
+                        auto index = level[i];
+                        receipts[index] = task::tbb::syncWait(executor.execute(
+                            blockHeader, *(transactionPtrs[index]), (int)index));
+                    }
+                });
+
+            for (auto& rangeStorage : rangeStorages)
+            {
+                co_await storageView.mergeMutable(rangeStorage->m_localStorage.mutableStorage(),
+                    rangeStorage->m_localStorage.mutableKeyHashes());
+            }
+            m_asyncTaskGroup->run([rangeStorages = std::move(rangeStorages)]() {});
+        }
+        m_asyncTaskGroup->run([storageView = std::move(storageView)]() {});
+
+        co_return receipts;
+    }
+
+    void setConflictResolver(ConflictResolver conflictResolver)
+    {
+        m_conflictResolver = std::move(conflictResolver);
+    }
+    void setMinParallelLevelSize(size_t size) { m_minParallelLevelSize = size; }
+    size_t lastLevelCount() const { return m_lastLevelCount; }
+};
+}  // namespace bcos::transaction_scheduler
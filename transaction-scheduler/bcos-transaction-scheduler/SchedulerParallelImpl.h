@@ -3,16 +3,21 @@
 #include "MultiLayerStorage.h"
 #include "ReadWriteSetStorage.h"
 #include "SchedulerBaseImpl.h"
+#include "bcos-framework/Common.h"
 #include "bcos-framework/protocol/TransactionReceiptFactory.h"
 #include "bcos-framework/storage2/Storage.h"
 #include "bcos-utilities/Exceptions.h"
+#include <bcos-task/TBBWait.h>
 #include <bcos-task/Wait.h>
 #include <bcos-utilities/ITTAPI.h>
 #include <oneapi/tbb/parallel_pipeline.h>
 #include <boost/exception/detail/exception_ptr.hpp>
 #include <boost/throw_exception.hpp>
+#include <algorithm>
 #include <atomic>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 
 namespace bcos::transaction_scheduler
@@ -20,7 +25,8 @@ namespace bcos::transaction_scheduler
 
 #define PARALLEL_SCHEDULER_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("PARALLEL_SCHEDULER")
 
-template <class MultiLayerStorage, template <typename> class Executor>
+template <class MultiLayerStorage, template <typename> class Executor,
+    template <typename> class ReadWriteSet = MapReadWriteSet>
 class SchedulerParallelImpl : public SchedulerBaseImpl<MultiLayerStorage, Executor>
 {
 private:
@@ -29,11 +35,47 @@ private:
         transaction_scheduler::MultiLayerStorage<typename MultiLayerStorage::MutableStorage, void,
             decltype(std::declval<MultiLayerStorage>().fork(true))>;
     using SchedulerBaseImpl<MultiLayerStorage, Executor>::multiLayerStorage;
+    using SchedulerBaseImpl<MultiLayerStorage, Executor>::prefetch;
     constexpr static size_t MIN_CHUNK_SIZE = 32;
     constexpr static size_t MAX_RETRY_COUNT = 30;
 
+    // For adaptive mode
+    constexpr static size_t MIN_ADAPTIVE_CHUNK_SIZE = 2;
+    constexpr static size_t MAX_ADAPTIVE_CHUNK_SIZE = 1024;
+    constexpr static double SERIAL_TAIL_ABORT_RATE = 0.5;
+
+public:
+    using ConflictKey = std::remove_cvref_t<typename MultiLayerStorage::MutableStorage::Key>;
+    struct ExecuteMetrics
+    {
+        size_t retryCount = 0;
+        size_t abortedChunks = 0;  // chunks executed or executing, then discarded by a conflict
+        size_t rawConflicts = 0;
+        size_t serialTailCount = 0;
+        std::vector<size_t> chunkSizes;         // chunk size of each pass
+        std::map<ConflictKey, size_t> rawKeys;  // RAW conflicts of each key
+    };
+
+private:
+    // RAW conflicts detected by the chunks of a pass
+    struct RAWConflicts
+    {
+        std::mutex mutex;
+        size_t count = 0;
+        std::map<ConflictKey, size_t> keys;
+
+        void add(ConflictKey const& key)
+        {
+            std::unique_lock lock(mutex);
+            ++count;
+            ++keys[key];
+        }
+    };
+
     size_t m_chunkSize = MIN_CHUNK_SIZE;
     size_t m_maxToken = 0;
+    bool m_adaptive = false;
+    ExecuteMetrics m_lastMetrics;
 
     template <class TransactionAndReceiptssRange>
     class ChunkExecuteStatus
@@ -49,7 +91,9 @@ private:
 
             ChunkLocalStorage m_localStorage;
             decltype(std::declval<ChunkLocalStorage>().fork(true)) m_localStorageView;
-            ReadWriteSetStorage<decltype(m_localStorageView)> m_readWriteSetStorage;
+            ReadWriteSetStorage<decltype(m_localStorageView),
+                ReadWriteSet<typename decltype(m_localStorageView)::Key>>
+                m_readWriteSetStorage;
 
             auto forkAndMutable(auto& storage)
             {
@@ -61,6 +105,7 @@ private:
 
         int64_t m_chunkIndex = 0;
         std::atomic_int64_t* m_lastChunkIndex = nullptr;
+        RAWConflicts* m_rawConflicts = nullptr;
         std::optional<Storage> m_storages;
         TransactionAndReceiptssRange m_transactionAndReceiptsRange;
 
@@ -70,10 +115,12 @@ private:
 
     public:
         void init(int64_t chunkIndex, std::atomic_int64_t& lastChunkIndex,
+            RAWConflicts& rawConflicts,
             TransactionAndReceiptssRange transactionAndReceiptsRange, auto& storage)
         {
             m_chunkIndex = chunkIndex;
             m_lastChunkIndex = std::addressof(lastChunkIndex);
+            m_rawConflicts = std::addressof(rawConflicts);
             m_transactionAndReceiptsRange = std::move(transactionAndReceiptsRange);
             m_storages.emplace(storage);
         }
@@ -124,11 +171,12 @@ private:
                     prev->m_compareNext.compare_exchange_strong(expected, true))
                 {
                     m_comparePrev = true;
-                    if (prev->m_storages->m_readWriteSetStorage.hasRAWIntersection(
+                    if (auto const* key = prev->m_storages->m_readWriteSetStorage.rawKey(
                             m_storages->m_readWriteSetStorage))
                     {
                         PARALLEL_SCHEDULER_LOG(DEBUG)
                             << "Detected left RAW intersection, abort: " << m_chunkIndex;
+                        m_rawConflicts->add(*key);
                         decreaseNumber(*m_lastChunkIndex, m_chunkIndex);
                         return;
                     }
@@ -142,11 +190,12 @@ private:
                     m_compareNext.compare_exchange_strong(expected, true))
                 {
                     next->m_comparePrev = true;
-                    if (m_storages->m_readWriteSetStorage.hasRAWIntersection(
+                    if (auto const* key = m_storages->m_readWriteSetStorage.rawKey(
                             next->m_storages->m_readWriteSetStorage))
                     {
                         PARALLEL_SCHEDULER_LOG(DEBUG)
                             << "Detected right RAW intersection, abort: " << m_chunkIndex + 1;
+                        m_rawConflicts->add(*key);
                         decreaseNumber(*m_lastChunkIndex, m_chunkIndex + 1);
                         return;
                     }
@@ -162,7 +211,7 @@ private:
         }
     };
 
-    task::Task<void> serialExecute(protocol::BlockHeader const& blockHeader,
+    task::Task<void> serialExecute(protocol::IsBlockHeader auto const& blockHeader,
         protocol::TransactionReceiptFactory& receiptFactory,
         transaction_executor::TableNamePool& tableNamePool,
         RANGES::range auto&& transactionAndReceipts, auto& storage)
@@ -195,23 +244,42 @@ public:
     {
         ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
             ittapi::ITT_DOMAINS::instance().PARALLEL_EXECUTE);
+        co_await prefetch(blockHeader, transactions);
         auto storageView = multiLayerStorage().fork(true);
         std::vector<protocol::TransactionReceipt::Ptr> receipts;
         receipts.resize(RANGES::size(transactions));
 
         size_t offset = 0;
         auto chunkSize = m_chunkSize;
+        if (m_adaptive)
+        {
+            chunkSize = std::clamp(chunkSize, MIN_ADAPTIVE_CHUNK_SIZE, MAX_ADAPTIVE_CHUNK_SIZE);
+        }
 
         size_t retryCount = 0;
+        ExecuteMetrics metrics;
         auto transactionAndReceipts =
             RANGES::views::zip(RANGES::views::iota(0LU, (size_t)RANGES::size(transactions)),
                 transactions | RANGES::views::addressof, receipts | RANGES::views::addressof);
 
-        // while (offset < RANGES::size(transactions) && retryCount < MAX_RETRY_COUNT)
+        bool serialTail = false;
         while (offset < RANGES::size(transactions))
         {
+            if (serialTail)
+            {
+                // Too many conflicts, execute the rest transactions in order, no more speculation
+                metrics.serialTailCount = RANGES::size(transactions) - offset;
+                PARALLEL_SCHEDULER_LOG(DEBUG)
+                    << "Execute serial tail, offset: " << offset
+                    << " count: " << metrics.serialTailCount;
+                co_await serialExecute(blockHeader, receiptFactory(), tableNamePool(),
+                    transactionAndReceipts | RANGES::views::drop(offset), storageView);
+                break;
+            }
+
             ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
                 ittapi::ITT_DOMAINS::instance().SINGLE_PASS);
+            metrics.chunkSizes.emplace_back(chunkSize);
 
             auto transactionAndReceiptsChunks = transactionAndReceipts |
                                                 RANGES::views::drop(offset) |
@@ -221,14 +289,17 @@ public:
             std::vector<ChunkType> executeChunks(
                 (size_t)RANGES::size(transactionAndReceiptsChunks));
 
-            std::atomic_int64_t lastChunkIndex =
-                (int64_t)RANGES::size(transactionAndReceiptsChunks);
+            auto chunkCount = (int64_t)RANGES::size(transactionAndReceiptsChunks);
+            std::atomic_int64_t lastChunkIndex = chunkCount;
+            std::atomic_size_t abortedChunks = 0;
+            RAWConflicts rawConflicts;
             int64_t chunkIndex = 0;
-            executeChunks[chunkIndex].init(
-                chunkIndex, lastChunkIndex, transactionAndReceiptsChunks[chunkIndex], storageView);
+            executeChunks[chunkIndex].init(chunkIndex, lastChunkIndex, rawConflicts,
+                transactionAndReceiptsChunks[chunkIndex], storageView);
 
             auto executeIt = RANGES::begin(executeChunks);
             typename MultiLayerStorage::MutableStorage lastStorage;
+            std::vector<size_t> lastKeyHashes;
             PARALLEL_SCHEDULER_LOG(DEBUG) << "Start new chunk executing...";
 
             tbb::parallel_pipeline(m_maxToken == 0 ? executeChunks.size() : m_maxToken,
@@ -245,7 +316,8 @@ public:
                         if ((size_t)chunkIndex != RANGES::size(transactionAndReceiptsChunks) - 1)
                         {
                             executeChunks[chunkIndex + 1].init(chunkIndex + 1, lastChunkIndex,
-                                transactionAndReceiptsChunks[chunkIndex + 1], storageView);
+                                rawConflicts, transactionAndReceiptsChunks[chunkIndex + 1],
+                                storageView);
                         }
                         ++chunkIndex;
                         return {executeIt++};
@@ -261,9 +333,11 @@ public:
                             }
 
                             auto& chunkIt = *input;
-                            if (!task::syncWait(chunkIt->execute(
+                            if (!task::tbb::syncWait(chunkIt->execute(
                                     blockHeader, receiptFactory(), tableNamePool())))
                             {
+                                // Aborted by a conflict of the former chunks while executing
+                                ++abortedChunks;
                                 return {};
                             }
 
@@ -287,10 +361,16 @@ public:
                     tbb::make_filter<std::optional<RANGES::iterator_t<decltype(executeChunks)>>,
                         void>(tbb::filter_mode::serial_in_order,
                         [&](std::optional<RANGES::iterator_t<decltype(executeChunks)>> input) {
-                            if (!input || (*input)->chunkIndex() >= lastChunkIndex)
+                            if (!input)
                             {
                                 return;
                             }
+                            if ((*input)->chunkIndex() >= lastChunkIndex)
+                            {
+                                // Finished but discarded by a conflict
+                                ++abortedChunks;
+                                return;
+                            }
                             offset += (*input)->count();
 
                             auto index = (*input)->chunkIndex();
@@ -299,31 +379,61 @@ public:
                                     ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
                                     ittapi::ITT_DOMAINS::instance().PIPELINE_MERGE_STORAGE);
 
-                                task::syncWait(storage2::merge(
-                                    executeChunks[index].localStorage().mutableStorage(),
-                                    lastStorage));
+                                auto& localStorage = executeChunks[index].localStorage();
+                                task::tbb::syncWait(
+                                    storage2::merge(localStorage.mutableStorage(), lastStorage));
+                                lastKeyHashes.insert(lastKeyHashes.end(),
+                                    localStorage.mutableKeyHashes().begin(),
+                                    localStorage.mutableKeyHashes().end());
                             }
                         }));
             {
                 ittapi::Report report(ittapi::ITT_DOMAINS::instance().PARALLEL_SCHEDULER,
                     ittapi::ITT_DOMAINS::instance().FINAL_MERGE_STORAGE);
-                if (storageView.mutableStorage().empty())
-                {
-                    storageView.mutableStorage().swap(lastStorage);
-                }
-                else
-                {
-                    co_await storage2::merge(lastStorage, storageView.mutableStorage());
-                }
+                co_await storageView.mergeMutable(lastStorage, lastKeyHashes);
             }
 
             m_asyncTaskGroup->run([executeChunks = std::move(executeChunks),
                                       lastStorage = std::move(lastStorage)]() {});
-            ++retryCount;
+
+            metrics.abortedChunks += abortedChunks;
+            metrics.rawConflicts += rawConflicts.count;
+            for (auto& [key, count] : rawConflicts.keys)
+            {
+                metrics.rawKeys[key] += count;
+            }
+            if (offset < RANGES::size(transactions))
+            {
+                ++retryCount;
+                if (m_adaptive)
+                {
+                    // Shrink the chunks around the hot spot, and give up speculating when most of
+                    // the started chunks aborted
+                    auto abortRate =
+                        (double)abortedChunks / (double)std::max(chunkIndex, (int64_t)1);
+                    serialTail = retryCount >= MAX_RETRY_COUNT ||
+                                 (chunkSize == MIN_ADAPTIVE_CHUNK_SIZE &&
+                                     abortRate >= SERIAL_TAIL_ABORT_RATE);
+                    chunkSize = std::max(chunkSize / 2, MIN_ADAPTIVE_CHUNK_SIZE);
+                }
+            }
         }
 
+        if (m_adaptive)
+        {
+            // Conflict free block, try bigger chunks next time
+            m_chunkSize = retryCount == 0 ? std::min(chunkSize * 2, MAX_ADAPTIVE_CHUNK_SIZE) :
+                                            chunkSize;
+        }
+        metrics.retryCount = retryCount;
+
         PARALLEL_SCHEDULER_LOG(DEBUG)
-            << "Parallel scheduler execute finished, retry counts: " << retryCount;
+            << METRIC << "Parallel scheduler execute finished, retry counts: " << retryCount
+            << " aborted chunks: " << metrics.abortedChunks
+            << " raw conflicts: " << metrics.rawConflicts
+            << " raw keys: " << metrics.rawKeys.size()
+            << " serial tail: " << metrics.serialTailCount << " next chunk size: " << m_chunkSize;
+        m_lastMetrics = std::move(metrics);
         m_asyncTaskGroup->run([storageView = std::move(storageView)]() {});
 
         co_return receipts;
@@ -331,5 +441,11 @@ public:
 
     void setChunkSize(size_t chunkSize) { m_chunkSize = chunkSize; }
     void setMaxToken(size_t maxToken) { m_maxToken = maxToken; }
+
+    // Adaptive mode adjust the chunk size by the abort rate of each pass, and fall back to serial
+    // execution for the rest of the block when conflicts dominate
+    void setAdaptive(bool adaptive) { m_adaptive = adaptive; }
+    size_t chunkSize() const { return m_chunkSize; }
+    ExecuteMetrics const& lastExecuteMetrics() const& { return m_lastMetrics; }
 };
 }  // namespace bcos::transaction_scheduler
\ No newline at end of file
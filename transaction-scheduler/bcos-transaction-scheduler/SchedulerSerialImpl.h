@@ -14,6 +14,7 @@ class SchedulerSerialImpl : public SchedulerBaseImpl<MultiLayerStorage, Executor
 public:
     using SchedulerBaseImpl<MultiLayerStorage, Executor>::SchedulerBaseImpl;
     using SchedulerBaseImpl<MultiLayerStorage, Executor>::multiLayerStorage;
+    using SchedulerBaseImpl<MultiLayerStorage, Executor>::prefetch;
     using SchedulerBaseImpl<MultiLayerStorage, Executor>::receiptFactory;
     using SchedulerBaseImpl<MultiLayerStorage, Executor>::tableNamePool;
 
@@ -21,6 +22,7 @@ public:
         protocol::IsBlockHeader auto const& blockHeader,
         RANGES::input_range auto const& transactions)
     {
+        co_await prefetch(blockHeader, transactions);
         auto view = multiLayerStorage().fork(true);
         std::vector<protocol::TransactionReceipt::Ptr> receipts;
         if constexpr (RANGES::sized_range<decltype(transactions)>)
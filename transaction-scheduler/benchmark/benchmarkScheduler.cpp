@@ -12,6 +12,7 @@
 #include <bcos-task/Wait.h>
 #include <bcos-transaction-executor/TransactionExecutorImpl.h>
 #include <bcos-transaction-scheduler/MultiLayerStorage.h>
+#include <bcos-transaction-scheduler/ReadWriteSetStorage.h>
 #include <bcos-transaction-scheduler/SchedulerParallelImpl.h>
 #include <bcos-transaction-scheduler/SchedulerSerialImpl.h>
 #include <bcos-utilities/ITTAPI.h>
@@ -650,6 +651,73 @@ static void conflictTransfer(benchmark::State& state)
         fixture.m_scheduler);
 }
 
+static std::vector<StateKey> readWriteSetKeys(TableNamePool& tableNamePool, size_t count)
+{
+    std::mt19937_64 rng(std::random_device{}());
+    auto tableName = storage2::string_pool::makeStringID(tableNamePool, "t_test");
+    return RANGES::views::iota(0LU, count) | RANGES::views::transform([&](size_t index) {
+        bcos::h256 key;
+        key.generateRandomFixedBytesByEngine(rng);
+        return StateKey{tableName, SmallKey(key)};
+    }) |
+           RANGES::to<std::vector<StateKey>>();
+}
+
+// Every transaction mostly reads 3 slots and writes 2 of them
+template <template <typename> class ReadWriteSet>
+static void readWriteSetPut(benchmark::State& state)
+{
+    TableNamePool tableNamePool;
+    auto keys = readWriteSetKeys(tableNamePool, state.range(0));
+
+    for (auto const& it : state)
+    {
+        ReadWriteSet<StateKey> readWriteSet;
+        for (auto&& [key, index] : RANGES::views::zip(keys, RANGES::views::iota(0LU)))
+        {
+            readWriteSet.put(false, key);
+            if (index % 3 != 0)
+            {
+                readWriteSet.put(true, key);
+            }
+        }
+        benchmark::DoNotOptimize(readWriteSet);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <template <typename> class ReadWriteSet>
+static void readWriteSetIntersection(benchmark::State& state)
+{
+    TableNamePool tableNamePool;
+    auto lhsKeys = readWriteSetKeys(tableNamePool, state.range(0));
+    auto rhsKeys = readWriteSetKeys(tableNamePool, state.range(0));
+
+    std::optional<ReadWriteSet<StateKey>> lhs;
+    std::optional<ReadWriteSet<StateKey>> rhs;
+    for (auto const& it : state)
+    {
+        state.PauseTiming();
+        lhs.reset();
+        rhs.reset();
+        lhs.emplace();
+        rhs.emplace();
+        for (auto&& [lhsKey, rhsKey] : RANGES::views::zip(lhsKeys, rhsKeys))
+        {
+            lhs->put(true, lhsKey);
+            rhs->put(false, rhsKey);
+        }
+        state.ResumeTiming();
+
+        // No conflict, the worst case
+        if (lhs->hasRAWIntersection(*rhs))
+        {
+            BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected RAW intersection!"));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
 // static void parallelScheduler(benchmark::State& state) {}
 constexpr static bool SERIAL = false;
 constexpr static bool PARALLEL = true;
@@ -661,4 +729,10 @@ BENCHMARK(transfer<SERIAL>)->Arg(1000)->Arg(10000)->Arg(100000);
 BENCHMARK(transfer<PARALLEL>)->Arg(1000)->Arg(10000)->Arg(100000);
 
 BENCHMARK(conflictTransfer<SERIAL>)->Arg(1000)->Arg(10000)->Arg(100000);
-BENCHMARK(conflictTransfer<PARALLEL>)->Arg(1000)->Arg(10000)->Arg(100000);
\ No newline at end of file
+BENCHMARK(conflictTransfer<PARALLEL>)->Arg(1000)->Arg(10000)->Arg(100000);
+
+BENCHMARK(readWriteSetPut<MapReadWriteSet>)->Arg(32)->Arg(1000)->Arg(10000);
+BENCHMARK(readWriteSetPut<VectorReadWriteSet>)->Arg(32)->Arg(1000)->Arg(10000);
+
+BENCHMARK(readWriteSetIntersection<MapReadWriteSet>)->Arg(32)->Arg(1000)->Arg(10000);
+BENCHMARK(readWriteSetIntersection<VectorReadWriteSet>)->Arg(32)->Arg(1000)->Arg(10000);
\ No newline at end of file
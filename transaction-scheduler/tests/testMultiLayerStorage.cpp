@@ -168,4 +168,174 @@ BOOST_AUTO_TEST_CASE(oneMutable)
     auto view4 = multiLayerStorage.fork(true);
 }
 
+BOOST_AUTO_TEST_CASE(compaction)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        auto toKey = [this](int num) {
+            return StateKey{storage2::string_pool::makeStringID(tableNamePool, "test_table"),
+                fmt::format("key: {}", num)};
+        };
+
+        // Block i writes key [i * 10, i * 10 + 20) with value i, and removes key 1000 + i
+        constexpr static int blocks = 5;
+        for (auto i = 0; i < blocks; ++i)
+        {
+            multiLayerStorage.newMutable();
+            auto view = multiLayerStorage.fork(true);
+            for (auto num = i * 10; num < i * 10 + 20; ++num)
+            {
+                storage::Entry entry;
+                entry.set(fmt::format("value: {}", i));
+                co_await storage2::writeOne(view, toKey(num), std::move(entry));
+            }
+            co_await storage2::removeOne(view, toKey(1000 + i));
+            multiLayerStorage.pushMutableToImmutableFront();
+        }
+        BOOST_CHECK_EQUAL(multiLayerStorage.immutableLayerCount(), blocks);
+
+        co_await multiLayerStorage.compactImmutables();
+        BOOST_CHECK_EQUAL(multiLayerStorage.immutableLayerCount(), 3);
+
+        auto checkView = [&]() -> task::Task<void> {
+            auto view = multiLayerStorage.fork(false);
+            for (auto num = 0; num < (blocks + 1) * 10 + 10; ++num)
+            {
+                auto entry = co_await storage2::readOne(view, toKey(num));
+                if (num >= (blocks + 1) * 10)
+                {
+                    BOOST_CHECK(!entry);
+                }
+                else
+                {
+                    BOOST_REQUIRE(entry);
+                    auto expected = std::min(num / 10, blocks - 1);
+                    BOOST_CHECK_EQUAL(entry->get(), fmt::format("value: {}", expected));
+                }
+            }
+            for (auto i = 0; i < blocks; ++i)
+            {
+                BOOST_CHECK(!co_await storage2::existsOne(view, toKey(1000 + i)));
+            }
+        };
+        co_await checkView();
+
+        for (auto i = 0; i < blocks; ++i)
+        {
+            co_await multiLayerStorage.mergeAndPopImmutableBack();
+            co_await checkView();
+        }
+        BOOST_CHECK_EQUAL(multiLayerStorage.immutableLayerCount(), 0);
+        BOOST_CHECK_THROW(
+            co_await multiLayerStorage.mergeAndPopImmutableBack(), NotExistsImmutableStorageError);
+
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(mergeMutable)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        auto toKey = [this](int num) {
+            return StateKey{storage2::string_pool::makeStringID(tableNamePool, "test_table"),
+                fmt::format("key: {}", num)};
+        };
+        for (auto num = 0; num < 20; ++num)
+        {
+            storage::Entry entry;
+            entry.set("old");
+            co_await storage2::writeOne(backendStorage, toKey(num), std::move(entry));
+        }
+
+        // Written out of the layers, as the local storages of the schedulers
+        MutableStorage from;
+        std::vector<size_t> keyHashes;
+        for (auto num = 0; num < 10; ++num)
+        {
+            storage::Entry entry;
+            entry.set("new");
+            co_await storage2::writeOne(from, toKey(num), std::move(entry));
+            keyHashes.emplace_back(std::hash<StateKey>{}(toKey(num)));
+        }
+
+        multiLayerStorage.newMutable();
+        {
+            auto view = multiLayerStorage.fork(true);
+            co_await view.mergeMutable(from, keyHashes);
+            co_await storage2::removeOne(view, toKey(100));
+            BOOST_CHECK_EQUAL(view.mutableKeyHashes().size(), 11);
+        }
+        multiLayerStorage.pushMutableToImmutableFront();
+
+        // The read layer is found by the bloom filter built from the hashes
+        auto view = multiLayerStorage.fork(false);
+        for (auto num = 0; num < 20; ++num)
+        {
+            auto entry = co_await storage2::readOne(view, toKey(num));
+            BOOST_REQUIRE(entry);
+            BOOST_CHECK_EQUAL(entry->get(), num < 10 ? "new" : "old");
+        }
+        BOOST_CHECK(!co_await storage2::existsOne(view, toKey(100)));
+
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_CASE(prefetch)
+{
+    task::syncWait([this]() -> task::Task<void> {
+        using CacheStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+            memory_storage::Attribute(memory_storage::CONCURRENT | memory_storage::MRU),
+            std::hash<StateKey>>;
+        CacheStorage cacheStorage;
+        MultiLayerStorage<MutableStorage, CacheStorage, BackendStorage> cachedStorage(
+            backendStorage, cacheStorage);
+
+        auto toKey = [this](int num) {
+            return StateKey{storage2::string_pool::makeStringID(tableNamePool, "test_table"),
+                fmt::format("key: {}", num)};
+        };
+        for (auto num = 0; num < 10; ++num)
+        {
+            storage::Entry entry;
+            entry.set(fmt::format("value: {}", num));
+            co_await storage2::writeOne(backendStorage, toKey(num), std::move(entry));
+        }
+
+        // Key 0 is in a read layer, not prefetched from the backend
+        cachedStorage.newMutable();
+        {
+            auto view = cachedStorage.fork(true);
+            storage::Entry entry;
+            entry.set("new value");
+            co_await storage2::writeOne(view, toKey(0), std::move(entry));
+        }
+        cachedStorage.pushMutableToImmutableFront();
+
+        auto keys = RANGES::views::iota(0, 20) | RANGES::views::transform(toKey) |
+                    RANGES::to<std::vector<StateKey>>();
+        co_await cachedStorage.prefetch(keys);
+        auto stats = cachedStorage.cacheStats();
+        BOOST_CHECK_EQUAL(stats.prefetchKeys, 19);
+        BOOST_CHECK_EQUAL(stats.prefetchLoads, 9);
+        BOOST_CHECK(!co_await storage2::existsOne(cacheStorage, toKey(0)));
+        BOOST_CHECK(co_await storage2::existsOne(cacheStorage, toKey(1)));
+
+        // Reads of the prefetched keys hit the cache
+        auto view = cachedStorage.fork(false);
+        for (auto num = 0; num < 10; ++num)
+        {
+            auto entry = co_await storage2::readOne(view, toKey(num));
+            BOOST_REQUIRE(entry);
+            BOOST_CHECK_EQUAL(
+                entry->get(), num == 0 ? std::string("new value") : fmt::format("value: {}", num));
+        }
+        stats = cachedStorage.cacheStats();
+        BOOST_CHECK_EQUAL(stats.hits, 9);
+        BOOST_CHECK_EQUAL(stats.misses, 0);
+
+        co_await cachedStorage.mergeAndPopImmutableBack();
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
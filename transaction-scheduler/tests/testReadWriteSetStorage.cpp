@@ -46,4 +46,43 @@ BOOST_AUTO_TEST_CASE(readWriteSet)
     }());
 }
 
+BOOST_AUTO_TEST_CASE(vectorReadWriteSet)
+{
+    task::syncWait([]() -> task::Task<void> {
+        Storage lhsStorage;
+        ReadWriteSetStorage<Storage, VectorReadWriteSet<int>> firstStorage(lhsStorage);
+
+        Storage rhsStorage;
+        ReadWriteSetStorage<Storage, VectorReadWriteSet<int>> secondStorage(rhsStorage);
+
+        co_await storage2::writeOne(firstStorage, 300, 1);
+        co_await storage2::writeOne(firstStorage, 100, 1);
+        co_await storage2::writeOne(firstStorage, 200, 1);
+        co_await storage2::writeOne(firstStorage, 100, 2);
+        co_await storage2::readOne(firstStorage, 400);
+
+        co_await storage2::readOne(secondStorage, 600);
+        co_await storage2::readOne(secondStorage, 500);
+        co_await storage2::writeOne(secondStorage, 200, 1);
+
+        BOOST_CHECK(!firstStorage.hasRAWIntersection(secondStorage));
+        BOOST_CHECK(!secondStorage.hasRAWIntersection(firstStorage));
+
+        Storage thirdStorage;
+        ReadWriteSetStorage<Storage, VectorReadWriteSet<int>> readStorage(thirdStorage);
+        co_await storage2::readOne(readStorage, 500);
+        co_await storage2::readOne(readStorage, 200);
+        BOOST_CHECK(firstStorage.hasRAWIntersection(readStorage));
+        BOOST_CHECK(secondStorage.hasRAWIntersection(readStorage));
+        BOOST_CHECK(!readStorage.hasRAWIntersection(firstStorage));
+
+        // The key of the conflict
+        auto const* rawKey = firstStorage.rawKey(readStorage);
+        BOOST_REQUIRE(rawKey != nullptr);
+        BOOST_CHECK_EQUAL(*rawKey, 200);
+        BOOST_CHECK(readStorage.rawKey(firstStorage) == nullptr);
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "bcos-tars-protocol/protocol/BlockHeaderImpl.h"
+#include "bcos-tars-protocol/protocol/TransactionReceiptFactoryImpl.h"
+#include "bcos-transaction-scheduler/MultiLayerStorage.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-framework/transaction-executor/TransactionExecutor.h>
+#include <bcos-tars-protocol/protocol/TransactionImpl.h>
+#include <bcos-task/Wait.h>
+#include <bcos-transaction-scheduler/SchedulerDAGImpl.h>
+#include <fmt/format.h>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+using namespace bcos;
+using namespace bcos::storage2;
+using namespace bcos::transaction_executor;
+using namespace bcos::transaction_scheduler;
+
+constexpr static int INITIAL_BALANCE = 1000;
+
+static std::vector<std::string> splitInput(protocol::Transaction const& transaction)
+{
+    auto input = transaction.input();
+    std::string inputString((const char*)input.data(), input.size());
+    std::vector<std::string> accounts;
+    boost::split(accounts, inputString, [](char c) { return c == ':'; });
+    return accounts;
+}
+
+// Input: "from:to", transfer 1 from `from` to `to`
+template <StateStorage Storage>
+struct MockTransferExecutor
+{
+    MockTransferExecutor(
+        Storage& storage, [[maybe_unused]] auto&& receiptFactory, TableNamePool& tableNamePool)
+      : m_storage(storage), m_tableNamePool(tableNamePool)
+    {}
+
+    task::Task<int> balance(StateKey const& key)
+    {
+        auto entry = co_await storage2::readOne(m_storage, key);
+        co_return entry ? boost::lexical_cast<int>(entry->get()) : INITIAL_BALANCE;
+    }
+
+    task::Task<std::shared_ptr<bcos::protocol::TransactionReceipt>> execute(
+        [[maybe_unused]] auto&& blockHeader, protocol::IsTransaction auto const& transaction,
+        [[maybe_unused]] int contextID)
+    {
+        auto accounts = splitInput(transaction);
+        StateKey fromKey{makeStringID(m_tableNamePool, "t_balance"), std::string_view(accounts[0])};
+        StateKey toKey{makeStringID(m_tableNamePool, "t_balance"), std::string_view(accounts[1])};
+
+        auto fromBalance = co_await balance(fromKey);
+        storage::Entry fromEntry;
+        fromEntry.set(boost::lexical_cast<std::string>(fromBalance - 1));
+        co_await storage2::writeOne(m_storage, fromKey, std::move(fromEntry));
+
+        auto toBalance = co_await balance(toKey);
+        storage::Entry toEntry;
+        toEntry.set(boost::lexical_cast<std::string>(toBalance + 1));
+        co_await storage2::writeOne(m_storage, toKey, std::move(toEntry));
+
+        co_return std::shared_ptr<bcos::protocol::TransactionReceipt>();
+    }
+
+    Storage& m_storage;
+    TableNamePool& m_tableNamePool;
+};
+
+class TestSchedulerDAGFixture
+{
+public:
+    using MutableStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+        memory_storage::Attribute(memory_storage::ORDERED | memory_storage::LOGICAL_DELETION)>;
+    using BackendStorage = memory_storage::MemoryStorage<StateKey, StateValue,
+        memory_storage::Attribute(memory_storage::ORDERED | memory_storage::CONCURRENT),
+        std::hash<StateKey>>;
+
+    TestSchedulerDAGFixture()
+      : cryptoSuite(std::make_shared<bcos::crypto::CryptoSuite>(
+            std::make_shared<bcos::crypto::Keccak256>(), nullptr, nullptr)),
+        receiptFactory(cryptoSuite),
+        multiLayerStorage(backendStorage)
+    {}
+
+    TableNamePool tableNamePool;
+    BackendStorage backendStorage;
+    bcos::crypto::CryptoSuite::Ptr cryptoSuite;
+    bcostars::protocol::TransactionReceiptFactoryImpl receiptFactory;
+    MultiLayerStorage<MutableStorage, void, BackendStorage> multiLayerStorage;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSchedulerDAG, TestSchedulerDAGFixture)
+
+BOOST_AUTO_TEST_CASE(transfer)
+{
+    task::syncWait([&, this]() -> task::Task<void> {
+        SchedulerDAGImpl<decltype(multiLayerStorage), MockTransferExecutor> scheduler(
+            multiLayerStorage, receiptFactory, tableNamePool);
+        scheduler.setConflictResolver([](protocol::Transaction const& transaction) -> ConflictKeys {
+            auto accounts = splitInput(transaction);
+            if (accounts.size() > 2)
+            {
+                // Undeclared transaction
+                return {};
+            }
+            return accounts;
+        });
+        scheduler.start();
+        bcostars::protocol::BlockHeaderImpl blockHeader(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+
+        // 100 independent transfers, a chain of 10 dependent transfers and an undeclared one
+        std::vector<std::string> inputs;
+        for (auto i = 0; i < 100; ++i)
+        {
+            inputs.emplace_back(fmt::format("a{}:b{}", i, i));
+        }
+        for (auto i = 0; i < 10; ++i)
+        {
+            inputs.emplace_back(fmt::format("b{}:b{}", i, i + 1));
+        }
+        inputs.emplace_back("a0:c0:undeclared");
+        for (auto i = 0; i < 10; ++i)
+        {
+            inputs.emplace_back(fmt::format("c{}:a{}", i, i));
+        }
+
+        auto transactions = inputs | RANGES::views::transform([](std::string const& input) {
+            auto transaction = std::make_unique<bcostars::protocol::TransactionImpl>(
+                [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); });
+            transaction->mutableInner().data.input.assign(input.begin(), input.end());
+            return transaction;
+        }) | RANGES::to<std::vector<std::unique_ptr<bcostars::protocol::TransactionImpl>>>();
+
+        auto receipts = co_await scheduler.execute(blockHeader,
+            transactions | RANGES::views::transform([](auto& ptr) -> auto& { return *ptr; }));
+        BOOST_CHECK_EQUAL(receipts.size(), inputs.size());
+
+        // 100 transfers + 10 chained, an undeclared barrier, 10 transfers after it
+        BOOST_CHECK_EQUAL(scheduler.lastLevelCount(), 11 + 1 + 1);
+
+        // Serial result
+        std::map<std::string, int> expected;
+        for (auto const& input : inputs)
+        {
+            std::vector<std::string> accounts;
+            boost::split(accounts, input, [](char c) { return c == ':'; });
+            auto& from = expected.try_emplace(accounts[0], INITIAL_BALANCE).first->second;
+            from -= 1;
+            auto& to = expected.try_emplace(accounts[1], INITIAL_BALANCE).first->second;
+            to += 1;
+        }
+
+        auto& mutableStorage = multiLayerStorage.mutableStorage();
+        for (auto const& [account, balance] : expected)
+        {
+            StateKey key{makeStringID(tableNamePool, "t_balance"), std::string_view(account)};
+            auto entry = co_await storage2::readOne(mutableStorage, key);
+            BOOST_REQUIRE(entry);
+            BOOST_CHECK_EQUAL(boost::lexical_cast<int>(entry->get()), balance);
+        }
+
+        co_return;
+    }());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -194,4 +194,66 @@ BOOST_AUTO_TEST_CASE(conflict)
     // Wait for tbb
 }
 
+BOOST_AUTO_TEST_CASE(adaptiveConflict)
+{
+    task::syncWait([&, this]() -> task::Task<void> {
+        SchedulerParallelImpl<decltype(multiLayerStorage), MockConflictExecutor> scheduler(
+            multiLayerStorage, receiptFactory, tableNamePool);
+        scheduler.setChunkSize(16);
+        scheduler.setMaxToken(4);
+        scheduler.setAdaptive(true);
+        scheduler.start();
+        bcostars::protocol::BlockHeaderImpl blockHeader(
+            [inner = bcostars::BlockHeader()]() mutable { return std::addressof(inner); });
+
+        constexpr static auto count = 256;
+        auto transactions = RANGES::views::iota(0, count) | RANGES::views::transform([](int index) {
+            auto transaction = std::make_unique<bcostars::protocol::TransactionImpl>(
+                [inner = bcostars::Transaction()]() mutable { return std::addressof(inner); });
+            auto num = boost::lexical_cast<std::string>(index);
+            transaction->mutableInner().data.input.assign(num.begin(), num.end());
+
+            return transaction;
+        }) | RANGES::to<std::vector<std::unique_ptr<bcostars::protocol::TransactionImpl>>>();
+
+        auto receipts = co_await scheduler.execute(blockHeader,
+            transactions | RANGES::views::transform([](auto& ptr) -> auto& { return *ptr; }));
+        BOOST_CHECK_EQUAL(receipts.size(), count);
+
+        // Every transaction conflicts with the previous one, should end up with serial tail
+        auto const& metrics = scheduler.lastExecuteMetrics();
+        BOOST_CHECK_GT(metrics.retryCount, 0);
+        BOOST_CHECK_GT(metrics.rawConflicts, 0);
+        BOOST_CHECK_EQUAL(metrics.chunkSizes.front(), 16);
+        BOOST_CHECK_EQUAL(metrics.chunkSizes.size(), metrics.retryCount);
+        BOOST_CHECK_GT(metrics.serialTailCount, 0);
+        BOOST_CHECK_LT(scheduler.chunkSize(), 16);
+
+        auto& mutableStorage = multiLayerStorage.mutableStorage();
+        StateKey key1{makeStringID(tableNamePool, "t_test"), std::string_view("key1")};
+        StateKey key2{makeStringID(tableNamePool, "t_test"), std::string_view("key2")};
+
+        auto entry1 = co_await storage2::readOne(mutableStorage, key1);
+        BOOST_REQUIRE(entry1);
+        BOOST_CHECK_EQUAL(boost::lexical_cast<int>(entry1->get()), count - 1);
+
+        auto entry2 = co_await storage2::readOne(mutableStorage, key2);
+        BOOST_REQUIRE(entry2);
+        BOOST_CHECK_EQUAL(boost::lexical_cast<int>(entry2->get()), count - 1);
+
+        // The conflicts are all on the two hot keys
+        BOOST_CHECK_GT(metrics.abortedChunks, 0);
+        BOOST_CHECK(!metrics.rawKeys.empty());
+        size_t rawKeyHits = 0;
+        for (auto const& [key, hits] : metrics.rawKeys)
+        {
+            BOOST_CHECK(key == key1 || key == key2);
+            rawKeyHits += hits;
+        }
+        BOOST_CHECK_EQUAL(rawKeyHits, metrics.rawConflicts);
+
+        co_return;
+    }());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file